@@ -59,7 +59,13 @@
 //#define blankScreenOnMessage true		/* Completely blank display screen upon display of message */
 //#define trackIdleEOCdata true			/* Ability to track engine idling and EOC modes */
 //#define useSerialPortDataLogging true		/* Ability to output 5 basic parameters to a data logger or SD card */
+//#define useBinaryTelemetry true		/* Adds a data logging mode that sends raw measurements in compact binary frames, 10 times a second */
 //#define useBufferedSerialPort true		/* Speed up serial output */
+//#define useSerialBaudRate true		/* Ability to set the serial port baud rate, from 9600 up to 500000 */
+//#define useSerialConfig true			/* Ability to dump and load all EEPROM settings, screens, and saved trips over the serial port */
+//#define useParameterCache true		/* Keep a RAM copy of the EEPROM settings, so reading them does not touch EEPROM - opt-in, see below */
+//#define useEEPROMwriteQueue true		/* Write to EEPROM in the background, so saving trips does not stall the display */
+//#define useIdleSleep true			/* Put the CPU into idle sleep while it waits for the next loop, to save power */
 //#define useCalculatedFuelFactor true		/* Ability to calculate that pesky us/gal (or L) factor from easily available published fuel injector data */
 #define useWindowFilter true			/* Smooths out "jumpy" instant FE figures that are caused by modern OBDII engine computers */
 #define useBigFE true				/* Show big fuel economy displays */
@@ -67,6 +73,8 @@
 //#define useBigTTE true			/* Show big time-to-empty displays */
 //#define useClock true				/* Show system clock, and provide means to set it */
 #define useSavedTrips true			/* Ability to save current or tank trips to any one of 10 different trip slots in EEPROM */
+//#define useTripJournal true		/* Spread saved trips across all free EEPROM as a journal, so AutoSave doesn't wear out the same cells */
+//#define useFillUpHistory true			/* Log each tank reset to EEPROM, and send the log out the serial port as CSV */
 #define useScreenEditor true			/* Ability to change any of 8 existing trip data screens, with 4 configurable figures on each screen */
 #define useBarFuelEconVsTime true		/* Show Fuel Economy over Time bar graph */
 #define useBarFuelEconVsSpeed true		/* Show Fuel Economy vs Speed, Fuel Used vs Speed bar graphs */
@@ -76,6 +84,14 @@
 #define useABresultViewer true			/* Ability to graphically show current (B) versus stored (A) fuel consumption rates */
 //#define useCoastDownCalculator true		/* Ability to calculate C(rr) and C(d) from coastdown */
 
+/*
+ * useParameterCache is opt-in. it costs one byte of RAM per byte of settings (37 bytes with the options above,
+ * close to 90 with everything turned on), and what it buys is only that a settings read no longer waits on a
+ * busy EEPROM or walks the EEPROM pointer table. settings are mostly read at startup, on a settings change, and
+ * a few times per pass thru the main loop, so leave it off unless that is shown to matter. to measure it, turn on
+ * useBenchMark, and compare the "param" benchmark entry with and without this option
+ */
+
 /*
  * program measurement and debugging tools
  */
@@ -83,14 +99,28 @@
 //#define useDebugReadings true
 //#define forceEEPROMsettingsInit true
 //#define useEEPROMviewer true			/* Ability to directly examine EEPROM */
-//#define useBenchMark true			/* this is probably broken - last time I used it was in August 2013 */
+//#define useBenchMark true			/* Time a list of math, formatting, and display routines, one per long press of all three buttons on the CPU monitor */
 //#define useSerialDebugOutput true
+//#define useScratchGuard true			/* Put guard bytes after the shared text buffers, and count overruns on the CPU status line */
+//#define useStackWatch true			/* Paint the stack at boot, and track the stack low water mark, SWEET64 nesting, and buffer use */
+//#define useLoopPhaseTiming true		/* Time each phase of the main loop, show min/avg/max on the CPU monitor, and dump them over serial port on demand */
 
 /*
  * SWEET64 configuration/debugging
  */
 //#define useSWEET64trace true			/* Ability to view real-time 64-bit calculations from SWEET64 kernel */
 //#define useSWEET64multDiv true		/* shift mul64 and div64 from native C++ to SWEET64 bytecode */
+//#define useSWEET64verifier true		/* Statically check every SWEET64 program at startup, and report results over serial port */
+//#define useSWEET64profiler true		/* Count SWEET64 opcodes and program run times, and dump them over serial port on demand */
+//#define useSWEET64disassembler true	/* List every SWEET64 program with cycle estimates over serial port on demand */
+//#define useSWEET64selfTest true		/* Check SWEET64 math against native 64-bit C arithmetic at startup, and report mismatches over serial port */
+
+/*
+ * useSWEET64profiler costs RAM: 4 bytes per SWEET64 opcode for the opcode counts, 6 bytes per SWEET64 program for
+ * its run count and cycles, and 1 byte per S64programList entry - about 420 bytes with the options above, and about
+ * 530 with every option that adds programs. SWEET64() also takes 48 more bytes of stack. build it for profiling runs
+ * only, on a part with the RAM to spare
+ */
 
 
 /*
@@ -160,8 +190,12 @@
 #define DEFAULT_CUR_RESET	1
 /* Serial Data Logging Enable */
 #define DEFAULT_SERIAL		1
-/* Window Filter Enable */
-#define DEFAULT_WIN_FILTER	1
+/* Serial Port Baud Rate */
+#define DEFAULT_BAUD_RATE	9600
+/* Window Filter Length (0 disables it, 1 is the old fixed 4 loop window) */
+#define DEFAULT_WIN_FILTER	4
+/* Window Filter Exponential Mode */
+#define DEFAULT_WIN_FILTER_EXP	0
 /* Length Of BarGraph Bar (s) */
 #define DEFAULT_BARGRAPH_LEN	5
 /* Autosave Active Trip Data Enable */
@@ -172,6 +206,13 @@
 #define DEFAULT_FES_LOW		25000
 /* FE vs Speed Bargraph speed bar size */
 #define DEFAULT_FES_SIZE	5000
+/* FE vs Speed Bargraph log-spaced bar sizes */
+#define DEFAULT_FES_LOG		0
+/*
+ * the FE vs Speed bins are the bars of the bargraph, so there are always bgDataSize (15) of them - that is as many bars
+ * as the bargraph has room for, and a 16th bin would have nowhere to show. each bin costs 16 bytes of RAM. for finer
+ * speed resolution, use a smaller bar size, or log-spaced bars, which give the low speeds narrower bars
+ */
 /* Price per unit volume of fuel */
 #define DEFAULT_PRICE		3799
 /* Scratchpad Memory */
@@ -218,12 +259,38 @@
 #ifdef useChryslerMAPCorrection
 #define useIsqrt true
 #define useAnalogRead true
+#define useBackgroundTasks true
+#endif
+
+#ifdef useBinaryTelemetry
+#define useSerialPortDataLogging true
+#define useSerialFrames true
 #endif
 
 #ifdef useSerialPortDataLogging
 #define useSerialPort true
 #endif
 
+#ifdef useParallaxLCD
+#undef useSerialBaudRate /* the Parallax LCD only talks at 9600 baud */
+#undef useSerialConfig /* the Parallax LCD is on the other end of the serial port */
+#endif
+
+#ifdef useSerialConfig
+#define useSerialPort true
+#define useSerialFrames true
+#define useBuffering true
+#define useEEPROMwriteQueue true /* a loaded image goes to EEPROM in the background, so normal operation carries on */
+#endif
+
+#ifdef useSerialFrames
+#define useCRC16 true
+#endif
+
+#ifdef useSerialBaudRate
+#define useSerialPort true
+#endif
+
 #ifdef useParallaxLCD
 #define useSerialPort true
 #endif
@@ -252,10 +319,78 @@
 #define useSerialDebugOutput true
 #endif
 
+#ifdef useSWEET64disassembler
+#define useSWEET64verifier true
+#define useCPUreading true
+#endif
+
+#ifdef useSWEET64verifier
+#define useSerialDebugOutput true
+#endif
+
+#ifdef useSWEET64profiler
+#define useSerialDebugOutput true
+#define useCPUreading true
+#endif
+
+#ifdef useScratchGuard
+#define useCPUreading true
+#endif
+
+#ifdef useStackWatch
+#define useCPUreading true
+#define useBackgroundTasks true
+#endif
+
+#ifdef useBenchMark
+#define useCPUreading true
+#define useIsqrt true
+#endif
+
+#ifdef useLoopPhaseTiming
+#define useCPUreading true
+#define useSerialDebugOutput true
+#endif
+
+#ifdef useSWEET64selfTest
+#define useSerialDebugOutput true
+#endif
+
+#ifdef useBinaryTelemetry
+#define useBackgroundTasks true
+#endif
+
+#ifdef useSerialConfig
+#define useBackgroundTasks true
+#endif
+
+#ifdef useBackgroundTasks
+#define useCPUloadPage true
+#endif
+
+#ifdef useBufferedSerialPort
+#define useCPUloadPage true
+#endif
+
+#ifdef useScratchGuard
+#define useCPUloadPage true
+#endif
+
+#ifdef useFillUpHistory
+#define useSerialPort true
+#define useCRC16 true
+#define useEEPROMwriteQueue true /* logging a fill-up writes a whole record at tank reset, without stalling the display */
+#endif
+
 #ifdef useSerialDebugOutput
 #define useSerialPort true
 #endif
 
+#ifdef useTripJournal
+#define useCRC16 true
+#define useEEPROMwriteQueue true /* every trip save appends a journal record, so let it finish in the background */
+#endif
+
 #ifdef useBarFuelEconVsTime
 #define useBarGraph true
 #endif
@@ -62,15 +62,20 @@ extern "C" {
 
 /* type for display function pointers */
 typedef void (*pFunc)(void);
+#ifdef useBackgroundTasks
+/* type for background task function pointers */
+typedef uint8_t (*bFunc)(void);
+#endif
 #ifdef useBuffering
 /* type for buffer function pointers */
 typedef void (*qFunc)(uint8_t);
 #endif
 
 #ifdef useChryslerMAPCorrection
-void readMAP(void);
+uint8_t readMAP(void);
 #endif
 #ifdef useIsqrt
+unsigned int iSqrtSeed(unsigned int n);
 unsigned int iSqrt(unsigned int n);
 #endif
 void updateVSS(unsigned long cycle);
@@ -95,6 +100,13 @@ void displayBigTime(char * val, uint8_t b);
 #endif
 #ifdef useSavedTrips
 unsigned int getBaseTripPointer(uint8_t tripPos);
+#ifdef useTripJournal
+unsigned int journalGetAddress(uint8_t r);
+uint16_t journalCRC(uint8_t r);
+void journalInit(void);
+void journalOpen(uint8_t tripPos);
+void journalSeal(uint8_t tripPos);
+#endif
 #endif
 unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx);
 #ifdef useSerialDebugOutput
@@ -129,6 +141,7 @@ unsigned long rformat(void);
 unsigned long convertTime(unsigned long * an);
 #ifdef useWindowFilter
 void resetWindowFilter(void);
+void updateWindowFilter(void);
 #endif
 void initGuino(void);
 void delay2(unsigned int ms);
@@ -136,8 +149,35 @@ void delay2(unsigned int ms);
 void doOutputDataLog(void);
 void simpletx(char * str);
 #endif
+#ifdef useCoastDownCalculator
+unsigned long coastDownSpeed(uint8_t tripIdx);
+void coastDownUpdate(void);
+void coastDownAddSample(unsigned long v1, unsigned long v2);
+void coastDownSolve(void);
+void doCursorUpdateCoastDown(void);
+void doCoastDownDisplay(void);
+void doCoastDownAccept(void);
+void doCoastDownReset(void);
+#endif
+#ifdef useBinaryTelemetry
+void telemetryLoopSync(void);
+uint8_t telemetryPoll(void);
+#endif
+#ifdef useSerialFrames
+void serialSendFrame(uint8_t * buff, uint8_t len);
+#endif
+#ifdef useSerialConfig
+void serialConfigReceiveByte(uint8_t b);
+uint8_t serialConfigPoll(void);
+void serialConfigHandleFrame(void);
+uint8_t serialConfigDump(void);
+void serialConfigReply(uint8_t cmd, uint8_t status);
+uint16_t serialConfigImageCRC(void);
+#endif
 #ifdef useSerialPort
+void serialSetBaudRate(void);
 void pushSerialCharacter(uint8_t chr);
+void pushSerialFlash(const char * str);
 #ifdef useBufferedSerialPort
 void serialTransmitEnable(void);
 void serialTransmitDisable(void);
@@ -161,6 +201,15 @@ void doLongGoLeft(void);
 void doLongGoRight(void);
 void doTripResetTank(void);
 void doTripResetCurrent(void);
+#ifdef useFillUpHistory
+unsigned int fillUpGetAddress(uint8_t r);
+uint16_t fillUpCRC(uint8_t r);
+uint8_t fillUpIsValid(uint8_t r);
+uint8_t fillUpFindNewest(void);
+void fillUpAppend(void);
+void fillUpPushNumber(unsigned long v, uint8_t dp);
+void doFillUpDump(void);
+#endif
 #ifdef useBarGraph
 void clearBGplot(uint8_t mode);
 uint8_t bgPlotConvert(uint8_t coord);
@@ -177,6 +226,9 @@ void displayBarGraph(uint8_t trip1idx, uint8_t trip1CalcIdx, uint8_t trip2idx,
 void doCursorUpdateBarFEvS(void);
 void doBarFEvSdisplay(void);
 void doResetBarFEvS(void);
+void initBarFEvS(void);
+void updateBarFEvS(void);
+void loadBarFEvS(uint8_t binIdx);
 #endif
 #ifdef useBarFuelEconVsTime
 void doResetBarFEvT(void);
@@ -185,12 +237,52 @@ void doBarFEvTdisplay(void);
 #endif
 #ifdef useCPUreading
 void doDisplaySystemInfo(void);
+void displayUtilPercent(const char * str, unsigned long cycles);
 void displayCPUutil(void);
+#ifdef useCPUloadPage
+void displayLoadInfo(void);
+#endif
+#ifdef useScratchGuard
+void scratchGuardCheck(void);
+#endif
+#ifdef useStackWatch
+void stackPaint(void);
+uint8_t stackScan(void);
+void displayStackInfo(void);
+#endif
+#ifdef useLoopPhaseTiming
+void phaseEnd(uint8_t phaseIdx);
+void phaseLatch(void);
+void displayPhaseInfo(void);
+void doLoopPhaseDump(void);
+#ifdef useSWEET64profiler
+void doCPUmonDump(void);
+#endif
+#endif
 void doShowCPU(void);
 #endif
 #ifdef useBenchMark
+void benchMarkISqrt(void);
+void benchMarkMul64(void);
+void benchMarkDiv64(void);
+void benchMarkFuelEcon(void);
+void benchMarkOldFuelEcon(void);
+void benchMarkFormat(void);
+#ifdef useBigNumberDisplay
+void benchMarkBigNumber(void);
+#endif
+void benchMarkTripUpdate(void);
+void benchMarkParamRead(void);
+unsigned long benchMarkRun(pFunc kernel, unsigned int loops);
 void doBenchMark(void);
 #endif
+#ifdef useSWEET64profiler
+uint8_t S64profCount(uint8_t slot);
+uint8_t S64profEnter(const uint8_t * sched);
+uint8_t S64profCall(uint8_t prgmIdx);
+void S64profLeave(uint8_t slot, unsigned int start);
+void doSWEET64profile(void);
+#endif
 void doCursorUpdateSetting(void);
 void doSettingEditDisplay(void);
 void doGoSettingsEdit(void);
@@ -268,13 +360,57 @@ void doScreenEditBump(void);
 void doSaveScreen(void);
 #endif
 
+#if defined(useSWEET64verifier) || defined(useSWEET64profiler)
+uint8_t S64findVerifyIdx(const uint8_t * prgmPtr);
+#endif
+#ifdef useSWEET64verifier
+uint8_t S64instrLength(uint8_t instr);
+uint8_t S64usesX(uint8_t instr);
+uint8_t S64isSkip(uint8_t instr);
+int S64skipTarget(const uint8_t * prgmPtr, uint8_t i);
+uint8_t S64testBit(uint8_t * map, uint8_t n, int t);
+unsigned int S64verifyClamp(unsigned long v);
+uint8_t S64indexLoopTrips(const uint8_t * prgmPtr, uint8_t * starts,
+    uint8_t n, uint8_t t, uint8_t i);
+uint8_t S64verifyProgram(uint8_t p, uint8_t * status, uint8_t * depth,
+    unsigned int * worst);
+uint8_t doSWEET64verify(void);
+#endif
+#ifdef useSWEET64disassembler
+uint8_t S64disPushStr(const char * str, uint8_t w);
+uint8_t S64disCallee(const uint8_t * prgmPtr, uint8_t i);
+unsigned long S64disEstimate(uint8_t p, unsigned long * est);
+void doSWEET64disassemble(void);
+#endif
+#ifdef useSWEET64selfTest
+unsigned long S64testRandom(void);
+void S64testOperand(union union_64 * an, uint8_t c);
+void S64testReference(uint8_t t, union union_64 * an, union union_64 * ann);
+uint8_t S64testCase(uint8_t t);
+uint8_t doSWEET64selfTest(void);
+#endif
+
 uint8_t loadParams(void);
 uint8_t eepromWriteVal(unsigned int eePtr, unsigned long val);
 unsigned long eepromReadVal(unsigned int eePtr);
 unsigned int eepromGetAddress(unsigned int eePtr);
+uint8_t eepromReadByte(unsigned int t);
+void eepromWriteByte(unsigned int t, uint8_t w);
+#ifdef useEEPROMwriteQueue
+void eepromFlush(void);
+#endif
+#ifdef useCRC16
+uint16_t crc16update(uint16_t crc, uint8_t b);
+#endif
 void callFuncPointer(const uint8_t * funcIdx);
 unsigned long cycles2(void);
 unsigned long findCycleLength(unsigned long lastCycle, unsigned long thisCycle);
+#ifdef useBackgroundTasks
+uint8_t runBackgroundTasks(void);
+#endif
+#ifdef useIdleSleep
+void idleSleep(void);
+#endif
 int main(void);
 
 /******************************************************************************/
@@ -286,7 +422,9 @@ int main(void);
 /******************************************************************************/
 
 const uint8_t loopsPerSecond = 2; // how many times will we try and loop in a second
-const uint8_t samplesPerSecond = 2; // how many times will we try to sample the ADC output in a second
+#ifdef useChryslerMAPCorrection
+const uint8_t samplesPerSecond = 200; // how many times will we try to recalculate the MAP correction factor in a second
+#endif
 
 #ifdef use20MHz
 const uint8_t processorSpeed = 20; // processor speed in megahertz
@@ -303,7 +441,9 @@ const uint8_t lcdDelayTable[4] PROGMEM = { 1, 1, 41, 148 }; // LCD delay values,
 const unsigned long t2CyclesPerSecond = (unsigned long)(processorSpeed * 15625ul); // (processorSpeed * 1000000 / (timer 2 prescaler))
 const unsigned long loopSystemLength = (t2CyclesPerSecond / (loopsPerSecond * 10)); // divided by 10 to keep cpu loading value from overflowing
 const unsigned int loopTickLength = (unsigned int)(t2CyclesPerSecond / (loopsPerSecond * 256ul));
-const unsigned int sampleTickLength  = (unsigned int)(t2CyclesPerSecond / (samplesPerSecond * 256ul));
+#ifdef useChryslerMAPCorrection
+const unsigned long samplePeriod = t2CyclesPerSecond / samplesPerSecond;
+#endif
 const unsigned int myubbr = (unsigned int)(processorSpeed * 625ul / 96ul - 1);
 const unsigned int keyDelay = (unsigned int)(t2CyclesPerSecond / 256ul);
 const unsigned int keyShortDelay = keyDelay - (5 * keyDelay / 100); // wait 5/100 of a second before accepting button presses
@@ -388,6 +528,14 @@ const uint8_t idxDoEditSystemTimeSave =			idxDoEditSystemTimeChangeDigit + 1;
 #undef nextAllowedValue
 #define nextAllowedValue idxDoEditSystemTimeSave
 #endif
+#ifdef useCoastDownCalculator
+const uint8_t idxDoCursorUpdateCoastDown =		nextAllowedValue + 1;
+const uint8_t idxDoCoastDownDisplay =			idxDoCursorUpdateCoastDown + 1;
+const uint8_t idxDoCoastDownAccept =			idxDoCoastDownDisplay + 1;
+const uint8_t idxDoCoastDownReset =			idxDoCoastDownAccept + 1;
+#undef nextAllowedValue
+#define nextAllowedValue idxDoCoastDownReset
+#endif
 #ifdef useSavedTrips
 const uint8_t idxDoCursorUpdateTripShow =		nextAllowedValue + 1;
 const uint8_t idxDoTripSaveDisplay =			idxDoCursorUpdateTripShow + 1;
@@ -436,6 +584,31 @@ const uint8_t idxGoEEPROMview =				idxDoEEPROMviewDisplay + 1;
 #undef nextAllowedValue
 #define nextAllowedValue idxGoEEPROMview
 #endif
+#ifdef useSWEET64profiler
+const uint8_t idxDoSWEET64profile =			nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue idxDoSWEET64profile
+#endif
+#ifdef useSWEET64disassembler
+const uint8_t idxDoSWEET64disassemble =			nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue idxDoSWEET64disassemble
+#endif
+#ifdef useFillUpHistory
+const uint8_t idxDoFillUpDump =				nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue idxDoFillUpDump
+#endif
+#ifdef useLoopPhaseTiming
+const uint8_t idxDoLoopPhaseDump =			nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue idxDoLoopPhaseDump
+#ifdef useSWEET64profiler
+const uint8_t idxDoCPUmonDump =				nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue idxDoCPUmonDump
+#endif
+#endif
 
 const uint8_t rvLength = 8;
 
@@ -593,9 +766,9 @@ const uint8_t periodIdx = 			nextAllowedValue + 1;
 #define nextAllowedValue periodIdx
 #endif
 #ifdef useBarFuelEconVsSpeed
-const uint8_t FEvsSpeedIdx = 			nextAllowedValue + 1;
+const uint8_t FEvsSpeedIdx = 			nextAllowedValue + 1;	// scratch trip for whichever speed bin is being displayed
 #undef nextAllowedValue
-#define nextAllowedValue (FEvsSpeedIdx + bgDataSize - 1)
+#define nextAllowedValue FEvsSpeedIdx
 #endif
 #ifdef useCoastDownCalculator
 const uint8_t thisCoastDownIdx = 		nextAllowedValue + 1;
@@ -604,9 +777,7 @@ const uint8_t lastCoastDownIdx = 		thisCoastDownIdx + 1;
 #define nextAllowedValue lastCoastDownIdx
 #endif
 #ifdef useWindowFilter
-const uint8_t windowFilterSize = 4;
-const uint8_t windowFilterElemIdx = 		nextAllowedValue + 1;
-const uint8_t windowFilterSumIdx = 		windowFilterElemIdx + windowFilterSize;
+const uint8_t windowFilterSumIdx = 		nextAllowedValue + 1;
 #undef nextAllowedValue
 #define nextAllowedValue windowFilterSumIdx
 #endif
@@ -859,6 +1030,10 @@ const uint8_t cgramBigNum = 1;
 #ifdef useSavedTrips
 #undef EuB7
 #define EuB7 0
+#ifdef useTripJournal
+#undef EuB4
+#define EuB4 0
+#endif
 #ifdef trackIdleEOCdata
 #undef EuB6
 #define EuB6 0
@@ -870,6 +1045,11 @@ const uint8_t cgramBigNum = 1;
 #define EuB5 0
 #endif
 
+#ifdef useFillUpHistory
+#undef EuB3
+#define EuB3 0
+#endif
+
 const uint8_t EEPROMusage = EuB7 | EuB6 | EuB5 | EuB4 | EuB3 | EuB2 | EuB1 | EuB0;
 
 const uint8_t eePtrSignature = 0;
@@ -947,10 +1127,16 @@ const uint8_t pSerialDataLoggingIdx =		nextAllowedValue + 1;
 #undef nextAllowedValue
 #define nextAllowedValue pSerialDataLoggingIdx
 #endif
+#ifdef useSerialBaudRate
+const uint8_t pSerialBaudRateIdx =		nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue pSerialBaudRateIdx
+#endif
 #ifdef useWindowFilter
 const uint8_t pWindowFilterIdx =		nextAllowedValue + 1;
+const uint8_t pWindowFilterExpIdx =		pWindowFilterIdx + 1;
 #undef nextAllowedValue
-#define nextAllowedValue pWindowFilterIdx
+#define nextAllowedValue pWindowFilterExpIdx
 #endif
 #ifdef useBarFuelEconVsTime
 const uint8_t pFEvsTimeIdx =			nextAllowedValue + 1;
@@ -970,8 +1156,9 @@ const uint8_t pAutoSaveIdleIdx =		nextAllowedValue + 1;
 #ifdef useBarFuelEconVsSpeed
 const uint8_t pBarLowSpeedCutoffIdx =		nextAllowedValue + 1;
 const uint8_t pBarSpeedQuantumIdx =		pBarLowSpeedCutoffIdx + 1;
+const uint8_t pBarSpeedLogIdx =			pBarSpeedQuantumIdx + 1;
 #undef nextAllowedValue
-#define nextAllowedValue pBarSpeedQuantumIdx
+#define nextAllowedValue pBarSpeedLogIdx
 #endif
 #ifdef useFuelCost
 const uint8_t pCostPerQuantity =		nextAllowedValue + 1;
@@ -1024,10 +1211,18 @@ const char parmLabels[] PROGMEM = {
 	"Timeout (s)\0"
 	"WakeupReset CURR\0"
 #ifdef useSerialPortDataLogging
+#ifdef useBinaryTelemetry
+	"DLog 1-CSV 2-Bin\0"
+#else
 	"DLogSerial 1-Yes\0"
 #endif
+#endif
+#ifdef useSerialBaudRate
+	"Serial Baud Rate\0"
+#endif
 #ifdef useWindowFilter
-	"WindowFilter 1-Y\0"
+	"WindowFilter Len\0"
+	"WinFilter 1-Exp\0"
 #endif
 #ifdef useBarFuelEconVsTime
 	"FE/Time Period s\0"
@@ -1041,6 +1236,7 @@ const char parmLabels[] PROGMEM = {
 #ifdef useBarFuelEconVsSpeed
 	"bgLower*1000 {MPH\\kph}\0"
 	"bgSize*1000 {MPH\\kph}\0"
+	"bgLogSize 1-Y\0"
 #endif
 #ifdef useFuelCost
 	"Fuel Price*1000\0"
@@ -1091,10 +1287,18 @@ const uint8_t pSizeCoefficientRR =		16;
 const uint8_t pSizeActivityTimeout =		16;
 const uint8_t pSizeWakupResetCurrent =		1;
 #ifdef useSerialPortDataLogging
+#ifdef useBinaryTelemetry
+const uint8_t pSizeSerialDataLogging =		2;
+#else
 const uint8_t pSizeSerialDataLogging =		1;
 #endif
+#endif
+#ifdef useSerialBaudRate
+const uint8_t pSizeSerialBaudRate =		20;
+#endif
 #ifdef useWindowFilter
-const uint8_t pSizeWindowFilter =		1;
+const uint8_t pSizeWindowFilter =		5;
+const uint8_t pSizeWindowFilterExp =		1;
 #endif
 #ifdef useBarFuelEconVsTime
 const uint8_t pSizeFEvsTime =			16;
@@ -1107,7 +1311,8 @@ const uint8_t pSizeAutoSaveIdle =		1;
 #endif
 #ifdef useBarFuelEconVsSpeed
 const uint8_t pSizeBarLowSpeedCutoff =		24;
-const uint8_t pSizeBarSpeedQuantumIdx =		24;
+const uint8_t pSizeBarSpeedQuantum =		24;
+const uint8_t pSizeBarSpeedLog =		1;
 #endif
 #ifdef useFuelCost
 const uint8_t pSizeFuelUnitCost =		16;
@@ -1160,8 +1365,12 @@ const uint8_t paramsLength[] PROGMEM = {
 #ifdef useSerialPortDataLogging
 	pSizeSerialDataLogging,				// Serial Data Logging Enable
 #endif
+#ifdef useSerialBaudRate
+	pSizeSerialBaudRate,				// Serial Port Baud Rate
+#endif
 #ifdef useWindowFilter
-	pSizeWindowFilter,				// Window Filter Enable
+	pSizeWindowFilter,				// Window Filter Length
+	pSizeWindowFilterExp,				// Window Filter Exponential Mode
 #endif
 #ifdef useBarFuelEconVsTime
 	pSizeFEvsTime,					// Period Of FE over Time BarGraph Bar (s)
@@ -1174,7 +1383,8 @@ const uint8_t paramsLength[] PROGMEM = {
 #endif
 #ifdef useBarFuelEconVsSpeed
 	pSizeBarLowSpeedCutoff,				// FE vs Speed Bargraph lower speed
-	pSizeBarSpeedQuantumIdx,			// FE vs Speed Bargraph speed bar size
+	pSizeBarSpeedQuantum,				// FE vs Speed Bargraph speed bar size
+	pSizeBarSpeedLog,				// FE vs Speed Bargraph log-spaced bar sizes
 #endif
 #ifdef useFuelCost
 	pSizeFuelUnitCost,				// Price per unit volume of fuel
@@ -1251,10 +1461,16 @@ const uint8_t pOffsetSerialDataLogging =	nextAllowedValue;
 #undef nextAllowedValue
 #define nextAllowedValue pOffsetSerialDataLogging + byteSize(pSizeSerialDataLogging)
 #endif
+#ifdef useSerialBaudRate
+const uint8_t pOffsetSerialBaudRate =		nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue pOffsetSerialBaudRate + byteSize(pSizeSerialBaudRate)
+#endif
 #ifdef useWindowFilter
 const uint8_t pOffsetWindowFilter =		nextAllowedValue;
+const uint8_t pOffsetWindowFilterExp =		pOffsetWindowFilter + byteSize(pSizeWindowFilter);
 #undef nextAllowedValue
-#define nextAllowedValue pOffsetWindowFilter + byteSize(pSizeWindowFilter)
+#define nextAllowedValue pOffsetWindowFilterExp + byteSize(pSizeWindowFilterExp)
 #endif
 #ifdef useBarFuelEconVsTime
 const uint8_t pOffsetFEvsTime =			nextAllowedValue;
@@ -1273,9 +1489,10 @@ const uint8_t pOffsetAutoSaveIdle =		nextAllowedValue;
 #endif
 #ifdef useBarFuelEconVsSpeed
 const uint8_t pOffsetBarLowSpeedCutoff =	nextAllowedValue;
-const uint8_t pOffsetBarSpeedQuantumIdx =	pOffsetBarLowSpeedCutoff + byteSize(pSizeBarLowSpeedCutoff);
+const uint8_t pOffsetBarSpeedQuantum =	pOffsetBarLowSpeedCutoff + byteSize(pSizeBarLowSpeedCutoff);
+const uint8_t pOffsetBarSpeedLog =		pOffsetBarSpeedQuantum + byteSize(pSizeBarSpeedQuantum);
 #undef nextAllowedValue
-#define nextAllowedValue pOffsetBarSpeedQuantumIdx + byteSize(pSizeBarSpeedQuantumIdx)
+#define nextAllowedValue pOffsetBarSpeedLog + byteSize(pSizeBarSpeedLog)
 #endif
 #ifdef useFuelCost
 const uint8_t pOffsetFuelUnitCost =		nextAllowedValue;
@@ -1331,8 +1548,12 @@ const uint8_t paramAddrs[] PROGMEM = {
 #ifdef useSerialPortDataLogging
 	(uint8_t)(eeAdrSettingsStart) + pOffsetSerialDataLogging,		// Serial Data Logging Enable
 #endif
+#ifdef useSerialBaudRate
+	(uint8_t)(eeAdrSettingsStart) + pOffsetSerialBaudRate,		// Serial Port Baud Rate
+#endif
 #ifdef useWindowFilter
-	(uint8_t)(eeAdrSettingsStart) + pOffsetWindowFilter,		// Window Filter Enable
+	(uint8_t)(eeAdrSettingsStart) + pOffsetWindowFilter,		// Window Filter Length
+	(uint8_t)(eeAdrSettingsStart) + pOffsetWindowFilterExp,		// Window Filter Exponential Mode
 #endif
 #ifdef useBarFuelEconVsTime
 	(uint8_t)(eeAdrSettingsStart) + pOffsetFEvsTime,			// Period Of FE over Time Bar Graph Bar (s)
@@ -1345,7 +1566,8 @@ const uint8_t paramAddrs[] PROGMEM = {
 #endif
 #ifdef useBarFuelEconVsSpeed
 	(uint8_t)(eeAdrSettingsStart) + pOffsetBarLowSpeedCutoff,		// FE vs Speed Bargraph lower speed
-	(uint8_t)(eeAdrSettingsStart) + pOffsetBarSpeedQuantumIdx,		// FE vs Speed Bargraph speed bar size
+	(uint8_t)(eeAdrSettingsStart) + pOffsetBarSpeedQuantum,		// FE vs Speed Bargraph speed bar size
+	(uint8_t)(eeAdrSettingsStart) + pOffsetBarSpeedLog,		// FE vs Speed Bargraph log-spaced bar sizes
 #endif
 #ifdef useFuelCost
 	(uint8_t)(eeAdrSettingsStart) + pOffsetFuelUnitCost,		// Price per unit volume of fuel
@@ -1401,8 +1623,12 @@ const uint32_t params[] PROGMEM = {
 #ifdef useSerialPortDataLogging
 	DEFAULT_SERIAL,
 #endif
+#ifdef useSerialBaudRate
+	DEFAULT_BAUD_RATE,
+#endif
 #ifdef useWindowFilter
 	DEFAULT_WIN_FILTER,
+	DEFAULT_WIN_FILTER_EXP,
 #endif
 #ifdef useBarFuelEconVsTime
 	DEFAULT_BARGRAPH_LEN,
@@ -1416,6 +1642,7 @@ const uint32_t params[] PROGMEM = {
 #ifdef useBarFuelEconVsSpeed
 	DEFAULT_FES_LOW,
 	DEFAULT_FES_SIZE,
+	DEFAULT_FES_LOG,
 #endif
 #ifdef useFuelCost
 	DEFAULT_PRICE,
@@ -1428,9 +1655,61 @@ const uint8_t settingsSize = (sizeof(params) / sizeof(uint32_t));
 const unsigned int eePtrSettingsEnd = eePtrSettingsStart + (unsigned int)(settingsSize);
 const unsigned int eeAdrSettingsEnd = eeAdrSettingsStart + (unsigned int)(pOffsetZZ);
 
+#ifdef useParameterCache
+uint8_t paramCache[(unsigned int)(pOffsetZZ)]; // byte for byte copy of the EEPROM settings section
+
+inline unsigned long paramCacheRead(uint8_t t, uint8_t l)
+{
+	unsigned long val = 0;
+
+	while (l > 0)
+	{
+		val <<= 8;
+		val += (unsigned long)(paramCache[(unsigned int)(t++)]);
+		l--;
+	}
+
+	return val;
+}
+
+/*
+ * read a setting that is known at compile time, as in paramRead(WindowFilter)
+ * the offset and length fold down to constants, so this is a few loads from RAM
+ */
+#define paramRead(name) paramCacheRead(pOffset##name, byteSize(pSize##name))
+#else
+#define paramRead(name) eepromReadVal(p##name##Idx)
+#endif
+
+#ifdef useEEPROMwriteQueue
+const uint8_t eeQueueSize = 32;
+
+volatile unsigned int eeQueueAddr[(unsigned int)(eeQueueSize)]; // pending EEPROM byte writes, serviced by the EE_READY interrupt
+volatile uint8_t eeQueueData[(unsigned int)(eeQueueSize)];
+volatile uint8_t eeQueueStart;
+volatile uint8_t eeQueueEnd;
+volatile uint8_t eeQueueCount;
+#endif
+
 // end of remarkably long EEPROM stored settings section
 
-const unsigned long newEEPROMsignature = ((unsigned long)(guinosig) << 16) + ((unsigned long)(settingsSize) << 8) + (unsigned long)(EEPROMusage);
+/*
+ * the middle signature byte changes whenever a setting is added, removed, or
+ * resized, so stored settings are never read back with the wrong layout
+ */
+const uint8_t settingsLayout = (uint8_t)(settingsSize + pOffsetZZ);
+
+const unsigned long newEEPROMsignature = ((unsigned long)(guinosig) << 16) + ((unsigned long)(settingsLayout) << 8) + (unsigned long)(EEPROMusage);
+
+/*
+ * compile time checks that the settings lists have not drifted apart - any failure shows up as a negative array size.
+ * tools/mpglayout.py packs the settings from paramsLength on its own, and checks paramAddrs, the defaults, and the
+ * signature against that
+ */
+typedef uint8_t paramsLengthCheck[(sizeof(paramsLength) == settingsSize) ? 1 : -1];
+typedef uint8_t paramAddrsCheck[(sizeof(paramAddrs) == settingsSize + 1) ? 1 : -1];
+typedef uint8_t paramIdxCheck[(pScratchpadIdx + 1 - eePtrSettingsStart == settingsSize) ? 1 : -1];
+typedef uint8_t paramSpaceCheck[(eeAdrSettingsStart + pOffsetZZ < 256) ? 1 : -1]; // paramAddrs only holds 8 bit addresses
 
 #undef nextAllowedValue
 #define nextAllowedValue eePtrSettingsEnd
@@ -1445,20 +1724,45 @@ const unsigned int eeAdrScreensEnd = eeAdrScreensStart + (unsigned int)(displayF
 #define nextAllowedValue eePtrScreensEnd
 #define nextAllowedValue2 eeAdrScreensEnd
 #endif
+#ifdef useFillUpHistory
+const uint8_t fillUpCount = 8;
+const uint8_t fillUpRecordSize = 25; // (uint16_t sequence number) plus (uint8_t signature) plus (uint16_t CRC) plus 5 (uint32_t) values
+const uint8_t fillUpNoRecord = 255;
+
+const unsigned int eeAdrFillUpStart = nextAllowedValue2;
+const unsigned int eeAdrFillUpEnd = eeAdrFillUpStart + (unsigned int)(fillUpRecordSize) * (unsigned int)(fillUpCount);
+#undef nextAllowedValue2
+#define nextAllowedValue2 eeAdrFillUpEnd
+#endif
 #ifdef useSavedTrips
 const unsigned int eePtrSavedTripsStart = nextAllowedValue;
 const unsigned int eeAdrSavedTripsStart = nextAllowedValue2;
 const unsigned int eeAdrSavedTripsTemp1 = (unsigned int)(E2END) - eeAdrSavedTripsStart + 1;
+#ifdef useTripJournal
+const uint8_t journalHeaderSize = 7; // (uint32_t sequence number) plus (uint8_t trip slot) plus (uint16_t CRC)
+const uint8_t journalRecordSize = eepromTripListSize + journalHeaderSize;
+const uint8_t journalNoRecord = 255;
+const uint8_t eeAdrSavedTripsTemp2 = (uint8_t)(eeAdrSavedTripsTemp1 / (unsigned int)(journalRecordSize)); // number of journal records
+const uint8_t eeAdrSavedTripsTemp3 = ((tripSaveSlotCount >= eeAdrSavedTripsTemp2) ? eeAdrSavedTripsTemp2 - 1 : tripSaveSlotCount); // always leave one record free
+const unsigned int eePtrSavedTripsEnd = eePtrSavedTripsStart + (unsigned int)(tripListSize) * (unsigned int)(eeAdrSavedTripsTemp3);
+const unsigned int eeAdrSavedTripsEnd = eeAdrSavedTripsStart + (unsigned int)(journalRecordSize) * (unsigned int)(eeAdrSavedTripsTemp2);
+
+uint8_t journalSlotRecord[(unsigned int)(tripSaveSlotCount)]; // journal record currently holding each trip slot
+uint8_t journalHead; // where to start looking for the next free journal record
+unsigned long journalSequence; // sequence number for the next journal record
+#else
 const uint8_t eeAdrSavedTripsTemp2 = (uint8_t)(eeAdrSavedTripsTemp1 / (unsigned int)(eepromTripListSize));
 const uint8_t eeAdrSavedTripsTemp3 = ((tripSaveSlotCount > eeAdrSavedTripsTemp2) ? eeAdrSavedTripsTemp2 : tripSaveSlotCount);
 const unsigned int eePtrSavedTripsEnd = eePtrSavedTripsStart + (unsigned int)(tripListSize) * (unsigned int)(eeAdrSavedTripsTemp3);
 const unsigned int eeAdrSavedTripsEnd = eeAdrSavedTripsStart + (unsigned int)(eepromTripListSize) * (unsigned int)(eeAdrSavedTripsTemp3);
+#endif
 #undef nextAllowedValue
 #undef nextAllowedValue2
 #define nextAllowedValue eePtrSavedTripsEnd
 #define nextAllowedValue2 eeAdrSavedTripsEnd
 #endif
 const uint8_t eePtrEnd = nextAllowedValue;
+const unsigned int eeAdrEnd = nextAllowedValue2;
 
 #ifdef useSavedTrips
 const uint8_t tripSelectList[] PROGMEM = {
@@ -1764,23 +2068,6 @@ const uint8_t tripUpdateDestList[] PROGMEM = {
 	lastCoastDownIdx | 0x80,				// transfer last loop's coastdown trip data to last coastdown trip
 	thisCoastDownIdx,					// update this loop's coastdown trip with instant
 #endif
-#ifdef useBarFuelEconVsSpeed
-	FEvsSpeedIdx,						// ensure this matches the value in bgDataSize
-	FEvsSpeedIdx + 1,
-	FEvsSpeedIdx + 2,
-	FEvsSpeedIdx + 3,
-	FEvsSpeedIdx + 4,
-	FEvsSpeedIdx + 5,
-	FEvsSpeedIdx + 6,
-	FEvsSpeedIdx + 7,
-	FEvsSpeedIdx + 8,
-	FEvsSpeedIdx + 9,
-	FEvsSpeedIdx + 10,
-	FEvsSpeedIdx + 11,
-	FEvsSpeedIdx + 12,
-	FEvsSpeedIdx + 13,
-	FEvsSpeedIdx + 14,
-#endif
 };
 
 const uint8_t tUScount = (sizeof(tripUpdateSrcList) / sizeof(uint8_t));
@@ -1961,8 +2248,16 @@ const uint8_t DNUISinstrDivXbyY = 			DNUISinstrMulXbyY + 1;
 const uint8_t DNUISinstrShiftLeft = 			nextAllowedValue + 1;
 const uint8_t DNUISinstrShiftRight = 			DNUISinstrShiftLeft + 1;
 const uint8_t DNUISinstrAddToIndex = 			DNUISinstrShiftRight + 1;
+const uint8_t DNUISinstrMulByByte = 			DNUISinstrAddToIndex + 1;
+const uint8_t DNUISinstrMulByTripVar = 			DNUISinstrMulByByte + 1;
+const uint8_t DNUISinstrMulByConst = 			DNUISinstrMulByTripVar + 1;
+const uint8_t DNUISinstrMulByEEPROM = 			DNUISinstrMulByConst + 1;
+const uint8_t DNUISinstrDivByByte = 			DNUISinstrMulByEEPROM + 1;
+const uint8_t DNUISinstrDivByTripVar = 			DNUISinstrDivByByte + 1;
+const uint8_t DNUISinstrDivByConst = 			DNUISinstrDivByTripVar + 1;
+const uint8_t DNUISinstrDivByEEPROM = 			DNUISinstrDivByConst + 1;
 #undef nextAllowedValue
-#define nextAllowedValue DNUISinstrAddToIndex
+#define nextAllowedValue DNUISinstrDivByEEPROM
 #ifdef useIsqrt
 const uint8_t DNUISinstrIsqrt = 			nextAllowedValue + 1;
 #undef nextAllowedValue
@@ -1978,6 +2273,9 @@ const uint8_t DNUISinstrLdPressure = 			nextAllowedValue + 1;
 #undef nextAllowedValue
 #define nextAllowedValue DNUISinstrLdPressure
 #endif
+#ifdef useSWEET64profiler
+const uint8_t DNUISinstrCount = 			nextAllowedValue + 1;
+#endif
 
 #define instrDone			DNUISinstrDone
 #define instrTraceOn			DNUISinstrTraceOn
@@ -2016,6 +2314,14 @@ const uint8_t DNUISinstrLdPressure = 			nextAllowedValue + 1;
 #define instrShiftLeft			(DNUISinstrShiftLeft | 0x40)
 #define instrShiftRight			(DNUISinstrShiftRight | 0x40)
 #define instrAddToIndex			(DNUISinstrAddToIndex | 0x80)
+#define instrMulByByte			(DNUISinstrMulByByte | 0x80)
+#define instrMulByTripVar		(DNUISinstrMulByTripVar | 0x80)
+#define instrMulByConst			(DNUISinstrMulByConst | 0x80)
+#define instrMulByEEPROM		(DNUISinstrMulByEEPROM | 0x80)
+#define instrDivByByte			(DNUISinstrDivByByte | 0x80)
+#define instrDivByTripVar		(DNUISinstrDivByTripVar | 0x80)
+#define instrDivByConst			(DNUISinstrDivByConst | 0x80)
+#define instrDivByEEPROM		(DNUISinstrDivByEEPROM | 0x80)
 #ifdef useAnalogRead
 #define instrLdVoltage			(DNUISinstrLdVoltage | 0x40)
 #endif
@@ -2026,6 +2332,204 @@ const uint8_t DNUISinstrLdPressure = 			nextAllowedValue + 1;
 #define instrIsqrt			(DNUISinstrIsqrt | 0x40)
 #endif
 
+#ifdef useSWEET64verifier
+const uint8_t S64instrList[] PROGMEM = { // complete encoding of each supported opcode, in DNUISinstr order
+	instrDone,
+#ifdef useSWEET64trace
+	instrTraceOn,
+	instrTraceOff,
+#else
+	0xFF,							// trace opcodes are unsupported without useSWEET64trace
+	0xFF,
+#endif
+	instrSkipIfMetricMode,
+	instrSkipIfZero,
+	instrSkipIfLTorE,
+	instrSkipIfLSBset,
+	instrSkipIfMSBset,
+	instrSkipIfIndexBelow,
+	instrSkip,
+	instrLd,
+	instrLdByte,
+	instrLdByteFromYindexed,
+	instrLdTripVar,
+	instrLdTtlFuelUsed,
+	instrLdConst,
+	instrLdEEPROM,
+	instrStByteToYindexed,
+	instrStEEPROM,
+	instrLdEEPROMindexed,
+	instrLdEEPROMindirect,
+	instrStEEPROMindirect,
+	instrLdIndex,
+	instrLdNumer,
+	instrLdDenom,
+	instrCall,
+	instrJump,
+	instrSwap,
+	instrSubYfromX,
+	instrAddYtoX,
+#ifndef useSWEET64multDiv
+	instrMulXbyY,
+	instrDivXbyY,
+#endif
+	instrShiftLeft,
+	instrShiftRight,
+	instrAddToIndex,
+	instrMulByByte,
+	instrMulByTripVar,
+	instrMulByConst,
+	instrMulByEEPROM,
+	instrDivByByte,
+	instrDivByTripVar,
+	instrDivByConst,
+	instrDivByEEPROM,
+#ifdef useIsqrt
+	instrIsqrt,
+#endif
+#ifdef useAnalogRead
+	instrLdVoltage,
+#endif
+#ifdef useChryslerMAPCorrection
+	instrLdPressure,
+#endif
+};
+
+const uint8_t S64instrCount = (sizeof(S64instrList) / sizeof(uint8_t));
+#endif
+
+#ifdef useSWEET64disassembler
+const char S64instrNames[] PROGMEM = { // mnemonic of each opcode, in DNUISinstr order
+	"Done\0"
+	"TraceOn\0"
+	"TraceOff\0"
+	"SkipIfMetricMode\0"
+	"SkipIfZero\0"
+	"SkipIfLTorE\0"
+	"SkipIfLSBset\0"
+	"SkipIfMSBset\0"
+	"SkipIfIndexBelow\0"
+	"Skip\0"
+	"Ld\0"
+	"LdByte\0"
+	"LdByteFromYindexed\0"
+	"LdTripVar\0"
+	"LdTtlFuelUsed\0"
+	"LdConst\0"
+	"LdEEPROM\0"
+	"StByteToYindexed\0"
+	"StEEPROM\0"
+	"LdEEPROMindexed\0"
+	"LdEEPROMindirect\0"
+	"StEEPROMindirect\0"
+	"LdIndex\0"
+	"LdNumer\0"
+	"LdDenom\0"
+	"Call\0"
+	"Jump\0"
+	"Swap\0"
+	"SubYfromX\0"
+	"AddYtoX\0"
+#ifndef useSWEET64multDiv
+	"MulXbyY\0"
+	"DivXbyY\0"
+#endif
+	"ShiftLeft\0"
+	"ShiftRight\0"
+	"AddToIndex\0"
+	"MulByByte\0"
+	"MulByTripVar\0"
+	"MulByConst\0"
+	"MulByEEPROM\0"
+	"DivByByte\0"
+	"DivByTripVar\0"
+	"DivByConst\0"
+	"DivByEEPROM\0"
+#ifdef useIsqrt
+	"Isqrt\0"
+#endif
+#ifdef useAnalogRead
+	"LdVoltage\0"
+#endif
+#ifdef useChryslerMAPCorrection
+	"LdPressure\0"
+#endif
+};
+
+/*
+ * rough cost of each opcode in CPU cycles, including its trip thru the
+ * SWEET64 dispatch chain. native multiply and divide are charged for a full
+ * 64 bit operand, so they are an upper bound. these are hand estimates, and
+ * the useSWEET64profiler readings are what to calibrate them against
+ */
+#ifdef useSWEET64multDiv
+const unsigned long s64dMulCycles = 60ul;	/* just the call into prgmDoMultiply */
+const unsigned long s64dDivCycles = 60ul;	/* just the call into prgmDoDivide */
+#else
+const unsigned long s64dMulCycles = 26000ul;	/* mul64() */
+const unsigned long s64dDivCycles = 51000ul;	/* div64() */
+#endif
+
+const unsigned long S64instrCycles[] PROGMEM = {
+	40ul,			// Done
+	40ul,			// TraceOn
+	40ul,			// TraceOff
+	60ul,			// SkipIfMetricMode
+	120ul,			// SkipIfZero
+	200ul,			// SkipIfLTorE
+	80ul,			// SkipIfLSBset
+	80ul,			// SkipIfMSBset
+	80ul,			// SkipIfIndexBelow
+	70ul,			// Skip
+	110ul,			// Ld
+	120ul,			// LdByte
+	120ul,			// LdByteFromYindexed
+	150ul,			// LdTripVar
+	150ul,			// LdTtlFuelUsed
+	130ul,			// LdConst
+	400ul,			// LdEEPROM
+	90ul,			// StByteToYindexed
+	220000ul,		// StEEPROM - up to 4 bytes at 3.4 ms each
+	400ul,			// LdEEPROMindexed
+	420ul,			// LdEEPROMindirect
+	220000ul,		// StEEPROMindirect
+	70ul,			// LdIndex
+	150ul,			// LdNumer
+	150ul,			// LdDenom
+	100ul,			// Call
+	90ul,			// Jump
+	160ul,			// Swap
+	180ul,			// SubYfromX
+	180ul,			// AddYtoX
+#ifndef useSWEET64multDiv
+	26000ul,		// MulXbyY
+	51000ul,		// DivXbyY
+#endif
+	130ul,			// ShiftLeft
+	130ul,			// ShiftRight
+	70ul,			// AddToIndex
+	120ul + s64dMulCycles,	// MulByByte
+	150ul + s64dMulCycles,	// MulByTripVar
+	130ul + s64dMulCycles,	// MulByConst
+	400ul + s64dMulCycles,	// MulByEEPROM
+	120ul + s64dDivCycles,	// DivByByte
+	150ul + s64dDivCycles,	// DivByTripVar
+	130ul + s64dDivCycles,	// DivByConst
+	400ul + s64dDivCycles,	// DivByEEPROM
+#ifdef useIsqrt
+	1500ul,			// Isqrt
+#endif
+#ifdef useAnalogRead
+	120ul,			// LdVoltage
+#endif
+#ifdef useChryslerMAPCorrection
+	120ul,			// LdPressure
+#endif
+};
+
+typedef uint8_t S64instrCyclesCheck[(sizeof(S64instrCycles) / sizeof(unsigned long) == S64instrCount) ? 1 : -1];
+#endif
+
 const uint8_t idxS64findRemainingFuel = dfMaxValDisplayCount;
 const uint8_t idxS64doMultiply = idxS64findRemainingFuel + 1;
 const uint8_t idxS64doDivide = idxS64doMultiply + 1;
@@ -2036,101 +2540,48 @@ const uint8_t idxS64doNumber = idxS64doAdjust + 1;
 
 const uint8_t prgmEngineSpeed[] PROGMEM = {
 	instrLdTripVar, 0x02, rvInjPulseIdx,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdByte, 0x01, 60,					// load seconds per minute into register 1
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pCrankRevPerInjIdx,
-	instrCall, idxS64doMultiply,
-	instrLdTripVar, 0x01, rvInjCycleIdx,
-	instrJump, idxS64doDivide,
+	instrMulByConst, idxCyclesPerSecond,
+	instrMulByByte, 60,					// multiply by seconds per minute
+	instrMulByConst, idxDecimalPoint,
+	instrMulByEEPROM, pCrankRevPerInjIdx,
+	instrDivByTripVar, rvInjCycleIdx,
+	instrDone
 };
 
 const uint8_t prgmMotionTime[] PROGMEM = {
 	instrLdTripVar, 0x02, rvVSScycleIdx,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrJump, idxS64doDivide,
+	instrDivByConst, idxCyclesPerSecond,
+	instrDone
 };
 
 const uint8_t prgmDistance[] PROGMEM = {
 	instrLdTripVar, 0x02, rvVSSpulseIdx,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,
-	instrJump, idxS64doDivide,
+	instrMulByConst, idxDecimalPoint,
+	instrDivByEEPROM, pPulsesPerDistanceIdx,
+	instrDone
 };
 
 const uint8_t prgmSpeed[] PROGMEM = {
 	instrLdTripVar, 0x02, rvVSScycleIdx,
-	instrSkipIfZero, 0x02, 29,
+	instrSkipIfZero, 0x02, 17,
 
-	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,
-	instrCall, idxS64doMultiply,
+	instrMulByEEPROM, pPulsesPerDistanceIdx,
 	instrSwap, 0x23,
 	instrLdTripVar, 0x02, rvVSSpulseIdx,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxSecondsPerHour,
-	instrCall, idxS64doMultiply,
+	instrMulByConst, idxDecimalPoint,
+	instrMulByConst, idxCyclesPerSecond,
+	instrMulByConst, idxSecondsPerHour,
 	instrSwap, 0x13,
 	instrJump, idxS64doDivide,
 
 	instrDone
 };
 
-#ifdef useBarFuelEconVsSpeed
-const uint8_t prgmFEvsSpeed[] PROGMEM = {
-	instrLdEEPROM, 0x01, pBarLowSpeedCutoffIdx,		// convert stored distance per hour to pulses per hour
-	instrLdEEPROM, 0x02, pPulsesPerDistanceIdx,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doDivide,
-	instrSwap, 0x23,
-
-	instrLdTripVar, 0x02, rvVSSpulseIdx,			// generate speed in pulses per hour
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxSecondsPerHour,
-	instrCall, idxS64doMultiply,
-	instrLdTripVar, 0x01, rvVSScycleIdx,
-	instrCall, idxS64doDivide,
-
-	instrSkipIfLTorE, 0x32, 4,				// if (converted value <= generated value), skip to next section
-	instrLdByte, 0x02, 0xFF,				// load a 255 into register 2
-	instrDone,						// exit to caller
-
-	instrSubYfromX, 0x23,					// subtract converted value from generated value
-	instrSwap, 0x23,
-
-	instrLdEEPROM, 0x01, pBarSpeedQuantumIdx,		// convert stored distance per hour to pulses per hour
-	instrLdEEPROM, 0x02, pPulsesPerDistanceIdx,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doDivide,
-	instrSkipIfZero, 0x02, 232,				// if (bargraph size == 0), load an 0xFF into register 2 and exit to caller
-	instrSwap, 0x21,					// move to denominator position
-
-	instrSwap, 0x23,					// get numerator (generated - converted value)
-	instrCall, idxS64doDivide,				// perform division
-
-	instrLdByte, 0x01, bgDataSize,				// compare to bargraph data size
-	instrSkipIfLTorE, 0x12, 220,				// if (bargraph size <= calculated value), load an 0xFF into register 2 and exit to caller
-	instrLdByte, 0x01, FEvsSpeedIdx,			// convert calculated value into a trip index
-	instrAddYtoX, 0x21,
-	instrDone
-};
-#endif
-
 const uint8_t prgmFuelUsed[] PROGMEM = {
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,
-	instrSkipIfZero, 0x02, 9,
+	instrSkipIfZero, 0x02, 6,
 
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
+	instrMulByConst, idxDecimalPoint,
 	instrCall, idxS64findCyclesPerQuantity,
 	instrJump, idxS64doDivide,
 
@@ -2140,10 +2591,9 @@ const uint8_t prgmFuelUsed[] PROGMEM = {
 #ifdef useFuelCost
 const uint8_t prgmFuelCost[] PROGMEM = {
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,
-	instrSkipIfZero, 0x02, 9,
+	instrSkipIfZero, 0x02, 6,
 
-	instrLdEEPROM, 0x01, pCostPerQuantity,
-	instrCall, idxS64doMultiply,
+	instrMulByEEPROM, pCostPerQuantity,
 	instrCall, idxS64findCyclesPerQuantity,
 	instrJump, idxS64doDivide,
 
@@ -2152,18 +2602,13 @@ const uint8_t prgmFuelCost[] PROGMEM = {
 
 const uint8_t prgmFuelRateCost[] PROGMEM = {
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,
-	instrSkipIfZero, 0x02, 25,
+	instrSkipIfZero, 0x02, 10,
 
-	instrLdEEPROM, 0x01, pCostPerQuantity,
-	instrCall, idxS64doMultiply,
-	instrLdTripVar, 0x01, rvInjCycleIdx,
-	instrCall, idxS64doDivide,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxSecondsPerHour,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pMicroSecondsPerQuantityIdx,
-	instrJump, idxS64doDivide,
+	instrMulByEEPROM, pCostPerQuantity,
+	instrDivByTripVar, rvInjCycleIdx,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrMulByConst, idxSecondsPerHour,
+	instrDivByEEPROM, pMicroSecondsPerQuantityIdx,
 
 	instrDone
 };
@@ -2175,10 +2620,8 @@ const uint8_t prgmFuelCostPerDistance[] PROGMEM = {
 	instrSwap, 0x23,					// save it for later
 
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,		// fetch the accumulated fuel injector open cycle measurement
-	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,		// fetch the pulses per unit distance factor
-	instrCall, idxS64doMultiply,				// multiply the two numbers to get the numerator for fuel cost per distance
-	instrLdEEPROM, 0x01, pCostPerQuantity,			// load fuel cost per unit quantity into register 1
-	instrCall, idxS64doMultiply,				// multiply the numerator by the formatting term
+	instrMulByEEPROM, pPulsesPerDistanceIdx,		// multiply by the pulses per unit distance factor
+	instrMulByEEPROM, pCostPerQuantity,			// multiply by fuel cost per unit quantity
 
 	instrSwap, 0x13,					// move the denominator term into position
 	instrJump, idxS64doDivide,				// divide the numerator by the denominator, then exit to caller
@@ -2188,17 +2631,13 @@ const uint8_t prgmDistancePerFuelCost[] PROGMEM = {
 	instrLdTripVar, 0x02, rvVSSpulseIdx,			// fetch the accumulated number of VSS pulses counted
 	instrCall, idxS64findCyclesPerQuantity,			// calculate the cycles per unit fuel quantity factor
 	instrCall, idxS64doMultiply,				// multiply the two numbers to get the numerator for distance per fuel cost
-	instrLdConst, 0x01, idxDecimalPoint,			// load the decimal point constant used for output formatting
-	instrCall, idxS64doMultiply,				// multiply the numerator by the formatting term
-	instrLdConst, 0x01, idxDecimalPoint,			// load the decimal point constant used for output formatting
-	instrCall, idxS64doMultiply,				// multiply the numerator by the formatting term
+	instrMulByConst, idxDecimalPoint,			// multiply the numerator by the formatting term
+	instrMulByConst, idxDecimalPoint,			// multiply the numerator by the formatting term
 	instrSwap, 0x23,					// save it for later
 
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,		// fetch the accumulated fuel injector open cycle measurement
-	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,		// fetch the pulses per unit distance factor
-	instrCall, idxS64doMultiply,				// multiply the two numbers to get the denominator for distance per fuel cost
-	instrLdEEPROM, 0x01, pCostPerQuantity,			// load fuel cost per unit quantity into register 1
-	instrCall, idxS64doMultiply,				// multiply the numerator by the formatting term
+	instrMulByEEPROM, pPulsesPerDistanceIdx,		// multiply by the pulses per unit distance factor
+	instrMulByEEPROM, pCostPerQuantity,			// multiply by fuel cost per unit quantity
 	instrSwap, 0x23,					// swap the numerator and denominator terms around
 
 	instrSwap, 0x13,					// move the denominator term into position
@@ -2207,16 +2646,12 @@ const uint8_t prgmDistancePerFuelCost[] PROGMEM = {
 
 const uint8_t prgmRemainingFuelCost[] PROGMEM = {
 	instrCall, idxS64findRemainingFuel,
-	instrSkipIfZero, 0x02, 20,
+	instrSkipIfZero, 0x02, 8,
 
-	instrLdEEPROM, 0x01, pCostPerQuantity,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doDivide,
-	instrLdEEPROM, 0x01, pMicroSecondsPerQuantityIdx,
-	instrJump, idxS64doDivide,
+	instrMulByEEPROM, pCostPerQuantity,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrDivByConst, idxCyclesPerSecond,
+	instrDivByEEPROM, pMicroSecondsPerQuantityIdx,
 
 	instrDone
 };
@@ -2224,24 +2659,19 @@ const uint8_t prgmRemainingFuelCost[] PROGMEM = {
 
 const uint8_t prgmEngineRunTime[] PROGMEM = {
 	instrLdTripVar, 0x02, rvInjCycleIdx,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrJump, idxS64doDivide,
+	instrDivByConst, idxCyclesPerSecond,
+	instrDone
 };
 
 const uint8_t prgmFuelRate[] PROGMEM = {
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,
-	instrSkipIfZero, 0x02, 25,
+	instrSkipIfZero, 0x02, 10,
 
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdTripVar, 0x01, rvInjCycleIdx,
-	instrCall, idxS64doDivide,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxSecondsPerHour,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pMicroSecondsPerQuantityIdx,
-	instrJump, idxS64doDivide,
+	instrMulByConst, idxDecimalPoint,
+	instrDivByTripVar, rvInjCycleIdx,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrMulByConst, idxSecondsPerHour,
+	instrDivByEEPROM, pMicroSecondsPerQuantityIdx,
 
 	instrDone
 };
@@ -2253,8 +2683,7 @@ const uint8_t prgmFuelEcon[] PROGMEM = {
 	instrSwap, 0x23,					// save it for later
 
 	instrLdTripVar, 0x02, rvInjOpenCycleIdx,		// fetch the accumulated fuel injector open cycle measurement
-	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,		// fetch the pulses per unit distance factor
-	instrCall, idxS64doMultiply,				// multiply the two numbers to get the numerator for fuel economy
+	instrMulByEEPROM, pPulsesPerDistanceIdx,		// multiply by the pulses per unit distance factor
 
 	instrSkipIfMetricMode, 7,				// if metric mode set, skip ahead
 	instrSwap, 0x23,					// swap the numerator and denominator terms around
@@ -2274,14 +2703,10 @@ const uint8_t prgmFuelEcon[] PROGMEM = {
 
 const uint8_t prgmFindRemainingFuel[] PROGMEM = {
 	instrLdEEPROM, 0x02, pTankSizeIdx,
-	instrLdEEPROM, 0x01, pMicroSecondsPerQuantityIdx,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doDivide,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doDivide,
+	instrMulByEEPROM, pMicroSecondsPerQuantityIdx,
+	instrMulByConst, idxCyclesPerSecond,
+	instrDivByConst, idxMicroSecondsPerSecond,
+	instrDivByConst, idxDecimalPoint,
 	instrLdTtlFuelUsed, 0x01,
 
 	instrSkipIfLTorE, 0x12, 4,
@@ -2295,32 +2720,24 @@ const uint8_t prgmFindRemainingFuel[] PROGMEM = {
 
 const uint8_t prgmRemainingFuel[] PROGMEM = {
 	instrCall, idxS64findRemainingFuel,
-	instrSkipIfZero, 0x02, 20,
+	instrSkipIfZero, 0x02, 8,
 
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doDivide,
-	instrLdEEPROM, 0x01, pMicroSecondsPerQuantityIdx,
-	instrJump, idxS64doDivide,
+	instrMulByConst, idxDecimalPoint,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrDivByConst, idxCyclesPerSecond,
+	instrDivByEEPROM, pMicroSecondsPerQuantityIdx,
 
 	instrDone
 };
 
 const uint8_t prgmDistanceToEmpty[] PROGMEM = {
 	instrCall, idxS64findRemainingFuel,
-	instrSkipIfZero, 0x02, 22,
+	instrSkipIfZero, 0x02, 10,
 
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdTripVar, 0x01, rvInjOpenCycleIdx,
-	instrCall, idxS64doDivide,
-	instrLdTripVar, 0x01, rvVSSpulseIdx,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,
-	instrCall, idxS64doDivide,
+	instrMulByConst, idxDecimalPoint,
+	instrDivByTripVar, rvInjOpenCycleIdx,
+	instrMulByTripVar, rvVSSpulseIdx,
+	instrDivByEEPROM, pPulsesPerDistanceIdx,
 	instrJump, idxS64doAdjust,
 
 	instrDone
@@ -2333,14 +2750,11 @@ const uint8_t prgmTimeToEmpty[] PROGMEM = {
 	instrSwap, 0x23,
 
 	instrCall, idxS64findRemainingFuel,
-	instrSkipIfZero, 0x02, 19,
+	instrSkipIfZero, 0x02, 10,
 
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdTripVar, 0x01, rvInjOpenCycleIdx,
-	instrCall, idxS64doDivide,
-	instrLdTripVar, 0x01, rvInjCycleIdx,
-	instrCall, idxS64doMultiply,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrDivByTripVar, rvInjOpenCycleIdx,
+	instrMulByTripVar, rvInjCycleIdx,
 	instrSwap, 0x13,
 	instrJump, idxS64doDivide,
 
@@ -2377,8 +2791,8 @@ const uint8_t prgmVoltage[] PROGMEM = {
 	instrLdConst, 0x02, idxDenomVoltage,
 	instrLdVoltage, 0x01,
 	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxNumerVoltage,
-	instrJump, idxS64doDivide,
+	instrDivByConst, idxNumerVoltage,
+	instrDone
 };
 #endif
 #ifdef useChryslerMAPCorrection
@@ -2392,16 +2806,15 @@ const uint8_t prgmCorrF[] PROGMEM = {
 	instrLdConst, 0x02, idxDecimalPoint,
 	instrLdPressure, 0x01,
 	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCorrFactor,
-	instrJump, idxS64doDivide,
+	instrDivByConst, idxCorrFactor,
+	instrDone
 };
 #endif
 
 const uint8_t prgmConvertToMicroSeconds[] PROGMEM = {
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrJump, idxS64doDivide,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrDivByConst, idxCyclesPerSecond,
+	instrDone
 };
 
 const uint8_t prgmDoMultiply[] PROGMEM = {
@@ -2428,13 +2841,14 @@ const uint8_t prgmDoMultiply[] PROGMEM = {
 
 const uint8_t prgmDoDivide[] PROGMEM = {
 #ifdef useSWEET64multDiv
-	instrSkipIfZero, 0x02, 13,				// exit if dividend is zero
-	instrSkipIfZero, 0x01, 2,				// skip if divisor is zero
-	instrSkip, 11,						// skip ahead
+	instrSkipIfZero, 0x01, 5,				// skip if divisor is zero
+	instrSkipIfZero, 0x02, 10,				// exit if dividend is zero
+	instrSkip, 13,						// skip ahead
 	instrLdByte, 0x02, 0,					// zero out result (register 2)
 	instrLdByte, 0x05, 1,					// load 1 into register 5
 	instrSubYfromX, 0x25,					// set overflow value in result
 	instrLd, 0x12,						// set overflow (or zero numerator) value in remainder
+	instrLd, 0x42,						// set overflow (or zero numerator) value in divisor, so doAdjust leaves the result alone
 	instrDone,						// exit to caller
 
 	instrLd, 0x41,						// load register 4 with divisor
@@ -2462,9 +2876,7 @@ const uint8_t prgmDoDivide[] PROGMEM = {
 };
 
 const uint8_t prgmDoAdjust[] PROGMEM = {
-	instrSkipIfLTorE, 0x14, 1,				// if (divisor / 2 <= dividend), skip to next section
-	instrDone,
-
+	instrSkipIfLTorE, 0x14, 5,				// if (remainder <= divisor / 2), exit - register 4 is left holding divisor / 2 by doDivide
 	instrLdByte, 0x05, 1,					// load a 1 into the old quotient bitmask register
 	instrAddYtoX, 0x25,					// bump up quotient by one
 	instrDone						// exit to caller
@@ -2505,11 +2917,10 @@ const uint8_t prgmRoundOffNumber[] PROGMEM = {
 
 const uint8_t prgmFormatToNumber[] PROGMEM = {
 	instrLdIndex, 4,					// load 5 into index
-	instrLdByte, 0x01, 100,					// load 100 into register 1
-	instrCall, idxS64doDivide,				// perform division - quotient remains in register 2, and remainder goes into register 1
+	instrDivByByte, 100,					// divide by 100 - quotient remains in register 2, and remainder goes into register 1
 	instrStByteToYindexed, 0x13,				// store remainder into indexed byte of register 3
 	instrAddToIndex, 255,					// update index
-	instrSkipIfIndexBelow, 244, 255,			// continue if index is greater than or equal to 0
+	instrSkipIfIndexBelow, 247, 255,			// continue if index is greater than or equal to 0
 
 	instrLdIndex, 7,
 	instrLdByte, 0x01, 32,					// load leading zero character into register 1
@@ -2525,8 +2936,7 @@ const uint8_t prgmFindCyclesPerQuantity[] PROGMEM = {
 	instrLdConst, 0x01, idxCyclesPerSecond,
 	instrLdEEPROM, 0x02, pMicroSecondsPerQuantityIdx,
 	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doDivide,
+	instrDivByConst, idxMicroSecondsPerSecond,
 	instrLd, 0x12,
 	instrSwap, 0x23,
 	instrDone
@@ -2534,16 +2944,13 @@ const uint8_t prgmFindCyclesPerQuantity[] PROGMEM = {
 
 const uint8_t prgmFormatToTime[] PROGMEM = {
 	instrLdIndex, 2,
-	instrLdByte, 0x01, 60,					// load seconds per minute into register 1
-	instrCall, idxS64doDivide,
+	instrDivByByte, 60,					// divide by seconds per minute
 	instrStByteToYindexed, 0x13,
 	instrLdIndex, 1,
-	instrLdByte, 0x01, 60,					// load minutes per hour into register 1
-	instrCall, idxS64doDivide,
+	instrDivByByte, 60,					// divide by minutes per hour
 	instrStByteToYindexed, 0x13,
 	instrLdIndex, 0,
-	instrLdByte, 0x01, 24,					// load hours per day into register 1
-	instrCall, idxS64doDivide,
+	instrDivByByte, 24,					// divide by hours per day
 	instrStByteToYindexed, 0x13,
 	instrLdIndex, 7,
 	instrLdByte, 0x01, 48,					// load leading zero character into register 1
@@ -2662,6 +3069,12 @@ const uint16_t funcPointers[] PROGMEM = {
 	(uint16_t)doEditSystemTimeChangeDigit,
 	(uint16_t)doEditSystemTimeSave,
 #endif
+#ifdef useCoastDownCalculator
+	(uint16_t)doCursorUpdateCoastDown,
+	(uint16_t)doCoastDownDisplay,
+	(uint16_t)doCoastDownAccept,
+	(uint16_t)doCoastDownReset,
+#endif
 #ifdef useSavedTrips
 	(uint16_t)doCursorUpdateTripShow,
 	(uint16_t)doTripSaveDisplay,
@@ -2698,6 +3111,21 @@ const uint16_t funcPointers[] PROGMEM = {
 	(uint16_t)doEEPROMviewDisplay,
 	(uint16_t)goEEPROMview,
 #endif
+#ifdef useSWEET64profiler
+	(uint16_t)doSWEET64profile,
+#endif
+#ifdef useSWEET64disassembler
+	(uint16_t)doSWEET64disassemble,
+#endif
+#ifdef useFillUpHistory
+	(uint16_t)doFillUpDump,
+#endif
+#ifdef useLoopPhaseTiming
+	(uint16_t)doLoopPhaseDump,
+#ifdef useSWEET64profiler
+	(uint16_t)doCPUmonDump,
+#endif
+#endif
 };
 
 // Button Press variable section
@@ -2721,6 +3149,9 @@ const uint8_t bpListMain[] PROGMEM = {
 #endif
 #ifdef useEEPROMviewer
 	btnShortPressRCL, idxGoEEPROMview,
+#endif
+#ifdef useFillUpHistory
+	btnLongPressRCL, idxDoFillUpDump,
 #endif
 	buttonsUp, idxNoSupport,
 };
@@ -2763,9 +3194,23 @@ const uint8_t bpListCPUmonitor[] PROGMEM = {
 #ifdef useBenchMark
 	btnLongPressRCL, idxDoBenchMark,
 #endif
-	buttonsUp, idxDoNothing,
-};
-
+#ifdef useLoopPhaseTiming
+#ifdef useSWEET64profiler
+	btnLongPressRL, idxDoCPUmonDump, // phase page sends loop phases, any other page sends the profile
+#else
+	btnLongPressRL, idxDoLoopPhaseDump,
+#endif
+#else
+#ifdef useSWEET64profiler
+	btnLongPressRL, idxDoSWEET64profile,
+#endif
+#endif
+#ifdef useSWEET64disassembler
+	btnShortPressRCL, idxDoSWEET64disassemble,
+#endif
+	buttonsUp, idxDoNothing,
+};
+
 #endif
 #ifdef useBigNumberDisplay
 const uint8_t bpListBigNum[] PROGMEM = {
@@ -2852,6 +3297,27 @@ const uint8_t bpListClockEdit[] PROGMEM = {
 };
 #endif
 
+#ifdef useCoastDownCalculator
+const uint8_t bpListCoastDown[] PROGMEM = {
+	btnShortPressRL, idxDoGoSettingsEdit,
+	btnShortPressC, idxDoNextBright,
+	btnLongPressRC, idxDoTripResetCurrent,
+	btnLongPressCL, idxDoTripResetTank,
+	btnLongPressR, idxDoLongGoRight,
+	btnLongPressL, idxDoLongGoLeft,
+#ifdef useCPUreading
+	btnLongPressC, idxDoShowCPU,
+#endif
+#ifdef useSavedTrips
+	btnShortPressRC, idxDoGoTripCurrent,
+	btnShortPressCL, idxDoGoTripTank,
+#endif
+	btnLongPressRCL, idxDoCoastDownAccept,
+	btnLongPressRL, idxDoCoastDownReset,
+	buttonsUp, idxDoNothing,
+};
+#endif
+
 #ifdef useSavedTrips
 const uint8_t bpListTripSave[] PROGMEM = {
 	btnShortPressRL, idxDoReturnToMain,
@@ -2920,6 +3386,11 @@ const uint8_t bpIdxClockEdit =	bpIdxTime + 1;
 #undef nextAllowedValue
 #define nextAllowedValue bpIdxClockEdit
 #endif
+#ifdef useCoastDownCalculator
+const uint8_t bpIdxCoastDown =	nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue bpIdxCoastDown
+#endif
 #ifdef useSavedTrips
 const uint8_t bpIdxTripSave =	nextAllowedValue + 1;
 const uint8_t bpIdxTripView =	bpIdxTripSave + 1;
@@ -2958,6 +3429,9 @@ const uint8_t * const buttonPressAdrList[(unsigned int)(bpIdxSize)] PROGMEM = {
 	bpListTime,
 	bpListClockEdit,
 #endif
+#ifdef useCoastDownCalculator
+	bpListCoastDown,
+#endif
 #ifdef useSavedTrips
 	bpListTripSave,
 	bpListTripView,
@@ -2994,8 +3468,28 @@ const uint8_t mainScreenSize = 1
 #ifdef useClock
 	+ 1
 #endif
+#ifdef useCoastDownCalculator
+	+ 1
+#endif
+;
+
+#ifdef useCPUreading
+const uint8_t CPUmonStackPage = 1
+#ifdef useCPUloadPage
+	+ 1
+#endif
 ;
 
+const uint8_t CPUmonPageCount = CPUmonStackPage
+#ifdef useStackWatch
+	+ 1
+#endif
+#ifdef useLoopPhaseTiming
+	+ 1
+#endif
+;
+
+#endif
 const uint8_t screenSize = mainScreenSize + 2
 #ifdef useClock
 	+ 1
@@ -3049,6 +3543,11 @@ const uint8_t systemTimeDisplayScreenIdx =	nextAllowedValue + 1;
 #undef nextAllowedValue
 #define nextAllowedValue systemTimeDisplayScreenIdx
 #endif
+#ifdef useCoastDownCalculator
+const uint8_t coastDownScreenIdx =		nextAllowedValue + 1;
+#undef nextAllowedValue
+#define nextAllowedValue coastDownScreenIdx
+#endif
 const uint8_t settingScreenIdx =		nextAllowedValue + 1;
 const uint8_t paramScreenIdx =			settingScreenIdx + 1;
 #undef nextAllowedValue
@@ -3083,7 +3582,7 @@ const uint8_t screenParameters[(unsigned int)(screenSize)][6] PROGMEM = {
 		idxDoCursorUpdateBigFEscreen, bpIdxBigNum },
 #endif
 #ifdef useCPUreading
-	{ mainScreenIdx, mainScreenSize, 1, idxDoDisplaySystemInfo,
+	{ mainScreenIdx, mainScreenSize, CPUmonPageCount, idxDoDisplaySystemInfo,
 		idxDoNothing, bpIdxCPUmonitor },
 #endif
 #ifdef useBarFuelEconVsTime
@@ -3105,6 +3604,10 @@ const uint8_t screenParameters[(unsigned int)(screenSize)][6] PROGMEM = {
 #ifdef useClock
 	{ mainScreenIdx, mainScreenSize, 1, idxDoDisplaySystemTime,
 		idxDoCursorUpdateSystemTimeScreen, bpIdxTime },
+#endif
+#ifdef useCoastDownCalculator
+	{ mainScreenIdx, mainScreenSize, 1, idxDoCoastDownDisplay,
+		idxDoCursorUpdateCoastDown, bpIdxCoastDown },
 #endif
 	{ settingScreenIdx, 1, settingsSize, idxDoSettingEditDisplay,
 		idxDoCursorUpdateSetting, bpIdxSetting },
@@ -3156,6 +3659,9 @@ uint8_t screenCursor[(unsigned int)(screenSize)] = {
 	0,
 	0,
 #endif
+#ifdef useCoastDownCalculator
+	0,
+#endif
 #ifdef useSavedTrips
 	0,
 	0,
@@ -3168,13 +3674,6 @@ uint8_t screenCursor[(unsigned int)(screenSize)] = {
 #endif
 };
 
-#ifdef useCoastDownCalculator
-long long matrix_x[3][3];
-long long matrix_r[3][3];
-long long matrix_y[3];
-long long matrix_z[3];
-#endif
-
 #ifdef useBarFuelEconVsTime
 const char barFEvTfuncNames[] PROGMEM = {
 	"DiffFE / Time\0"
@@ -3199,7 +3698,15 @@ const char barFEvSfuncNames[] PROGMEM = {
 #endif
 
 #ifdef useBuffering
-const uint8_t bufferSize = 32;
+#ifdef useLegacyLCDbuffered
+const uint8_t lcdBufferSize = 32;
+#endif
+#ifdef useBufferedSerialPort
+const uint8_t serialBufferSize = 64; // must hold at least one whole data logging line or telemetry frame
+#endif
+#ifdef useSerialConfig
+const uint8_t serialRxBufferSize = 64; // must hold at least one whole incoming configuration frame
+#endif
 const uint8_t bufferIsFull = 	0b10000000;
 const uint8_t bufferIsEmpty = 	0b01000000;
 
@@ -3212,11 +3719,18 @@ class Buffer // Buffer prototype
 {
 
 public:
-	volatile uint8_t storage[(unsigned int)(bufferSize)];
+	volatile uint8_t * storage;
+	uint8_t bufferSize;
 	volatile uint8_t bufferStart;
 	volatile uint8_t bufferEnd;
 	volatile uint8_t bufferStatus;
 
+	unsigned int overrunCount; // number of times push() had to wait for room
+	unsigned int dropCount; // number of times the caller gave up, rather than wait for room
+#ifdef useStackWatch
+	uint8_t highWater; // most bytes ever waiting in the buffer
+#endif
+
 	pFunc onEmpty;
 	pFunc onNoLongerEmpty;
 	pFunc onNoLongerFull;
@@ -3224,9 +3738,10 @@ public:
 
 	qFunc process;
 
-	void init(void);
+	void init(volatile uint8_t * s, uint8_t l);
 	void push(uint8_t value);
 	void pull(void);
+	uint8_t room(void);
 	uint8_t updatePointer(volatile uint8_t * pointer, uint8_t clearFlag, uint8_t setFlag);
 };
 
@@ -3243,7 +3758,7 @@ public:
 	void add64s(uint8_t calcIdx, unsigned long v);
 	void add32(uint8_t calcIdx, unsigned long v);
 #ifdef useWindowFilter
-	void subtract(Trip t);
+	void sub64s(uint8_t calcIdx, unsigned long v);
 	void sub32(uint8_t calcIdx, unsigned long v);
 #endif
 #ifdef useSavedTrips
@@ -3273,14 +3788,21 @@ namespace LCD // LCD prototype
 #ifdef useLegacyLCD
 volatile uint8_t lcdDelayCount;
 #ifdef useLegacyLCDbuffered
+volatile uint8_t lcdBufferStorage[(unsigned int)(lcdBufferSize)];
 Buffer lcdBuffer;
 #endif
 #endif
 
 #ifdef useBufferedSerialPort
+volatile uint8_t serialBufferStorage[(unsigned int)(serialBufferSize)];
 Buffer serialBuffer;
 #endif
 
+#ifdef useSerialConfig
+volatile uint8_t serialRxBufferStorage[(unsigned int)(serialRxBufferSize)];
+Buffer serialRxBuffer;
+#endif
+
 #ifdef useChryslerMAPCorrection
 const uint8_t pressureSize = 5;
 const uint8_t MAPpressureIdx = 0;
@@ -3293,7 +3815,21 @@ unsigned long pressure[(unsigned int)(pressureSize)] = { 0, 0, 0, 0, 0 };
 unsigned long analogFloor[2];
 unsigned long analogSlope[2];
 unsigned long analogOffset[2];
-volatile unsigned int sampleCount = 0;
+unsigned long sampleLastCycle;
+volatile unsigned int injCorrection; // copy of pressure[injCorrectionIdx], for the injector interrupt
+#endif
+
+#ifdef useIsqrt
+/* 4096 * sqrt(x / 4096) at x = 16384, 17408, ... 65536, for iSqrtSeed() */
+const unsigned int iSqrtTable[] PROGMEM = {
+	8192, 8444, 8689, 8927, 9159, 9385, 9606,
+	9822, 10033, 10240, 10443, 10642, 10837, 11029,
+	11217, 11403, 11585, 11765, 11942, 12116, 12288,
+	12457, 12625, 12790, 12953, 13114, 13273, 13430,
+	13585, 13738, 13890, 14040, 14189, 14336, 14482,
+	14626, 14768, 14910, 15050, 15188, 15326, 15462,
+	15597, 15731, 15864, 15995, 16126, 16255, 16384,
+};
 #endif
 
 #ifdef useAnalogRead
@@ -3363,12 +3899,132 @@ volatile uint8_t lastPINCstate;
 extern int __bss_end;
 extern int *__brkval;
 
+#ifdef useStackWatch
+const uint8_t stackCanary = 0xC5;
+
+unsigned int stackLowWater; // fewest untouched bytes ever seen between the end of .bss and the stack
+uint8_t stackScanDue;
+uint8_t s64maxDepth; // deepest SWEET64 call nesting seen
+#endif
+
+#ifdef useLoopPhaseTiming
+#undef nextAllowedValue
+#define nextAllowedValue 0
+#ifdef useBarFuelEconVsTime
+const uint8_t phaseBarFEvTidx =		nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue phaseBarFEvTidx + 1
+#endif
+const uint8_t phaseTripIdx =		nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue phaseTripIdx + 1
+#ifdef useBarFuelEconVsSpeed
+const uint8_t phaseBarFEvSidx =		nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue phaseBarFEvSidx + 1
+#endif
+#ifdef useCoastDownCalculator
+const uint8_t phaseCoastDownIdx =	nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue phaseCoastDownIdx + 1
+#endif
+#if defined(useBinaryTelemetry) || defined(useSerialPortDataLogging)
+const uint8_t phaseDataLogIdx =		nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue phaseDataLogIdx + 1
+#endif
+#ifdef useWindowFilter
+const uint8_t phaseWindowFilterIdx =	nextAllowedValue;
+#undef nextAllowedValue
+#define nextAllowedValue phaseWindowFilterIdx + 1
+#endif
+const uint8_t phaseDisplayIdx =		nextAllowedValue;
+const uint8_t phaseButtonIdx =		phaseDisplayIdx + 1;
+const uint8_t phaseCount =		phaseButtonIdx + 1;
+#undef nextAllowedValue
+
+const char phaseNames[] PROGMEM = {
+#ifdef useBarFuelEconVsTime
+	"BrT\0"
+#endif
+	"Trp\0"
+#ifdef useBarFuelEconVsSpeed
+	"BrS\0"
+#endif
+#ifdef useCoastDownCalculator
+	"Cdn\0"
+#endif
+#if defined(useBinaryTelemetry) || defined(useSerialPortDataLogging)
+	"Log\0"
+#endif
+#ifdef useWindowFilter
+	"Flt\0"
+#endif
+	"Dsp\0"
+	"Btn\0"
+};
+
+const uint8_t phaseWindowLoops = 8 * loopsPerSecond; // min/avg/max cover this many loops
+
+/* phase lengths are in timer2 ticks, and saturate at 65535 */
+unsigned long phaseMark; // cycles2() at the end of the previous phase
+uint8_t phaseLoopCount;
+uint8_t phaseShowCount;
+uint8_t phaseRuns[(unsigned int)(phaseCount)]; // for the window in progress
+unsigned int phaseMin[(unsigned int)(phaseCount)];
+unsigned int phaseMax[(unsigned int)(phaseCount)];
+unsigned long phaseSum[(unsigned int)(phaseCount)];
+unsigned int phaseStats[(unsigned int)(phaseCount)][3]; // min, avg, max for the last complete window
+#endif
+
 Trip tripArray[tripSlotCount]; // main objects we will be working with
 
 #ifdef useBarFuelEconVsTime
 unsigned long barFEvsTimeData[bgDataSize];
 #endif
 
+#ifdef useBarFuelEconVsSpeed
+/*
+ * rather than a whole trip apiece, each speed bin only keeps what its bar
+ * graphs use - VSS pulses, VSS cycles / 256, and injector open cycles / 16.
+ * at 16 MHz, that is about 50 days of motion time or 76 hours of injector
+ * open time per bin before it saturates
+ */
+const uint8_t FEvSpdCycleShift = 8;
+const uint8_t FEvSpdFuelShift = 4;
+
+unsigned long FEvSpdPulses[bgDataSize];
+unsigned long FEvSpdCycles[bgDataSize];
+unsigned long FEvSpdFuel[bgDataSize];
+unsigned long FEvSpdEdge[bgDataSize + 1]; // speed*1000 bin edges, set up by initBarFEvS()
+uint8_t FEvSpdBinIdx = 255;
+
+/*
+ * log-spaced bin edges, in 1024ths of the whole bargraph speed span - each
+ * bin is 1/8 wider than the one below it
+ */
+const uint16_t FEvSpdLogEdges[] PROGMEM = {
+	0,
+	26,
+	56,
+	89,
+	127,
+	169,
+	217,
+	270,
+	330,
+	398,
+	474,
+	560,
+	656,
+	765,
+	887,
+	1024,
+};
+
+typedef uint8_t FEvSpdLogEdgesCheck[(sizeof(FEvSpdLogEdges) / sizeof(uint16_t) == bgDataSize + 1) ? 1 : -1];
+#endif
+
 #ifdef useClock
 unsigned long outputCycles[2];
 #endif
@@ -3376,6 +4032,10 @@ unsigned long outputCycles[2];
 unsigned long paramMaxValue;
 unsigned long timerLoopStart;
 unsigned long timerLoopLength;
+#ifdef useBackgroundTasks
+unsigned long backgroundCycles; // time spent on background tasks so far this loop
+unsigned long timerBackgroundLength; // time spent on background tasks during the last loop
+#endif
 
 #ifdef useBarFuelEconVsTime
 unsigned int bFEvTperiod;
@@ -3405,9 +4065,47 @@ uint8_t cgramMode = 0;
 volatile uint8_t thisAnalogKeyPressed = buttonsUp;
 #endif
 
-char mBuff1[17]; // used by format(), doFormat()
-char mBuff2[17]; // used by editParm(), bar graph routines
-char pBuff[12]; // used by editParm(), editClock()
+/*
+ * the text buffers shared by the formatting, bar graph, and parameter editing
+ * routines are slices of one arena, each sized for its largest user
+ */
+const uint8_t formatBuffSize = 11; // format64() writes at most 5 digit pairs, plus a terminating zero
+const uint8_t mBuff1Size = formatBuffSize;
+#ifdef useBarGraph
+const uint8_t mBuff2Size = ((bgDataSize > formatBuffSize) ? bgDataSize : formatBuffSize); // one byte per bar graph bar
+#else
+const uint8_t mBuff2Size = formatBuffSize;
+#endif
+const uint8_t pBuffSize = formatBuffSize;
+
+#ifdef useScratchGuard
+const uint8_t scratchGuardSize = 1;
+const uint8_t scratchGuardValue = 0xA5;
+#else
+const uint8_t scratchGuardSize = 0;
+#endif
+
+const uint8_t mBuff1Offset = 0;
+const uint8_t mBuff2Offset = mBuff1Offset + mBuff1Size + scratchGuardSize;
+const uint8_t pBuffOffset = mBuff2Offset + mBuff2Size + scratchGuardSize;
+const uint8_t scratchArenaSize = pBuffOffset + pBuffSize + scratchGuardSize;
+
+char scratchArena[(unsigned int)(scratchArenaSize)];
+char * const mBuff1 = scratchArena + mBuff1Offset; // used by format(), doFormat()
+char * const mBuff2 = scratchArena + mBuff2Offset; // used by editParm(), bar graph routines
+char * const pBuff = scratchArena + pBuffOffset; // used by editParm(), editClock()
+
+#ifdef useScratchGuard
+const uint8_t scratchGuardList[] PROGMEM = {
+	mBuff2Offset - 1,
+	pBuffOffset - 1,
+	scratchArenaSize - 1,
+};
+
+const uint8_t sGLsize = (sizeof(scratchGuardList) / sizeof(uint8_t));
+
+uint8_t scratchOverrunCount;
+#endif
 
 
 /******************************************************************************/
@@ -3536,11 +4234,6 @@ ISR( TIMER2_OVF_vect ) // system timer interrupt handler
 
 	}
 
-#ifdef useChryslerMAPCorrection
-	if (sampleCount) sampleCount--;
-	else readMAP();
-#endif
-
 	if (timerStatus & tsLoopExec) // if a loop execution is in progress
 	{
 
@@ -3693,8 +4386,7 @@ ISR( INT1_vect ) // injector closing event handler
 		{
 
 #ifdef useChryslerMAPCorrection
-			readMAP(); // calculate correction factor for differential pressure across the fuel injector
-			injOpenCycleLength *= pressure[(unsigned int)(injCorrectionIdx)]; // multiply by correction factor
+			injOpenCycleLength *= injCorrection; // multiply by correction factor for differential pressure across the fuel injector
 			injOpenCycleLength >>= 12; // divide by denominator factor
 #endif
 
@@ -4023,6 +4715,46 @@ ISR( USART_UDRE_vect )
 
 	serialBuffer.pull(); // send a buffered character to the serial hardware
 
+}
+#endif
+#ifdef useSerialConfig
+#ifdef ArduinoMega2560
+ISR( USART0_RX_vect )
+#else
+ISR( USART_RX_vect )
+#endif
+{
+
+	uint8_t c = UDR0; // reading the byte clears the interrupt
+
+	/* there's no waiting for room in here - the host resends on a missing reply */
+	if (serialRxBuffer.bufferStatus & bufferIsFull)
+	{
+		if (serialRxBuffer.dropCount < 9999) serialRxBuffer.dropCount++;
+	}
+	else serialRxBuffer.push(c);
+
+}
+#endif
+#ifdef useEEPROMwriteQueue
+ISR( EE_READY_vect )
+{
+
+	if (eeQueueCount) // if there is a byte waiting to be written out
+	{
+
+		EEAR = eeQueueAddr[(unsigned int)(eeQueueEnd)];
+		EEDR = eeQueueData[(unsigned int)(eeQueueEnd)];
+		EECR |= (1 << EEMPE); // interrupts are already off in here, so the 4 cycle write window can't be missed
+		EECR |= (1 << EEPE);
+
+		eeQueueEnd++;
+		if (eeQueueEnd == eeQueueSize) eeQueueEnd = 0;
+		eeQueueCount--;
+
+	}
+	else EECR &= ~(1 << EERIE); // queue is empty, so shut off the EEPROM ready interrupt
+
 }
 #endif
 /******************************************************************************/
@@ -4031,20 +4763,34 @@ ISR( USART_UDRE_vect )
 
 
 #ifdef useChryslerMAPCorrection
-void readMAP(void)
+/*
+ * background task - recalculate the injector correction factor samplesPerSecond times a second, so the injector
+ * interrupt only has to multiply by it. while the main loop is busy, the last factor is held. returns 1 if a sample
+ * was due
+ */
+uint8_t readMAP(void)
 {
 
 	static unsigned int sample[2] = { 0, 0 };
+	unsigned int reading[2];
 	unsigned long wp;
-	uint8_t analogToggle = 1;
+	uint8_t oldSREG;
 
-	sampleCount = sampleTickLength - 1; // reset sample timer counter
+	wp = cycles2();
+	if (findCycleLength(sampleLastCycle, wp) < samplePeriod) return 0;
+	sampleLastCycle = wp;
+
+	oldSREG = SREG; // save interrupt flag status
+	cli(); // perform atomic transfer of ADC readings, so the ADC interrupt cannot change one halfway through
+	reading[0] = analogValue[1];
+	reading[1] = analogValue[0];
+	SREG = oldSREG; // restore interrupt flag status
 
 	for (uint8_t x = 0; x < 2; x++)
 	{
 
 		// perform 2nd stage IIR filter operation
-		sample[(unsigned int)(x)] = sample[(unsigned int)(x)] + 7 * analogValue[(unsigned int)(analogToggle)]; // first order IIR filter - filt = filt + 7/8 * (reading - filt)
+		sample[(unsigned int)(x)] = sample[(unsigned int)(x)] + 7 * reading[(unsigned int)(x)]; // first order IIR filter - filt = filt + 7/8 * (reading - filt)
 		sample[(unsigned int)(x)] >>= 3;
 
 		// calculate MAP and barometric pressures from readings
@@ -4055,8 +4801,6 @@ void readMAP(void)
 		wp >>= 10;
 		pressure[(unsigned int)(MAPpressureIdx + x)] = wp + analogOffset[(unsigned int)(x)];
 
-		analogToggle ^= 1;
-
 	}
 
 	// calculate differential pressure seen across the fuel injector
@@ -4066,36 +4810,83 @@ void readMAP(void)
 	// to get fuel pressure ratio, multiply differential pressure by denominator factor (1 << 12), then divide by fuel system pressure
 	wp <<= 12;
 	wp /= pressure[(unsigned int)(fuelPressureIdx)];
+	if (wp > 65535ul) wp = 65535ul;
 
 	// calculate square root of fuel pressure ratio
 	pressure[(unsigned int)(injCorrectionIdx)] = (unsigned long)iSqrt((unsigned int)wp);
 
+	oldSREG = SREG; // save interrupt flag status
+	cli(); // publish the new correction factor in one piece
+	injCorrection = (unsigned int)(pressure[(unsigned int)(injCorrectionIdx)]);
+	SREG = oldSREG; // restore interrupt flag status
+
+	return 1;
+
 }
 #endif
 
 #ifdef useIsqrt
+/*
+ * first guess at 4096 * sqrt(n / 4096), by table lookup. n is scaled up by powers of 4 into the range of the table,
+ * and the result scaled back down by the matching powers of 2. linear interpolation between table entries keeps the
+ * guess within 2 of the exact square root
+ */
+unsigned int iSqrtSeed(unsigned int n)
+{
+
+	unsigned int t;
+	unsigned int d;
+	uint8_t s = 0;
+	uint8_t i;
+
+	if (n == 0) return 0;
+
+	while (n < 16384)
+	{
+
+		n <<= 2;
+		s++;
+
+	}
+
+	i = (uint8_t)(n >> 10) - 16;
+	t = pgm_read_word(&iSqrtTable[(unsigned int)(i)]);
+	d = pgm_read_word(&iSqrtTable[(unsigned int)(i + 1)]) - t;
+	t += (d * ((n & 1023) >> 2) + 128) >> 8; // neighbouring entries are never more than 255 apart
+
+	return (t >> s);
+
+}
+
+/*
+ * 4096 * sqrt(n / 4096), rounded to the nearest whole number. t is the nearest root of n * 4096 when
+ * t * t - t < n * 4096 <= t * t + t, and neighbouring squares are 2 * t + 1 apart, so the guess from iSqrtSeed() is
+ * put right with one multiply, and at most two additions or subtractions
+ */
 unsigned int iSqrt(unsigned int n)
 {
 
-	unsigned long w = 4096; // square factor guess
-	unsigned int t = 4096; // proposed square root
-	int d; // difference between guess and proposed
-	int od = 0;
+	unsigned int t;
+	long r;
+
+	if (n == 0) return 0;
 
-	for (uint8_t x = 0; x < 5; x++)
+	t = iSqrtSeed(n);
+	r = (long)((unsigned long)(n) << 12) - (long)((unsigned long)(t) * (unsigned long)(t)); // n * 4096 - t * t
+
+	while (r > (long)(t))
 	{
 
-		od = d;
-		d = n - (unsigned int)w;
-		d >>= 1;
-		t += d;
+		r -= 2 * (long)(t) + 1;
+		t++;
 
-		od += d;
+	}
 
-		if ((d == 0) || (od == 0)) break;
+	while (r <= -(long)(t))
+	{
 
-		w = (unsigned long)t * (unsigned long)t;
-		w >>= 12;
+		t--;
+		r += 2 * (long)(t) + 1;
 
 	}
 
@@ -4457,21 +5248,7 @@ const uint8_t tripIDchars[tripSlotCount] PROGMEM = {
 	'p',
 #endif
 #ifdef useBarFuelEconVsSpeed
-	'0',
-	'1',
-	'2',
-	'3',
-	'4',
-	'5',
-	'6',
-	'7',
-	'8',
-	'9',
-	'A',
-	'B',
-	'C',	// *facepalm*
-	'D',
-	'E',
+	's',	// replaced by the speed bin number when displayed
 #endif
 #ifdef useCoastDownCalculator
 	'T',
@@ -4714,6 +5491,11 @@ void displayBarGraphLine(uint8_t lineNum, uint8_t tripIdx, uint8_t tripCalcIdx)
 	if (tripIdx < 255)
 	{
 
+#ifdef useBarFuelEconVsSpeed
+		if (tripIdx == FEvsSpeedIdx)
+			charOut(FEvSpdBinIdx + ((FEvSpdBinIdx < 10) ? '0' : 'A' - 10));
+		else
+#endif
 		charOut(pgm_read_byte(&tripIDchars[(unsigned int)(tripIdx)]));
 		charOut(pgm_read_byte(&bgLabels[(unsigned int)(tripCalcIdx)]));
 
@@ -4870,12 +5652,12 @@ void LCD::init(void)
 #endif
 
 	setBright(brightnessIdx);
-	setContrast(eepromReadVal((unsigned int)(pContrastIdx)));
+	setContrast(paramRead(Contrast));
 
 	cgramMode = 0; // clear CGRAM font status
 
 #ifdef useLegacyLCDbuffered
-	lcdBuffer.init();
+	lcdBuffer.init(lcdBufferStorage, lcdBufferSize);
 	lcdBuffer.process = LCD::outputNybble;
 	lcdBuffer.onNoLongerEmpty = LCD::startOutput;
 #endif
@@ -5036,9 +5818,17 @@ void LCD::outputNybble(uint8_t LCDchar)
 #endif
 #ifdef useBuffering
 
-void Buffer::init(void)
+void Buffer::init(volatile uint8_t * s, uint8_t l)
 {
 
+	storage = s;
+	bufferSize = l;
+	overrunCount = 0;
+	dropCount = 0;
+#ifdef useStackWatch
+	highWater = 0;
+#endif
+
 	bufferStart = 0;
 	bufferEnd = 0;
 	bufferStatus = bufferIsEmpty;
@@ -5067,6 +5857,8 @@ uint8_t Buffer::updatePointer(volatile uint8_t * pointer, uint8_t clearFlag, uin
 
 void Buffer::push(uint8_t value)
 {
+	if ((bufferStatus & bufferIsFull) && (overrunCount < 9999)) overrunCount++;
+
 	while (bufferStatus & bufferIsFull);
 
 	uint8_t oldSREG = SREG; // save interrupt flag status
@@ -5078,6 +5870,16 @@ void Buffer::push(uint8_t value)
 		if (bufferStatus & bufferIsEmpty)
 			onNoLongerEmpty();
 		storage[(unsigned int)(updatePointer(&bufferStart, bufferIsEmpty, bufferIsFull))] = value; // save a buffered character
+#ifdef useStackWatch
+
+		uint8_t i = bufferSize;
+		if (!(bufferStatus & bufferIsFull))
+		{
+			i = bufferStart - bufferEnd;
+			if (bufferStart < bufferEnd) i += bufferSize;
+		}
+		if (i > highWater) highWater = i;
+#endif
 	}
 
 	SREG = oldSREG; // restore interrupt flag status
@@ -5097,6 +5899,26 @@ void Buffer::pull(void)
 
 	SREG = oldSREG; // restore interrupt flag status
 }
+
+uint8_t Buffer::room(void)
+{
+	int i;
+
+	uint8_t oldSREG = SREG; // save interrupt flag status
+	cli(); // disable interrupts
+
+	if (bufferStatus & bufferIsEmpty) i = bufferSize;
+	else if (bufferStatus & bufferIsFull) i = 0;
+	else
+	{
+		i = (int)(bufferEnd) - (int)(bufferStart);
+		if (i < 0) i += bufferSize;
+	}
+
+	SREG = oldSREG; // restore interrupt flag status
+
+	return (uint8_t)(i);
+}
 #endif
 
 void Trip::reset(void)
@@ -5136,18 +5958,11 @@ void Trip::add32(uint8_t calcIdx, unsigned long v)
 }
 
 #ifdef useWindowFilter
-void Trip::subtract(Trip t)
+void Trip::sub64s(uint8_t calcIdx, unsigned long v)
 {
-	sub32(rvVSSpulseIdx, t.collectedData[(unsigned int)(rvVSSpulseIdx)]);
-	sub32(rvInjPulseIdx, t.collectedData[(unsigned int)(rvInjPulseIdx)]);
-
-	for (uint8_t x = 2; x < rvLength; x += 2)
-	{
-		if (collectedData[(unsigned int)(x)] < t.collectedData[(unsigned int)(x)])
-			collectedData[(unsigned int)(x + 1)]--;
-		sub32(x, t.collectedData[(unsigned int)(x)]);
-		sub32(x + 1, t.collectedData[(unsigned int)(x + 1)]);
-	}
+	if (collectedData[(unsigned int)(calcIdx)] < v)
+		collectedData[(unsigned int)(calcIdx + 1)]--; // handle any possible borrow
+	sub32(calcIdx, v); // subtract from accumulator
 }
 
 void Trip::sub32(uint8_t calcIdx, unsigned long v)
@@ -5169,6 +5984,10 @@ uint8_t Trip::load(uint8_t tripPos)
 
 	reset();
 
+#ifdef useTripJournal
+	if (journalSlotRecord[(unsigned int)(tripPos)] == journalNoRecord) b = 0;
+
+#endif
 	if (b == guinosig)
 	{
 		for (uint8_t x = 0; x < tripListLength; x++)
@@ -5184,6 +6003,10 @@ uint8_t Trip::save(uint8_t tripPos)
 {
 	unsigned int t = getBaseTripPointer(tripPos);
 
+#ifdef useTripJournal
+	journalOpen(tripPos); // trip slot now points to a fresh journal record
+#endif
+
 #ifndef useClock
 	unsigned long outputCycles[2];
 
@@ -5201,32 +6024,171 @@ uint8_t Trip::save(uint8_t tripPos)
 		eepromWriteVal(t++, collectedData[(unsigned int)(x)]);
 
 	eepromWriteVal(t++, guinosig);
+#ifdef useTripJournal
+	journalSeal(tripPos);
+#endif
 
 	return 1;
 }
-#endif
+#ifdef useTripJournal
 
-unsigned long tmp1[2] = { 0, 0 };
-unsigned long tmp2[2] = { 0, 0 };
-unsigned long tmp3[2] = { 0, 0 };
-unsigned long tmp4[2] = { 0, 0 };
-unsigned long tmp5[2] = { 0, 0 };
+/*
+ * saved trips live in a circular journal of records spread across all
+ * of the free EEPROM. each record is a header followed by a trip save
+ * laid out exactly like a fixed trip slot used to be:
+ *
+ *   0-3 : sequence number, big endian
+ *   4   : trip slot
+ *   5-6 : CRC of everything else in the record
+ *   7-  : timestamp, trip data, signature
+ *
+ * a save never overwrites the record holding the current copy of any
+ * trip slot. it writes the next free record instead, and writes the
+ * header last. if power is lost partway thru, that record fails its CRC
+ * check and the previous copy of that trip slot is still found at boot.
+ */
+unsigned int journalGetAddress(uint8_t r)
+{
+	return eeAdrSavedTripsStart + (unsigned int)(r) * (unsigned int)(journalRecordSize);
+}
 
-union union_64 * tempPtr[5] = {
-	(union union_64 *)&tmp1,
-	(union union_64 *)&tmp2,
-	(union union_64 *)&tmp3,
-	(union union_64 *)&tmp4,
-	(union union_64 *)&tmp5,
-};
+uint16_t journalCRC(uint8_t r)
+{
+	unsigned int t = journalGetAddress(r);
+	uint16_t crc = 0xFFFF;
 
-union union_64 * tu1 = tempPtr[0];
-union union_64 * tu2 = tempPtr[1];
+	for (uint8_t x = 0; x < journalRecordSize; x++)
+	{
+		if ((x == 5) || (x == 6)) continue; // skip over the stored CRC
+		crc = crc16update(crc, eepromReadByte(t + x));
+	}
 
-const uint8_t * const S64programList[] PROGMEM = {
-	prgmFuelUsed,
-	prgmFuelRate,
-	prgmEngineRunTime,
+	return crc;
+}
+
+void journalInit(void)
+{
+	unsigned int t;
+	unsigned long v;
+	unsigned long w;
+	uint8_t b;
+	uint8_t r;
+	uint8_t newest = journalNoRecord;
+
+	for (uint8_t x = 0; x < eeAdrSavedTripsTemp3; x++)
+		journalSlotRecord[(unsigned int)(x)] = journalNoRecord;
+
+	journalSequence = 0;
+
+	for (r = 0; r < eeAdrSavedTripsTemp2; r++)
+	{
+		t = journalGetAddress(r);
+
+		v = 0;
+		for (uint8_t x = 0; x < 4; x++)
+			v = (v << 8) + (unsigned long)(eepromReadByte(t++));
+		b = eepromReadByte(t++);
+
+		if (b >= eeAdrSavedTripsTemp3) continue; // erased, or left over from a larger layout
+
+		w = (unsigned long)(eepromReadByte(t++)) << 8;
+		w += (unsigned long)(eepromReadByte(t));
+		if ((uint16_t)(w) != journalCRC(r)) continue; // torn or stale record
+
+		/* keep only the newest record of each trip slot */
+		if ((journalSlotRecord[(unsigned int)(b)] == journalNoRecord) ||
+		    (v > journalSequence))
+		{
+			journalSlotRecord[(unsigned int)(b)] = r;
+		}
+		else
+		{
+			t = journalGetAddress(journalSlotRecord[(unsigned int)(b)]);
+			w = 0;
+			for (uint8_t x = 0; x < 4; x++)
+				w = (w << 8) + (unsigned long)(eepromReadByte(t++));
+			if (v > w) journalSlotRecord[(unsigned int)(b)] = r;
+		}
+
+		if ((newest == journalNoRecord) || (v >= journalSequence))
+		{
+			newest = r;
+			journalSequence = v + 1;
+		}
+	}
+
+	journalHead = ((newest == journalNoRecord) ? 0 : newest + 1);
+	if (journalHead == eeAdrSavedTripsTemp2) journalHead = 0;
+}
+
+void journalOpen(uint8_t tripPos)
+{
+	uint8_t r = journalHead;
+	uint8_t x;
+
+	/* find the next record that does not hold the current copy of any trip slot */
+	do
+	{
+		for (x = 0; x < eeAdrSavedTripsTemp3; x++)
+			if (journalSlotRecord[(unsigned int)(x)] == r) break;
+
+		if (x == eeAdrSavedTripsTemp3) break;
+
+		r++;
+		if (r == eeAdrSavedTripsTemp2) r = 0;
+	}
+	while (true);
+
+	journalSlotRecord[(unsigned int)(tripPos)] = r;
+}
+
+void journalSeal(uint8_t tripPos)
+{
+	uint8_t r = journalSlotRecord[(unsigned int)(tripPos)];
+	unsigned int t = journalGetAddress(r);
+	unsigned long v = journalSequence;
+	uint16_t crc;
+	uint8_t x;
+
+	for (x = 0; x < 4; x++)
+	{
+		eepromWriteByte(t + 3 - x, (uint8_t)(v & 0xFF));
+		v >>= 8;
+	}
+	eepromWriteByte(t + 4, tripPos);
+
+	crc = journalCRC(r);
+	eepromWriteByte(t + 5, (uint8_t)(crc >> 8));
+	eepromWriteByte(t + 6, (uint8_t)(crc & 0xFF));
+
+	journalSequence++;
+	journalHead = r + 1;
+	if (journalHead == eeAdrSavedTripsTemp2) journalHead = 0;
+}
+#endif
+#endif
+
+unsigned long tmp1[2] = { 0, 0 };
+unsigned long tmp2[2] = { 0, 0 };
+unsigned long tmp3[2] = { 0, 0 };
+unsigned long tmp4[2] = { 0, 0 };
+unsigned long tmp5[2] = { 0, 0 };
+
+union union_64 * tempPtr[5] = {
+	(union union_64 *)&tmp1,
+	(union union_64 *)&tmp2,
+	(union union_64 *)&tmp3,
+	(union union_64 *)&tmp4,
+	(union union_64 *)&tmp5,
+};
+
+union union_64 * tu1 = tempPtr[0];
+union union_64 * tu2 = tempPtr[1];
+
+const uint8_t * const S64programList[] PROGMEM = {
+	prgmFuelUsed,
+	prgmFuelRate,
+	prgmEngineRunTime,
 	prgmTimeToEmpty,
 	prgmDistance,
 	prgmSpeed,
@@ -5278,16 +6240,40 @@ const uint8_t * const S64programList[] PROGMEM = {
 	prgmFormatToNumber,
 };
 
+const uint8_t S64programCount = (sizeof(S64programList) / sizeof(const uint8_t *));
+
+#ifdef useSWEET64profiler
+/* the per-program counts are kept with S64verifyList, further down, since they are sized by it */
+unsigned long s64profOpCount[(unsigned int)(DNUISinstrCount)];
+
+#endif
+
+/* fused multiply/divide instructions load register 1 the same way as these do, in the same order */
+const uint8_t S64fusedLoadList[] PROGMEM = {
+	instrLdByte,
+	instrLdTripVar,
+	instrLdConst,
+	instrLdEEPROM,
+};
+
 unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx)
 {
 	uint8_t spnt = 0;
 	uint8_t instr;
 	uint8_t b = 0;
 	uint8_t f;
+	uint8_t m;
 	const uint8_t * prgmStack[16];
 #ifdef useSWEET64trace
 	uint8_t tf = 0;
 #endif
+#ifdef useSWEET64profiler
+	uint8_t profSlot[16]; // profiled program at each call depth
+	unsigned int profStart[16]; // low 16 bits of cycles2() when that program started
+
+	profSlot[0] = S64profEnter(sched);
+	profStart[0] = (unsigned int)(cycles2());
+#endif
 
 	while (true)
 	{
@@ -5300,6 +6286,9 @@ unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx)
 
 #endif
 		instr = pgm_read_byte(sched++);
+#ifdef useSWEET64profiler
+		if ((instr & 0x3F) < DNUISinstrCount) s64profOpCount[(unsigned int)(instr & 0x3F)]++;
+#endif
 
 #ifdef useSWEET64trace
 		if (tf)
@@ -5346,6 +6335,15 @@ unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx)
 		if (tf) pushSerialCharacter(13);
 #endif
 		f = 0;
+		m = 0;
+
+		/* a fused instruction is a load into register 1, followed by a multiply or divide of register 2 by register 1 */
+		if ((instr >= instrMulByByte) && (instr <= instrDivByEEPROM))
+		{
+			m = ((instr < instrDivByByte) ? idxS64doMultiply : idxS64doDivide);
+			instr = pgm_read_byte(&S64fusedLoadList[(unsigned int)((instr - instrMulByByte) & 0x03)]);
+			tu2 = tempPtr[0];
+		}
 
 		if ((instr == instrLdNumer) || (instr == instrLdDenom)) b = pgm_read_byte(&convNumerIdx[(unsigned int)(tripIdx)]);
 		if (instr == instrLdDenom) b ^= 1;
@@ -5358,6 +6356,9 @@ unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx)
 
 		if (instr == instrDone)
 		{
+#ifdef useSWEET64profiler
+			S64profLeave(profSlot[(unsigned int)(spnt)], profStart[(unsigned int)(spnt)]);
+#endif
 			if (spnt--) sched = prgmStack[(unsigned int)(spnt)];
 			else break;
 		}
@@ -5385,10 +6386,25 @@ unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx)
 		else if (instr == instrCall)
 		{
 			prgmStack[(unsigned int)(spnt++)] = sched;
+#ifdef useStackWatch
+			if (spnt > s64maxDepth) s64maxDepth = spnt;
+#endif
 			if (spnt > 15) break;
 			else sched = (const uint8_t *)pgm_read_word(&S64programList[(unsigned int)(b)]);
+#ifdef useSWEET64profiler
+			profSlot[(unsigned int)(spnt)] = S64profCall(b);
+			profStart[(unsigned int)(spnt)] = (unsigned int)(cycles2());
+#endif
+		}
+		else if (instr == instrJump)
+		{
+			sched = (const uint8_t *)pgm_read_word(&S64programList[(unsigned int)(b)]);
+#ifdef useSWEET64profiler
+			S64profLeave(profSlot[(unsigned int)(spnt)], profStart[(unsigned int)(spnt)]); // jumped-to program takes over this call depth
+			profSlot[(unsigned int)(spnt)] = S64profCall(b);
+			profStart[(unsigned int)(spnt)] = (unsigned int)(cycles2());
+#endif
 		}
-		else if (instr == instrJump) sched = (const uint8_t *)pgm_read_word(&S64programList[(unsigned int)(b)]);
 		else if (instr == instrSwap) swap64(tu1, tu2);
 		else if (instr == instrSubYfromX) add64(tu1, tu2, 1);
 		else if (instr == instrAddYtoX) add64(tu1, tu2, 0);
@@ -5410,6 +6426,25 @@ unsigned long SWEET64(const uint8_t * sched, uint8_t tripIdx)
 #endif
 		else break; // just found an unsupported opcode
 
+		if (m)
+		{
+#ifdef useSWEET64multDiv
+			prgmStack[(unsigned int)(spnt++)] = sched;
+#ifdef useStackWatch
+			if (spnt > s64maxDepth) s64maxDepth = spnt;
+#endif
+			if (spnt > 15) break;
+			else sched = (const uint8_t *)pgm_read_word(&S64programList[(unsigned int)(m)]);
+#ifdef useSWEET64profiler
+			profSlot[(unsigned int)(spnt)] = S64profCall(m);
+			profStart[(unsigned int)(spnt)] = (unsigned int)(cycles2());
+#endif
+#else
+			if (m == idxS64doMultiply) mul64(tempPtr[1], tempPtr[0]);
+			else div64(tempPtr[1], tempPtr[0]);
+#endif
+		}
+
 #ifdef useSWEET64trace
 		if (tf)
 		{
@@ -5582,8 +6617,8 @@ void mul64(union union_64 * an, union union_64 * ann)
 
 void div64(union union_64 * an, union union_64 * ann) // dividend in an, divisor in ann
 {
-	union union_64 * quotientBit = tempPtr[3];
-	union union_64 * divisor = tempPtr[4];
+	union union_64 * divisor = tempPtr[3];
+	union union_64 * quotientBit = tempPtr[4];
 
 	copy64(divisor, ann); // copy ann value to divisor
 	copy64(ann, an); // copy an value (dividend) to ann (this will become remainder)
@@ -5594,6 +6629,7 @@ void div64(union union_64 * an, union union_64 * ann) // dividend in an, divisor
 	{ // if divisor is zero, mark as overflow, then exit
 		add64(an, quotientBit, 1); // subtract 1 from zeroed-out result to generate overflow value
 		copy64(ann, an); // copy overflow value to remainder
+		copy64(divisor, an); // copy overflow value to divisor, so doAdjust leaves the result alone
 	}
 	else if (!(zeroTest64(ann)))
 	{ // if dividend is not zero,
@@ -5899,8 +6935,8 @@ unsigned long rformat(void)
 }
 
 const uint8_t prgmConvertToTime[] PROGMEM = {
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrJump, idxS64doDivide
+	instrDivByConst, idxCyclesPerSecond,
+	instrDone
 };
 
 unsigned long convertTime(unsigned long * an)
@@ -5928,10 +6964,9 @@ const uint8_t prgmGenerateVoltageSlope[] PROGMEM = {
 
 const uint8_t prgmConvertVolts[] PROGMEM = {
 	instrLdEEPROMindexed, 0x02, pMAPsensorFloorIdx,
-	instrLdConst, 0x01, idxNumerVoltage,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDenomVoltage,
-	instrJump, idxS64doDivide,
+	instrMulByConst, idxNumerVoltage,
+	instrDivByConst, idxDenomVoltage,
+	instrDone
 };
 #endif
 
@@ -5939,8 +6974,8 @@ const uint8_t prgmConvertInjSettleTime[] PROGMEM = {
 	instrLdConst, 0x01, idxCyclesPerSecond,
 	instrLdEEPROM, 0x02, pInjectorSettleTimeIdx,
 	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrJump, idxS64doDivide,
+	instrDivByConst, idxMicroSecondsPerSecond,
+	instrDone
 };
 
 const uint8_t prgmFindSleepTicks[] PROGMEM = {
@@ -5958,10 +6993,8 @@ const uint8_t prgmFindMinGoodRPM[] PROGMEM = {
 	instrLdByte, 0x01, 60,						// load seconds per minute into register 1
 	instrLdEEPROM, 0x02, pCrankRevPerInjIdx,			// load crank revolutions per injector event into register 2
 	instrCall, idxS64doMultiply,					// perform multiply
-	instrLdConst, 0x01, idxCyclesPerSecond,				// load cycles per second into register 1
-	instrCall, idxS64doMultiply,					// perform conversion
-	instrLdEEPROM, 0x01, pMinGoodRPMidx,				// get minimum good RPM figure from EEPROM
-	instrCall, idxS64doDivide,					// convert figure into cycles
+	instrMulByConst, idxCyclesPerSecond,				// convert to cycles per minute
+	instrDivByEEPROM, pMinGoodRPMidx,				// divide by minimum good RPM figure from EEPROM
 	instrLd, 0x32,							// move result into register 3 (minGoodRPMcycles)
 	instrDone
 };
@@ -5978,10 +7011,9 @@ const uint8_t prgmFindInjResetDelay[] PROGMEM = {
 
 const uint8_t prgmFindMaxGoodInjCycles[] PROGMEM = {
 	instrLd, 0x23,							// load register 2 with contents of register 3
-	instrLdByte, 0x01, 80,						// multiply minGoodRPMcycles figure by 0.8
-	instrCall, idxS64doMultiply,
-	instrLdByte, 0x01, 100,
-	instrJump, idxS64doDivide,					// (maxGoodInjCycles)
+	instrMulByByte, 80,						// multiply minGoodRPMcycles figure by 0.8
+	instrDivByByte, 100,						// (maxGoodInjCycles)
+	instrDone
 };
 
 #ifdef useBarFuelEconVsTime
@@ -5993,6 +7025,43 @@ const uint8_t prgmFindFEvsTimePeriod[] PROGMEM = {
 
 #endif
 #ifdef useWindowFilter
+/*
+ * the window filter keeps the last few loops of raw counts in a ring of
+ * narrow deltas, and replaces the instant trip with their running sum. each
+ * counter only gets enough bytes to hold one loop's worth
+ *
+ * in exponential mode, the sum trip instead holds one fixed-point
+ * accumulator per counter, which loses 1/2^n of itself every loop
+ *
+ * a length of 1 is what the old on/off setting stored for "on", so it
+ * still gets the 4 loop window that setting used to turn on
+ */
+const uint8_t windowFilterSize = 16; // longest allowed window
+const uint8_t windowFilterOldSize = 4; // window that a length of 1 stands for
+const uint8_t windowFilterPulseBytes = 2;
+const uint8_t windowFilterCycleBytes = 3;
+const uint8_t windowFilterElemSize = windowFilterPulseBytes * 2 + windowFilterCycleBytes * 3;
+const uint8_t windowFilterExpShift = 6; // fractional bits of exponential mode accumulators
+
+const uint8_t windowFilterVars[] PROGMEM = {
+	rvVSSpulseIdx,
+	rvInjPulseIdx,
+	rvVSScycleIdx,
+	rvInjCycleIdx,
+	rvInjOpenCycleIdx,
+};
+
+const uint8_t windowFilterVarBytes[] PROGMEM = {
+	windowFilterPulseBytes,
+	windowFilterPulseBytes,
+	windowFilterCycleBytes,
+	windowFilterCycleBytes,
+	windowFilterCycleBytes,
+};
+
+const uint8_t windowFilterVarCount = (sizeof(windowFilterVars) / sizeof(uint8_t));
+
+uint8_t windowFilterRing[(unsigned int)(windowFilterSize) * windowFilterElemSize];
 uint8_t windowFilterIdx = 0;
 uint8_t windowFilterCount = 0;
 
@@ -6005,17 +7074,103 @@ void resetWindowFilter(void)
 
 }
 
+void updateWindowFilter(void)
+{
+	unsigned long * inst = tripArray[(unsigned int)(instantIdx)].collectedData;
+	unsigned long * sum = tripArray[(unsigned int)(windowFilterSumIdx)].collectedData;
+	uint8_t * p;
+	unsigned long v;
+	uint8_t len = (uint8_t)(paramRead(WindowFilter));
+	uint8_t i;
+	uint8_t j;
+	uint8_t n;
+
+	if (len == 0) return;
+	if (len == 1) len = windowFilterOldSize;
+	if (len > windowFilterSize) len = windowFilterSize;
+
+	/* if no fuel is being consumed, reset filter */
+	if (inst[rvInjOpenCycleIdx] == 0)
+	{
+		resetWindowFilter();
+		return;
+	}
+
+	if (paramRead(WindowFilterExp))
+	{
+		/* the time constant is the window length, rounded down to a power of 2 */
+		for (n = 0; len > 1; len >>= 1) n++;
+
+		for (i = 0; i < windowFilterVarCount; i++)
+		{
+			j = pgm_read_byte(&windowFilterVars[(unsigned int)(i)]);
+
+			sum[(unsigned int)(j)] -= (sum[(unsigned int)(j)] >> n);
+			sum[(unsigned int)(j)] += (inst[(unsigned int)(j)] << windowFilterExpShift);
+			inst[(unsigned int)(j)] = (sum[(unsigned int)(j)] >> windowFilterExpShift);
+		}
+
+		return;
+	}
+
+	/* update the CIC filter - once the window is full, the oldest loop falls out of the sum */
+	p = &windowFilterRing[(unsigned int)(windowFilterIdx) * windowFilterElemSize];
+
+	for (i = 0; i < windowFilterVarCount; i++)
+	{
+		j = pgm_read_byte(&windowFilterVars[(unsigned int)(i)]);
+		n = pgm_read_byte(&windowFilterVarBytes[(unsigned int)(i)]);
+
+		if (windowFilterCount == len)
+		{
+			v = 0;
+			for (uint8_t x = n; x; x--) v = (v << 8) | p[(unsigned int)(x - 1)];
+
+			if (j < rvVSScycleIdx) tripArray[(unsigned int)(windowFilterSumIdx)].sub32(j, v);
+			else tripArray[(unsigned int)(windowFilterSumIdx)].sub64s(j, v);
+		}
+
+		/* one loop never fills its delta, but clamp anyway so the sum stays consistent */
+		v = inst[(unsigned int)(j)];
+		if (v >> (n << 3)) v = (1ul << (n << 3)) - 1;
+
+		if (j < rvVSScycleIdx) tripArray[(unsigned int)(windowFilterSumIdx)].add32(j, v);
+		else tripArray[(unsigned int)(windowFilterSumIdx)].add64s(j, v);
+
+		for (uint8_t x = 0; x < n; x++)
+		{
+			*p++ = (uint8_t)(v);
+			v >>= 8;
+		}
+	}
+
+	if (windowFilterCount < len) windowFilterCount++;
+
+	tripArray[(unsigned int)(instantIdx)].transfer(tripArray[(unsigned int)(windowFilterSumIdx)]);
+
+	windowFilterIdx++;
+	if (windowFilterIdx >= len) windowFilterIdx = 0;
+}
+
 #endif
 void initGuino(void) // initialize all the parameters
 {
-	vssPause = (uint8_t)eepromReadVal((unsigned int)(pVSSpauseIdx));
-	metricFlag = (uint8_t)eepromReadVal((unsigned int)(pMetricFlagIdx));
+	vssPause = (uint8_t)paramRead(VSSpause);
+	metricFlag = (uint8_t)paramRead(MetricFlag);
 	ignoreChar = (metricFlag ? '{' : '\\');
 	printChar = ignoreChar ^ ('{' ^ '\\');
 
 #ifdef useWindowFilter
 	resetWindowFilter();
 
+#endif
+#ifdef useBarFuelEconVsSpeed
+	initBarFEvS();
+
+#endif
+#ifdef useSerialPort
+	serialSetBaudRate();
+
 #endif
 	cli(); // disable interrupts while messing with fuel injector settings
 
@@ -6030,8 +7185,9 @@ void initGuino(void) // initialize all the parameters
 
 	}
 
-	pressure[(unsigned int)fuelPressureIdx] = eepromReadVal((unsigned int)(pSysFuelPressureIdx)); // this is in psig * 1000
+	pressure[(unsigned int)fuelPressureIdx] = paramRead(SysFuelPressure); // this is in psig * 1000
 	pressure[(unsigned int)injCorrectionIdx] = 4096;
+	injCorrection = 4096;
 
 #endif
 
@@ -6041,7 +7197,7 @@ void initGuino(void) // initialize all the parameters
 	EIMSK &= ~((1 << INT5) | (1 << INT4)); // disable fuel injector sense interrupts
 
 	EICRB |= ((1 << ISC51) | (1 << ISC50) | (1 << ISC41) | (1 << ISC40)); // set injector sense pin control
-	EICRB &= ~(1 << (eepromReadVal((unsigned int)(pInjEdgeTriggerIdx)) ? ISC50 : ISC40));
+	EICRB &= ~(1 << (paramRead(InjEdgeTrigger) ? ISC50 : ISC40));
 
 	EIFR |= ((1 << INTF5) | (1 << INTF4)); // clear fuel injector sense flag
 	EIMSK |= ((1 << INT5) | (1 << INT4)); // enable fuel injector sense interrupts
@@ -6049,7 +7205,7 @@ void initGuino(void) // initialize all the parameters
 	EIMSK &= ~((1 << INT1) | (1 << INT0)); // disable fuel injector sense interrupts
 
 	EICRA |= ((1 << ISC11) | (1 << ISC10) | (1 << ISC01) | (1 << ISC00)); // set injector sense pin control
-	EICRA &= ~(1 << (eepromReadVal((unsigned int)(pInjEdgeTriggerIdx)) ? ISC10 : ISC00));
+	EICRA &= ~(1 << (paramRead(InjEdgeTrigger) ? ISC10 : ISC00));
 
 	EIFR |= ((1 << INTF1) | (1 << INTF0)); // clear fuel injector sense flag
 	EIMSK |= ((1 << INT1) | (1 << INT0)); // enable fuel injector sense interrupts
@@ -6102,6 +7258,14 @@ void doOutputDataLog(void)
 
 	uint8_t c = ',';
 
+#ifdef useBufferedSerialPort
+	if (serialBuffer.room() < dLIcount * 11) // each value is at most 10 characters, plus a separator
+	{
+		if (serialBuffer.dropCount < 9999) serialBuffer.dropCount++;
+		return;
+	}
+
+#endif
 	for (uint8_t x = 0; x < dLIcount; x++)
 	{
 
@@ -6122,1768 +7286,4408 @@ void simpletx(char * str)
 }
 #endif
 
-#ifdef useSerialPort
-void pushSerialCharacter(uint8_t chr)
-{
-
-#ifdef useBufferedSerialPort
+#ifdef useCoastDownCalculator
+/*
+ * coastdown estimation of C(rr) and C(d)
+ *
+ * a loop with no injector pulses in it, following another loop with none,
+ * is taken as engine-off coasting. the drop in speed between those two
+ * loops gives one deceleration sample a, at the average speed v of the two.
+ * with rolling resistance and aerodynamic drag doing all the slowing,
+ *
+ *   a = C(rr) * g + (rho * C(d) * A / (2 * m)) * v^2
+ *
+ * so a straight line fit of a against v^2 yields both coefficients. only
+ * running sums are kept, so each sample costs the same no matter how many
+ * have been collected. whenever a coasting stretch ends with enough new
+ * samples in, the fit is solved, and C(rr) and C(d) are held in RAM for the
+ * coastdown screen. they only go to EEPROM once accepted there, with a long
+ * press of all three buttons - decel fuel cut in gear also shuts off the
+ * injectors, and looks just like coasting here, but the engine braking in
+ * it would come out as far too much drag.
+ * samples where the speed happened to go up are kept as well, as throwing
+ * them out would bias the fit towards more drag. C(v) is not fitted - over
+ * a normal coastdown speed range, it can't be told apart from the other two.
+ * this all assumes coasting in neutral, on level road.
+ *
+ * units - v in 0.1 m/s, v^2 in (0.1 m/s)^2, a in mm/s^2
+ */
+const unsigned int coastDownMinSpeed = 50; // below 5 m/s, VSS resolution swamps the deceleration
+const unsigned int coastDownMaxSpeed = 500; // above 50 m/s, the sums could overflow
+const unsigned int coastDownMaxSamples = 4096;
+const uint8_t coastDownSolveSamples = 20 * loopsPerSecond; // coasting seconds needed before a new solution
 
-	serialBuffer.push(chr);
+unsigned int coastDownSamples;
+unsigned int coastDownSolvedSamples;
+uint8_t coastDownActive;
+uint8_t coastDownFitReady; // a fit is waiting to be accepted
+unsigned int coastDownCd; // C(d) * 1000, from the latest fit
+unsigned int coastDownCrr; // C(rr) * 1000, from the latest fit
+long long coastDownSumU;
+long long coastDownSumUU;
+long long coastDownSumA;
+long long coastDownSumUA;
 
-#else
-	if (UCSR0B != (1 << TXEN0)) UCSR0B = (1 << TXEN0); // if serial output is not yet enabled, enable it
+unsigned long coastDownSpeed(uint8_t tripIdx) // returns speed in mm/s
+{
 
-	while (!(UCSR0A & (1 << UDRE0))); // wait until transmit buffer is empty
+	unsigned long s = SWEET64(prgmSpeed, tripIdx); // MPH*1000 or kph*1000
 
-	UDR0 = chr; //send the data
-#endif
+	if (metricFlag) return s * 5ul / 18ul;
+	else return s * 2794ul / 6250ul;
 
 }
 
-#ifdef useBufferedSerialPort
-void serialTransmitEnable(void)
+void coastDownUpdate(void)
 {
 
-	UCSR0B = ((1 << TXEN0) | (1 << UDRIE0)); // Enable transmitter and interrupt
+	if ((tripArray[thisCoastDownIdx].collectedData[rvInjPulseIdx]) || (tripArray[lastCoastDownIdx].collectedData[rvInjPulseIdx]))
+	{
+		/* engine is running - if a coasting stretch just ended, see if there's enough to go on */
+		if ((coastDownActive) && (coastDownSamples - coastDownSolvedSamples >= coastDownSolveSamples)) coastDownSolve();
+		coastDownActive = 0;
+		return;
+	}
+
+	coastDownAddSample(coastDownSpeed(lastCoastDownIdx), coastDownSpeed(thisCoastDownIdx));
 
 }
 
-void serialTransmitDisable(void)
+void coastDownAddSample(unsigned long v1, unsigned long v2) // speeds one loop apart, in mm/s
 {
 
-	UCSR0B = 0; // Disable transmitter and interrupt
+	unsigned long u;
+	long a;
 
-}
+	if (coastDownSamples >= coastDownMaxSamples) return;
 
-void serialTransmitByte(uint8_t s)
-{
+	a = ((long)(v1) - (long)(v2)) * loopsPerSecond;
+	u = (v1 + v2 + 100ul) / 200ul; // average speed, in 0.1 m/s
 
-	UDR0 = s; // Transmit a byte
+	if ((u < coastDownMinSpeed) || (u > coastDownMaxSpeed)) return;
 
-}
+	u *= u;
 
-#endif
-#endif
+	coastDownSamples++;
+	coastDownSumU += u;
+	coastDownSumUU += (long long)(u) * (long long)(u);
+	coastDownSumA += a;
+	coastDownSumUA += (long long)(u) * (long long)(a);
+	coastDownActive = 1;
 
-/* Display cursor update section */
+}
 
-void doCursorMoveAbsolute(uint8_t i, uint8_t j)
+void coastDownSolve(void)
 {
-#ifdef useScreenEditor
-
-	if (menuLevel == screenEditIdx) doSaveScreen();
-#endif
-
-	menuLevel = i;
-	if (pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][2]) > j) screenCursor[(unsigned int)(menuLevel)] = j;
 
-	callFuncPointer(&screenParameters[(unsigned int)(menuLevel)][4]);
+	long long n = coastDownSamples;
+	long long num = n * coastDownSumUA - coastDownSumU * coastDownSumA;
+	long long den = n * coastDownSumUU - coastDownSumU * coastDownSumU;
+	long long k;
+	long long c;
+	unsigned long m = eepromReadVal(pVehicleMassIdx);
+	unsigned long ar = eepromReadVal(pVehicleFrontalAreaIdx);
+	unsigned long rho = eepromReadVal(pLocustDensityIdx);
 
-}
+	coastDownSolvedSamples = coastDownSamples;
 
-void doCursorMoveRelative(uint8_t i, uint8_t j)
-{
+	if ((num <= 0) || (den <= 0)) return; // speeds too close together, or drag came out negative
 
-	uint8_t k = 0;
-	uint8_t v;
-	uint8_t w = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][1]);
-	uint8_t x = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][0]);
-	uint8_t y = menuLevel - x;
-	uint8_t z = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][2]);
-#ifdef useScreenEditor
+	if (metricFlag == 0) // convert to kg, m^2 * 1000, and kg/m^3 * 1000
+	{
+		m = m * 45359ul / 100000ul;
+		ar = ar * 929ul / 10000ul;
+		rho = rho * 5933ul / 10000ul;
+	}
 
-	if (menuLevel == screenEditIdx) doSaveScreen();
-#endif
+	if ((m == 0) || (ar == 0) || (rho == 0)) return;
 
-	if (j)
+	while (num > 0x3FFFFFFFFll) // keep num * 2e8 inside 64 bits - the ratio is all that matters
 	{
+		num >>= 1;
+		den >>= 1;
+	}
 
-		v = screenCursor[(unsigned int)(menuLevel)] + j;
+	if (den <= 0) return; // shifted all the way out, so the slope is too steep to mean anything
 
-		if (v == z)
-		{
+	k = num * 200000000ll / den; // slope, * 2e8
 
-			v = 0;
-			i = j;
-			k = 1;
+	/* C(d) * 1000 = 2000 * m * (slope / 10) / (rho * A) */
+	c = (k * (long long)(m) + (long long)(rho * ar) / 2) / (long long)(rho * ar);
+	if ((c < 1) || (c > 65535)) return;
 
-		}
-		else if (v > z)
-		{
+	/* C(rr) * 1000 = (intercept, in mm/s^2) / g */
+	k = (coastDownSumA * 1000ll - k * coastDownSumU / 200000ll) / n; // intercept, * 1000
+	k = (k * 100ll + 490332ll) / 980665ll;
+	if ((k < 0) || (k > 65535)) return;
 
-			v = z - 1;
-			i = j;
-			k = 1;
+	coastDownCd = (unsigned int)(c);
+	coastDownCrr = (unsigned int)(k);
+	coastDownFitReady = 1;
 
-		}
+}
 
-		screenCursor[(unsigned int)(menuLevel)] = v;
+void doCursorUpdateCoastDown(void)
+{
+	printStatusMessage(PSTR("Coastdown"));
+}
 
-	}
+/* the latest fit, marked "new" until it is accepted, or else the coefficients in use, marked "set" */
+void doCoastDownDisplay(void)
+{
+	unsigned long c = coastDownCd;
+	unsigned long k = coastDownCrr;
 
-	if (i)
+	if (coastDownFitReady == 0)
 	{
+		c = eepromReadVal(pCoefficientDidx);
+		k = eepromReadVal(pCoefficientRRidx);
+	}
 
-		y += i;
+	printFlash(PSTR("C(d)"));
+	print(format(c, 3));
+	printFlash(PSTR(" n"));
+	print(itoa(coastDownSamples, mBuff1, 10));
+	clrEOL();
+	gotoXY(0, 1);
+	printFlash(PSTR("C(rr)"));
+	print(format(k, 3));
+	printFlash((coastDownFitReady) ? PSTR(" new") : PSTR(" set"));
+	clrEOL();
+}
 
-		if (y == w) y = 0;
-		if (y > w) y = w - 1;
-		menuLevel = y + x;
+void doCoastDownAccept(void)
+{
+	if (coastDownFitReady == 0)
+	{
+		printStatusMessage(PSTR("No New Fit"));
+		return;
+	}
 
-		if (k)
-		{
+	eepromWriteVal(pCoefficientDidx, (unsigned long)(coastDownCd));
+	eepromWriteVal(pCoefficientRRidx, (unsigned long)(coastDownCrr));
+	coastDownFitReady = 0;
 
-			if (i == 1) v = 0;
-			else v = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][2]) - 1;
+	printStatusMessage(PSTR("C(d) C(rr) Saved"));
+}
 
-			screenCursor[(unsigned int)(menuLevel)] = v;
+/* throw out every sample and any fit not yet accepted, as after a run spoiled by traffic, wind, or a grade */
+void doCoastDownReset(void)
+{
+	coastDownSamples = 0;
+	coastDownSolvedSamples = 0;
+	coastDownActive = 0;
+	coastDownFitReady = 0;
+	coastDownSumU = 0;
+	coastDownSumUU = 0;
+	coastDownSumA = 0;
+	coastDownSumUA = 0;
 
-		}
+	printStatusMessage(PSTR("Coastdown Reset"));
+}
 
-	}
+#endif
+#ifdef useBinaryTelemetry
+/*
+ * binary telemetry frames go out at telemetryPerSecond, in between main
+ * loop passes. no unit conversion is done here - each frame carries the
+ * raw trip measurements accumulated since the previous frame, and the
+ * host does the rest. all multibyte values are little endian.
+ *
+ *   0     : frame type (1)
+ *   1     : sequence number, so the host can spot dropped frames
+ *   2-5   : cycles2() timestamp, in timer 2 ticks
+ *   6-25  : VSS pulses, injector pulses, VSS cycles, injector cycles,
+ *           and injector open cycles, since the previous frame
+ *   26-29 : analog channels 0 and 1, raw (only with useAnalogRead)
+ *   then  : CRC-16-CCITT of all of the above
+ *
+ * whenever the sequence number comes around to 0, a description frame
+ * goes out in place of a data frame, so that a log can be decoded
+ * without knowing how the unit was set up. the measurements for that
+ * slot roll over into the next data frame.
+ *
+ *   0     : frame type (2)
+ *   1     : sequence number (0)
+ *   2-5   : timer 2 ticks per second
+ *   6     : data frames per second
+ *   7     : metric flag
+ *   8-23  : microseconds per unit fuel, injector settle time,
+ *           VSS pulses per unit distance, and crank revs per injector
+ *           pulse, straight from EEPROM
+ *   then  : CRC-16-CCITT of all of the above
+ *
+ * with useStackWatch, a health frame likewise takes the place of the data
+ * frame whenever the sequence number comes around to 128.
+ *
+ *   0     : frame type (3)
+ *   1     : sequence number (128)
+ *   2-3   : fewest untouched bytes ever seen between .bss and the stack
+ *   4     : deepest SWEET64 call nesting
+ *   5-7   : most bytes ever waiting in the LCD, serial transmit, and
+ *           serial receive buffers (0 if not built in)
+ *   then  : CRC-16-CCITT of all of the above
+ *
+ * each frame is COBS encoded and ends with a zero byte, so the host can
+ * always find the start of the next frame.
+ */
+const uint8_t telemetryPerSecond = 10;
+const unsigned long telemetryPeriod = t2CyclesPerSecond / telemetryPerSecond;
+
+const uint8_t telemetryFieldList[] PROGMEM = {
+	rvVSSpulseIdx,
+	rvInjPulseIdx,
+	rvVSScycleIdx,			// only the lower 32 bits of these are sent
+	rvInjCycleIdx,
+	rvInjOpenCycleIdx,
+};
 
-	doRefreshDisplay(); // call the appropriate display routine
-	callFuncPointer(&screenParameters[(unsigned int)(menuLevel)][4]);
+const uint8_t tFLsize = (sizeof(telemetryFieldList) / sizeof(uint8_t));
 
-}
+const uint8_t telemetryParamList[] PROGMEM = {
+	pMicroSecondsPerQuantityIdx,
+	pInjectorSettleTimeIdx,
+	pPulsesPerDistanceIdx,
+	pCrankRevPerInjIdx,
+};
 
-void doRefreshDisplay(void)
-{
+const uint8_t tPLsize = (sizeof(telemetryParamList) / sizeof(uint8_t));
 
-	gotoXY(0, 0);
-	callFuncPointer(&screenParameters[(unsigned int)(menuLevel)][3]);
+#ifdef useAnalogRead
+const uint8_t telemetryFrameSize = 6 + 4 * tFLsize + 4;
+#else
+const uint8_t telemetryFrameSize = 6 + 4 * tFLsize;
+#endif
 
-}
+unsigned long telemetryLast[(unsigned int)(tFLsize)];
+unsigned long telemetryLastCycle;
+uint8_t telemetrySequence;
 
-void doNothing(void)
+void telemetryLoopSync(void)
 {
-}
 
-void doNothing2(uint8_t s)
-{
+	/*
+	 * raw trip data has just been moved to instant, and reset. anything
+	 * already sent is part of instant now, so rebase the last sent values
+	 */
+	for (uint8_t x = 0; x < tFLsize; x++)
+		telemetryLast[(unsigned int)(x)] -= tripArray[instantIdx].collectedData[(unsigned int)(pgm_read_byte(&telemetryFieldList[(unsigned int)(x)]))];
+
 }
 
-void noSupport(void)
+uint8_t telemetryPoll(void) // returns 1 if a frame was due
 {
 
-	initStatusLine();
-	printFlash(PSTR("Btn "));
-	print(itoa((unsigned int)(buttonState), mBuff1, 10));
-	printFlash(PSTR(" Pressed"));
-	execStatusLine();
+	uint8_t buff[(unsigned int)(telemetryFrameSize + 2)];
+	unsigned long v[(unsigned int)(tFLsize)];
+	unsigned long w;
+	uint8_t i = 0;
 
-}
+	if (paramRead(SerialDataLogging) != 2) return 0;
 
-const uint8_t calcLabelCGRAM[] PROGMEM = {
-	0b00000000,		// clock
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000011,
-	0b00000100,
-	0b00000100,
-	0b00000011,
+	w = cycles2();
+	if (findCycleLength(telemetryLastCycle, w) < telemetryPeriod) return 0;
+	telemetryLastCycle = w;
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010100,
-	0b00010101,
-	0b00010110,
-	0b00010101,
+#ifdef useBufferedSerialPort
+	/*
+	 * rather than stall the main loop, skip this frame. its measurements
+	 * roll over into the next frame, and the host sees the sequence gap
+	 */
+	if (serialBuffer.room() < telemetryFrameSize + 5)
+	{
+		if (serialBuffer.dropCount < 9999) serialBuffer.dropCount++;
+		telemetrySequence++;
+		return 1;
+	}
 
-	0b00010010,		// microseconds
-	0b00010010,
-	0b00010010,
-	0b00011110,
-	0b00010000,
-	0b00110000,
-	0b01000000,
-	0b01100000,
+#endif
+	if (telemetrySequence == 0)
+	{
+		buff[(unsigned int)(i++)] = 2;
+		buff[(unsigned int)(i++)] = telemetrySequence++;
+		w = t2CyclesPerSecond;
+		for (uint8_t y = 0; y < 4; y++, w >>= 8) buff[(unsigned int)(i++)] = (uint8_t)(w);
+		buff[(unsigned int)(i++)] = telemetryPerSecond;
+		buff[(unsigned int)(i++)] = metricFlag;
+
+		for (uint8_t x = 0; x < tPLsize; x++)
+		{
+			w = eepromReadVal((unsigned int)(pgm_read_byte(&telemetryParamList[(unsigned int)(x)])));
+			for (uint8_t y = 0; y < 4; y++, w >>= 8) buff[(unsigned int)(i++)] = (uint8_t)(w);
+		}
 
-	0b00001110,
-	0b00010000,
-	0b00001100,
-	0b00000010,
-	0b00011100,
-	0b00000000,
-	0b00000000,
-	0b00000000,
+		serialSendFrame(buff, i);
+		return 1;
+	}
+#ifdef useStackWatch
 
-	0b00000000,		// pulse count
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000011,
-	0b00000100,
-	0b00000100,
-	0b00000011,
+	if (telemetrySequence == 128)
+	{
+		buff[(unsigned int)(i++)] = 3;
+		buff[(unsigned int)(i++)] = telemetrySequence++;
+		buff[(unsigned int)(i++)] = (uint8_t)(stackLowWater);
+		buff[(unsigned int)(i++)] = (uint8_t)(stackLowWater >> 8);
+		buff[(unsigned int)(i++)] = s64maxDepth;
+#ifdef useLegacyLCDbuffered
+		buff[(unsigned int)(i++)] = lcdBuffer.highWater;
+#else
+		buff[(unsigned int)(i++)] = 0;
+#endif
+#ifdef useBufferedSerialPort
+		buff[(unsigned int)(i++)] = serialBuffer.highWater;
+#else
+		buff[(unsigned int)(i++)] = 0;
+#endif
+#ifdef useSerialConfig
+		buff[(unsigned int)(i++)] = serialRxBuffer.highWater;
+#else
+		buff[(unsigned int)(i++)] = 0;
+#endif
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00001000,
-	0b00011100,
-	0b00001000,
-	0b00001000,
+		serialSendFrame(buff, i);
+		return 1;
+	}
+#endif
 
-	0b00001100,		// revolutions per minute
-	0b00010000,
-	0b00010001,
-	0b00010010,
-	0b00000100,
-	0b00001000,
-	0b00000000,
-	0b00000000,
+	uint8_t oldSREG = SREG; // save interrupt flag status
+	cli(); // perform atomic transfer of raw measurements
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00000000,
-	0b00011011,
-	0b00010101,
-	0b00010101,
+	for (uint8_t x = 0; x < tFLsize; x++)
+		v[(unsigned int)(x)] = tripArray[rawIdx].collectedData[(unsigned int)(pgm_read_byte(&telemetryFieldList[(unsigned int)(x)]))];
 
-	0b00011011,		// miles per gallon
-	0b00010101,
-	0b00010101,
-	0b00000000,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+	SREG = oldSREG; // restore interrupt flag status
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00001100,
-	0b00010000,
-	0b00010100,
-	0b00001100,
+	buff[(unsigned int)(i++)] = 1;
+	buff[(unsigned int)(i++)] = telemetrySequence++;
+	for (uint8_t y = 0; y < 4; y++, w >>= 8) buff[(unsigned int)(i++)] = (uint8_t)(w);
 
-	0b00010000,		// liters per 100 km
-	0b00010000,
-	0b00011001,
-	0b00000010,
-	0b00000100,
-	0b00001001,
-	0b00000001,
-	0b00000001,
+	for (uint8_t x = 0; x < tFLsize; x++)
+	{
+		w = v[(unsigned int)(x)] - telemetryLast[(unsigned int)(x)];
+		telemetryLast[(unsigned int)(x)] = v[(unsigned int)(x)];
+		for (uint8_t y = 0; y < 4; y++, w >>= 8) buff[(unsigned int)(i++)] = (uint8_t)(w);
+	}
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00000000,
-	0b00011111,
-	0b00010101,
-	0b00011111,
+#ifdef useAnalogRead
+	for (uint8_t x = 0; x < 2; x++)
+	{
+		w = analogValue[(unsigned int)(x)];
+		buff[(unsigned int)(i++)] = (uint8_t)(w);
+		buff[(unsigned int)(i++)] = (uint8_t)(w >> 8);
+	}
 
-	0b00000000,		// miles
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00010001,
-	0b00011011,
-	0b00010101,
-	0b00010101,
+#endif
+	serialSendFrame(buff, i);
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010000,
-	0b00000000,
-	0b00010000,
-	0b00010000,
+	return 1;
 
-	0b00000000,		// kilometers
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000100,
-	0b00000101,
-	0b00000110,
-	0b00000101,
+}
+#endif
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00000000,
-	0b00001010,
-	0b00010101,
-	0b00010101,
+#ifdef useSerialFrames
+void serialSendFrame(uint8_t * buff, uint8_t len) // buff must have room for 2 more bytes, for the CRC
+{
 
-	0b00011011,		// miles per hour
-	0b00010101,
-	0b00010101,
-	0b00000000,
-	0b00000110,
-	0b00000101,
-	0b00000110,
-	0b00000100,
+	uint16_t crc = 0xFFFF;
+	uint8_t i = 0;
+	uint8_t j;
+	uint8_t n;
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010100,
-	0b00011100,
-	0b00010100,
-	0b00010100,
+	for (j = 0; j < len; j++) crc = crc16update(crc, buff[(unsigned int)(j)]);
+	buff[(unsigned int)(len++)] = (uint8_t)(crc);
+	buff[(unsigned int)(len++)] = (uint8_t)(crc >> 8);
 
-	0b00010000,		// kilometers per hour
-	0b00010100,
-	0b00011000,
-	0b00010100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+	/* COBS - each block of non-zero bytes is preceded by its length plus 1, in place of the zero that ended it */
+	while (true)
+	{
+		for (j = i; (j < len) && (buff[(unsigned int)(j)]) && (j - i < 254); j++);
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010000,
-	0b00010000,
-	0b00011100,
-	0b00010100,
+		n = j - i;
+		pushSerialCharacter(n + 1);
+		while (i < j) pushSerialCharacter(buff[(unsigned int)(i++)]);
 
-	0b00000000,		// gallons
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000011,
-	0b00000100,
-	0b00000101,
-	0b00000011,
+		if (j == len) break;
+		if (n < 254) i++; // step over the zero byte this block replaced
+	}
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00000001,
-	0b00000001,
-	0b00011001,
-	0b00011101,
+	pushSerialCharacter(0); // frame delimiter
 
-	0b00000000,		// liters
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000100,
-	0b00000100,
-	0b00000100,
-	0b00000111,
+}
+#endif
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
+#ifdef useSerialConfig
+/*
+ * serial configuration channel - the host can pull out, or push in, the
+ * whole EEPROM image (signature, settings, screens, fill-up log, and saved
+ * trips) as one block. frames in both directions are COBS encoded with a
+ * trailing CRC-16-CCITT, just like binary telemetry frames, and all
+ * multibyte values are little endian.
+ *
+ *   'D'                       : host asks for a dump
+ *   'B' sig(3) len(2) crc(2)  : begin image - sig is the EEPROM signature,
+ *                               as stored, and crc covers the whole image
+ *   'W' offset(2) data(1-32)  : image bytes at offset
+ *   'E'                       : end image
+ *   'A' cmd status            : device reply to 'B', 'W', and 'E'
+ *
+ * a dump comes back as a 'B' frame, then 'W' frames, then an 'E' frame, so
+ * a saved dump can be sent straight back to load it. the 'W' and 'E' frames
+ * go out one per background task slice, so a dump never stalls the display. the host should wait
+ * for each reply before sending the next frame, and resend a frame if no
+ * reply comes. an image is only accepted if its signature and length match
+ * this build exactly. image bytes go to EEPROM thru the write queue, and
+ * the signature is cleared until the 'E' frame checks out, so an
+ * interrupted load falls back to default settings on the next reset.
+ *
+ * CSV data logging shares the same serial port, so turn that off first.
+ */
+const uint8_t serialConfigChunkSize = 32;
+const uint8_t serialConfigFrameSize = 3 + serialConfigChunkSize + 2;
+
+const uint8_t scsFrameReady =	0b10000000;
+const uint8_t scsOverflow =	0b01000000;
+const uint8_t scsLoading =	0b00100000;
+const uint8_t scsDumping =	0b00010000;
+
+const uint8_t scReplyOK = 0;
+const uint8_t scReplyBadVersion = 1;
+const uint8_t scReplyBadLength = 2;
+const uint8_t scReplyBadOffset = 3;
+const uint8_t scReplyNotLoading = 4;
+const uint8_t scReplyBadImage = 5;
+const uint8_t scReplyBadCommand = 6;
+
+uint8_t serialConfigFrame[(unsigned int)(serialConfigFrameSize)];
+uint8_t serialConfigLength;
+uint8_t serialConfigCode; // COBS code byte of the block being decoded
+uint8_t serialConfigCount; // bytes left in the block being decoded
+uint8_t serialConfigStatus;
+uint16_t serialConfigCRC; // image CRC promised by the 'B' frame
+unsigned int serialConfigDumpPtr; // next image byte to go out in a dump
+
+void serialConfigReceiveByte(uint8_t b) // called from Buffer::pull(), with interrupts off
+{
+
+	if (b == 0) // frame delimiter
+	{
+		if ((serialConfigStatus & scsOverflow) || (serialConfigCount) || (serialConfigLength < 3))
+			serialConfigLength = 0; // throw away a short or garbled frame
+		else
+			serialConfigStatus |= scsFrameReady;
 
-	0b00001100,		// gallons per hour
-	0b00010000,
-	0b00010100,
-	0b00001100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+		serialConfigStatus &= ~(scsOverflow);
+		serialConfigCode = 0;
+		serialConfigCount = 0;
+		return;
+	}
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010000,
-	0b00010000,
-	0b00011100,
-	0b00010100,
+	if (serialConfigCount) serialConfigCount--;
+	else
+	{
+		uint8_t c = serialConfigCode;
 
-	0b00010000,		// liters per hour
-	0b00010000,
-	0b00010000,
-	0b00011100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+		/* new block - the previous block ended with a zero, unless it was a full length block */
+		serialConfigCode = b;
+		serialConfigCount = b - 1;
+		if ((c == 0) || (c == 0xFF)) return;
+		b = 0;
+	}
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010000,
-	0b00010000,
-	0b00011100,
-	0b00010100,
-#ifdef useFuelCost
+	if (serialConfigLength < serialConfigFrameSize) serialConfigFrame[(unsigned int)(serialConfigLength++)] = b;
+	else serialConfigStatus |= scsOverflow;
 
-	0b00100000,		// fuel cost
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00001100,
-	0b00010000,
-	0b00010000,
-	0b00001100,
+}
 
-	0b00000010,
-	0b00000101,
-	0b00000100,
-	0b00001110,
-	0b00000100,
-	0b00000100,
-	0b00000100,
-	0b00000100,
+uint8_t serialConfigPoll(void) // returns 1 if any received bytes were processed
+{
 
-	0b00001100,		// fuel cost rate
-	0b00010000,
-	0b00010000,
-	0b00001100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+	uint8_t b = 0;
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010000,
-	0b00010000,
-	0b00011100,
-	0b00010100,
+	while (!(serialConfigStatus & scsFrameReady) && !(serialRxBuffer.bufferStatus & bufferIsEmpty))
+	{
+		serialRxBuffer.pull();
+		b = 1;
+	}
 
-	0b00001100,		// fuel cost per mile
-	0b00010000,
-	0b00010000,
-	0b00001100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+	if (serialConfigStatus & scsFrameReady)
+	{
+		serialConfigHandleFrame();
+		serialConfigLength = 0;
+		serialConfigStatus &= ~(scsFrameReady);
+		b = 1;
+	}
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010001,
-	0b00011011,
-	0b00010101,
-	0b00010101,
+	b |= serialConfigDump();
 
-	0b00001100,		// fuel cost per kilometer
-	0b00010000,
-	0b00010000,
-	0b00001100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+	return b;
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00010000,
-	0b00010100,
-	0b00011000,
-	0b00010100,
+}
 
-	0b00011011,		// mile per unit fuel cost
-	0b00010101,
-	0b00010101,
-	0b00000000,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+void serialConfigHandleFrame(void)
+{
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00001100,
-	0b00010000,
-	0b00010000,
-	0b00001100,
+	uint16_t crc = 0xFFFF;
+	uint8_t len = serialConfigLength - 2;
+	uint8_t s = scReplyBadCommand;
+	unsigned int t;
 
-	0b00010000,		// kilometer per unit fuel cost
-	0b00010100,
-	0b00011000,
-	0b00010100,
-	0b00000001,
-	0b00000010,
-	0b00000100,
-	0b00001000,
+	for (uint8_t x = 0; x < len; x++) crc = crc16update(crc, serialConfigFrame[(unsigned int)(x)]);
+	if ((serialConfigFrame[(unsigned int)(len)] != (uint8_t)(crc)) || (serialConfigFrame[(unsigned int)(len + 1)] != (uint8_t)(crc >> 8))) return; // garbled - the host will resend
+
+	t = (unsigned int)(serialConfigFrame[1]) + ((unsigned int)(serialConfigFrame[2]) << 8);
+
+	switch (serialConfigFrame[0])
+	{
+
+		case 'D':
+			crc = serialConfigImageCRC();
+
+			serialConfigFrame[0] = 'B';
+			for (uint8_t x = 0; x < 3; x++) serialConfigFrame[(unsigned int)(x + 1)] = (uint8_t)(newEEPROMsignature >> (16 - 8 * x));
+			serialConfigFrame[4] = (uint8_t)(eeAdrEnd);
+			serialConfigFrame[5] = (uint8_t)(eeAdrEnd >> 8);
+			serialConfigFrame[6] = (uint8_t)(crc);
+			serialConfigFrame[7] = (uint8_t)(crc >> 8);
+			serialSendFrame(serialConfigFrame, 8);
+
+			serialConfigDumpPtr = 0;
+			serialConfigStatus |= scsDumping; // serialConfigPoll() sends the rest, a frame at a time
+			return;
+
+		case 'B':
+			if (len != 8) break;
+
+			s = scReplyOK;
+			for (uint8_t x = 0; x < 3; x++)
+				if (serialConfigFrame[(unsigned int)(x + 1)] != (uint8_t)(newEEPROMsignature >> (16 - 8 * x))) s = scReplyBadVersion;
+
+			t = (unsigned int)(serialConfigFrame[4]) + ((unsigned int)(serialConfigFrame[5]) << 8);
+			if ((s == scReplyOK) && (t != eeAdrEnd)) s = scReplyBadLength;
+
+			if (s == scReplyOK)
+			{
+				serialConfigCRC = (uint16_t)(serialConfigFrame[6]) + ((uint16_t)(serialConfigFrame[7]) << 8);
+				eepromWriteVal((unsigned int)(eePtrSignature), 0);
+				serialConfigStatus |= scsLoading;
+			}
+			break;
+
+		case 'W':
+			if (len < 4) break;
+
+			if (!(serialConfigStatus & scsLoading)) s = scReplyNotLoading;
+			else if (t + (unsigned int)(len - 3) > eeAdrEnd) s = scReplyBadOffset;
+			else
+			{
+				for (uint8_t x = 3; x < len; x++, t++)
+				{
+					/* the signature only goes in once the whole image checks out */
+					if ((t >= eeAdrSettingsStart) && (eepromReadByte(t) != serialConfigFrame[(unsigned int)(x)]))
+						eepromWriteByte(t, serialConfigFrame[(unsigned int)(x)]);
+				}
+				s = scReplyOK;
+			}
+			break;
+
+		case 'E':
+			if (len != 1) break;
+
+			if (!(serialConfigStatus & scsLoading)) s = scReplyNotLoading;
+			else if (serialConfigImageCRC() != serialConfigCRC) s = scReplyBadImage;
+			else
+			{
+				eepromWriteVal((unsigned int)(eePtrSignature), newEEPROMsignature);
+				loadParams();
+				s = scReplyOK;
+			}
+			serialConfigStatus &= ~(scsLoading);
+			break;
+
+		default:
+			break;
+
+	}
+
+	serialConfigReply(serialConfigFrame[0], s);
+
+}
+
+void serialConfigReply(uint8_t cmd, uint8_t status)
+{
+
+	uint8_t buff[5];
+
+	buff[0] = 'A';
+	buff[1] = cmd;
+	buff[2] = status;
+
+	serialSendFrame(buff, 3);
+
+}
+
+uint8_t serialConfigDump(void) // sends the next frame of a dump, if one is in progress - returns 1 if a frame went out
+{
+
+	uint8_t buff[(unsigned int)(serialConfigFrameSize)];
+	uint8_t i;
+
+	if (!(serialConfigStatus & scsDumping)) return 0;
+
+#ifdef useBufferedSerialPort
+	/* wait for room for the whole frame, plus its COBS overhead, rather than stall the main loop */
+	if (serialBuffer.room() < serialConfigFrameSize + 2) return 0;
 
-	0b00100000,
-	0b01000000,
-	0b01100000,
-	0b00000000,
-	0b00001100,
-	0b00010000,
-	0b00010000,
-	0b00001100,
 #endif
-#ifdef useAnalogRead
+	if (serialConfigDumpPtr < eeAdrEnd)
+	{
+		buff[0] = 'W';
+		buff[1] = (uint8_t)(serialConfigDumpPtr);
+		buff[2] = (uint8_t)(serialConfigDumpPtr >> 8);
+		for (i = 3; (i < 3 + serialConfigChunkSize) && (serialConfigDumpPtr < eeAdrEnd); i++) buff[(unsigned int)(i)] = eepromReadByte(serialConfigDumpPtr++);
+		serialSendFrame(buff, i);
+	}
+	else
+	{
+		buff[0] = 'E';
+		serialSendFrame(buff, 1);
+		serialConfigStatus &= ~(scsDumping);
+	}
 
-	0b00010001,		// voltage
-	0b00010001,
-	0b00010001,
-	0b00001010,
-	0b00000100,
-	0b00000000,
-	0b00000000,
-	0b00000000,
+	return 1;
+
+}
+
+uint16_t serialConfigImageCRC(void)
+{
+
+	uint16_t crc = 0xFFFF;
+
+	/* the image always carries this build's signature, whatever is in EEPROM right now */
+	for (uint8_t x = 0; x < 3; x++) crc = crc16update(crc, (uint8_t)(newEEPROMsignature >> (16 - 8 * x)));
+	for (unsigned int t = eeAdrSettingsStart; t < eeAdrEnd; t++) crc = crc16update(crc, eepromReadByte(t));
+
+	return crc;
+
+}
+#endif
+
+#ifdef useSerialPort
+unsigned int serialBaudDivisor = 0xFFFF; // what UBRR0 holds - 0xFFFF is past its 12 bits, so the first call always sets it
+
+/*
+ * set the uart baud rate divisor, but only if the setting behind it has changed, and only once whatever was already
+ * queued has gone out at the old rate. with useSerialBaudRate, the uart runs in double speed mode - at 16 MHz, this
+ * gives 0.2% error at 9600 baud, 2.1% at 115200 baud, and exact rates at 250k and 500k baud
+ */
+void serialSetBaudRate(void)
+{
+
+	unsigned int d;
+#ifdef useSerialBaudRate
+	unsigned long b = paramRead(SerialBaudRate);
+
+	if (b < 1200) b = 9600; // slower rates would overflow UBRR0
+	b = ((unsigned long)(processorSpeed) * 125000ul + b / 2) / b;
+	if (b) b--;
+	d = (unsigned int)(b);
+#else
+	d = myubbr;
+#endif
+
+	if (d == serialBaudDivisor) return;
+	serialBaudDivisor = d;
+
+#ifdef useBufferedSerialPort
+	while (!(serialBuffer.bufferStatus & bufferIsEmpty)); // at startup, nothing has been queued yet
+#endif
+	while (!(UCSR0A & (1 << UDRE0)));
+
+	UBRR0H = (uint8_t)(d >> 8);
+	UBRR0L = (uint8_t)(d);
+#ifdef useSerialBaudRate
+	UCSR0A |= (1 << U2X0);
+#else
+	UCSR0A &= ~(1 << U2X0);
+#endif
+
+}
+
+void pushSerialCharacter(uint8_t chr)
+{
+
+#ifdef useBufferedSerialPort
+
+	serialBuffer.push(chr);
+
+#else
+	if (!(UCSR0B & (1 << TXEN0))) UCSR0B |= (1 << TXEN0); // if serial output is not yet enabled, enable it
+
+	while (!(UCSR0A & (1 << UDRE0))); // wait until transmit buffer is empty
+
+	UDR0 = chr; //send the data
+#endif
+
+}
+
+void pushSerialFlash(const char * str)
+{
+
+	while (pgm_read_byte(str)) pushSerialCharacter(pgm_read_byte(str++));
+
+}
+
+#ifdef useBufferedSerialPort
+void serialTransmitEnable(void)
+{
+
+	UCSR0B |= ((1 << TXEN0) | (1 << UDRIE0)); // Enable transmitter and interrupt
+
+}
+
+void serialTransmitDisable(void)
+{
+
+	UCSR0B &= ~((1 << TXEN0) | (1 << UDRIE0)); // Disable transmitter and interrupt
+
+}
+
+void serialTransmitByte(uint8_t s)
+{
+
+	UDR0 = s; // Transmit a byte
+
+}
+
+#endif
+#endif
+
+/* Display cursor update section */
+
+void doCursorMoveAbsolute(uint8_t i, uint8_t j)
+{
+#ifdef useScreenEditor
+
+	if (menuLevel == screenEditIdx) doSaveScreen();
+#endif
+
+	menuLevel = i;
+	if (pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][2]) > j) screenCursor[(unsigned int)(menuLevel)] = j;
+
+	callFuncPointer(&screenParameters[(unsigned int)(menuLevel)][4]);
+
+}
+
+void doCursorMoveRelative(uint8_t i, uint8_t j)
+{
+
+	uint8_t k = 0;
+	uint8_t v;
+	uint8_t w = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][1]);
+	uint8_t x = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][0]);
+	uint8_t y = menuLevel - x;
+	uint8_t z = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][2]);
+#ifdef useScreenEditor
+
+	if (menuLevel == screenEditIdx) doSaveScreen();
+#endif
+
+	if (j)
+	{
+
+		v = screenCursor[(unsigned int)(menuLevel)] + j;
+
+		if (v == z)
+		{
+
+			v = 0;
+			i = j;
+			k = 1;
+
+		}
+		else if (v > z)
+		{
+
+			v = z - 1;
+			i = j;
+			k = 1;
+
+		}
+
+		screenCursor[(unsigned int)(menuLevel)] = v;
+
+	}
+
+	if (i)
+	{
+
+		y += i;
+
+		if (y == w) y = 0;
+		if (y > w) y = w - 1;
+		menuLevel = y + x;
+
+		if (k)
+		{
+
+			if (i == 1) v = 0;
+			else v = pgm_read_byte(&screenParameters[(unsigned int)(menuLevel)][2]) - 1;
+
+			screenCursor[(unsigned int)(menuLevel)] = v;
+
+		}
+
+	}
+
+	doRefreshDisplay(); // call the appropriate display routine
+	callFuncPointer(&screenParameters[(unsigned int)(menuLevel)][4]);
+
+}
+
+void doRefreshDisplay(void)
+{
+
+	gotoXY(0, 0);
+	callFuncPointer(&screenParameters[(unsigned int)(menuLevel)][3]);
+
+}
+
+void doNothing(void)
+{
+}
+
+void doNothing2(uint8_t s)
+{
+}
+
+void noSupport(void)
+{
+
+	initStatusLine();
+	printFlash(PSTR("Btn "));
+	print(itoa((unsigned int)(buttonState), mBuff1, 10));
+	printFlash(PSTR(" Pressed"));
+	execStatusLine();
+
+}
+
+const uint8_t calcLabelCGRAM[] PROGMEM = {
+	0b00000000,		// clock
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000011,
+	0b00000100,
+	0b00000100,
+	0b00000011,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010100,
+	0b00010101,
+	0b00010110,
+	0b00010101,
+
+	0b00010010,		// microseconds
+	0b00010010,
+	0b00010010,
+	0b00011110,
+	0b00010000,
+	0b00110000,
+	0b01000000,
+	0b01100000,
+
+	0b00001110,
+	0b00010000,
+	0b00001100,
+	0b00000010,
+	0b00011100,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+
+	0b00000000,		// pulse count
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000011,
+	0b00000100,
+	0b00000100,
+	0b00000011,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00001000,
+	0b00011100,
+	0b00001000,
+	0b00001000,
+
+	0b00001100,		// revolutions per minute
+	0b00010000,
+	0b00010001,
+	0b00010010,
+	0b00000100,
+	0b00001000,
+	0b00000000,
+	0b00000000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	0b00011011,
+	0b00010101,
+	0b00010101,
+
+	0b00011011,		// miles per gallon
+	0b00010101,
+	0b00010101,
+	0b00000000,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00001100,
+	0b00010000,
+	0b00010100,
+	0b00001100,
+
+	0b00010000,		// liters per 100 km
+	0b00010000,
+	0b00011001,
+	0b00000010,
+	0b00000100,
+	0b00001001,
+	0b00000001,
+	0b00000001,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	0b00011111,
+	0b00010101,
+	0b00011111,
+
+	0b00000000,		// miles
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00010001,
+	0b00011011,
+	0b00010101,
+	0b00010101,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010000,
+	0b00000000,
+	0b00010000,
+	0b00010000,
+
+	0b00000000,		// kilometers
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000100,
+	0b00000101,
+	0b00000110,
+	0b00000101,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	0b00001010,
+	0b00010101,
+	0b00010101,
+
+	0b00011011,		// miles per hour
+	0b00010101,
+	0b00010101,
+	0b00000000,
+	0b00000110,
+	0b00000101,
+	0b00000110,
+	0b00000100,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010100,
+	0b00011100,
+	0b00010100,
+	0b00010100,
+
+	0b00010000,		// kilometers per hour
+	0b00010100,
+	0b00011000,
+	0b00010100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010000,
+	0b00010000,
+	0b00011100,
+	0b00010100,
+
+	0b00000000,		// gallons
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000011,
+	0b00000100,
+	0b00000101,
+	0b00000011,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00000001,
+	0b00000001,
+	0b00011001,
+	0b00011101,
+
+	0b00000000,		// liters
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000100,
+	0b00000100,
+	0b00000100,
+	0b00000111,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+
+	0b00001100,		// gallons per hour
+	0b00010000,
+	0b00010100,
+	0b00001100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010000,
+	0b00010000,
+	0b00011100,
+	0b00010100,
+
+	0b00010000,		// liters per hour
+	0b00010000,
+	0b00010000,
+	0b00011100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010000,
+	0b00010000,
+	0b00011100,
+	0b00010100,
+#ifdef useFuelCost
+
+	0b00100000,		// fuel cost
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00001100,
+	0b00010000,
+	0b00010000,
+	0b00001100,
+
+	0b00000010,
+	0b00000101,
+	0b00000100,
+	0b00001110,
+	0b00000100,
+	0b00000100,
+	0b00000100,
+	0b00000100,
+
+	0b00001100,		// fuel cost rate
+	0b00010000,
+	0b00010000,
+	0b00001100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010000,
+	0b00010000,
+	0b00011100,
+	0b00010100,
+
+	0b00001100,		// fuel cost per mile
+	0b00010000,
+	0b00010000,
+	0b00001100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010001,
+	0b00011011,
+	0b00010101,
+	0b00010101,
+
+	0b00001100,		// fuel cost per kilometer
+	0b00010000,
+	0b00010000,
+	0b00001100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00010000,
+	0b00010100,
+	0b00011000,
+	0b00010100,
+
+	0b00011011,		// mile per unit fuel cost
+	0b00010101,
+	0b00010101,
+	0b00000000,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00001100,
+	0b00010000,
+	0b00010000,
+	0b00001100,
+
+	0b00010000,		// kilometer per unit fuel cost
+	0b00010100,
+	0b00011000,
+	0b00010100,
+	0b00000001,
+	0b00000010,
+	0b00000100,
+	0b00001000,
+
+	0b00100000,
+	0b01000000,
+	0b01100000,
+	0b00000000,
+	0b00001100,
+	0b00010000,
+	0b00010000,
+	0b00001100,
+#endif
+#ifdef useAnalogRead
+
+	0b00010001,		// voltage
+	0b00010001,
+	0b00010001,
+	0b00001010,
+	0b00000100,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00010001,
+	0b00011010,
+	0b00011010,
+	0b00010001,
+#endif
+#ifdef useChryslerMAPCorrection
+
+	0b00001110,		// psi
+	0b00001001,
+	0b00001001,
+	0b00001110,
+	0b00001000,
+	0b00001000,
+	0b00001000,
+	0b00000000,
+
+	0b00001001,
+	0b00010101,
+	0b00010001,
+	0b00001001,
+	0b00000101,
+	0b00010101,
+	0b00001001,
+	0b00000000,
+
+	0b00001000,		// kPa
+	0b00001000,
+	0b00001001,
+	0b00001010,
+	0b00001100,
+	0b00001010,
+	0b00001001,
+	0b00000000,
+
+	0b00011000,
+	0b00010100,
+	0b00010100,
+	0b00011000,
+	0b00010010,
+	0b00010101,
+	0b00010011,
+	0b00000000,
+
+	0b00000000,		// correction factor
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+#endif
+};
+
+const uint8_t calcLabelTrip[] PROGMEM = {
+	0b00000000,
+	0b00000000,
+	0b00000000,
+	0b00000000,
+
+	0b00000011,
+	0b00000111,
+	0b00000011,
+	0b00000111,
+
+	0b00000100,
+	0b00000010,
+	0b00000100,
+	0b00000010,
+
+	0b00000100,
+	0b00000111,
+	0b00000011,
+	0b00000010,
+};
+
+void displayMainScreenFunction(uint8_t readingIdx, uint8_t k, uint8_t functBlink, uint8_t tripBlink)
+{
+
+	readingIdx &= 3;
+	uint8_t x = (readingIdx & 1) << 3;
+	uint8_t y = (readingIdx & 2) >> 1;
+	uint8_t z = readingIdx << 1;
+
+	uint8_t r = (k & dfTripMask) >> dfBitShift;
+	uint8_t f = k & dfValMask;
+
+	uint8_t j = pgm_read_byte(&calcLabelIdx[(unsigned int)(f)]);
+	if ((j & 128) && (metricFlag)) j += 2;
+	j &= 127;
+
+	writeCGRAMlabelChar(z, j, r, functBlink, tripBlink);
+	writeCGRAMlabelChar(z + 1, j + 1, r, functBlink, tripBlink);
+
+	gotoXY(x, y);
+	print(doFormat(k, 0));
+	charOut(8 + z);
+	charOut(9 + z);
+
+}
+
+void writeCGRAMlabelChar(uint8_t cgChar, uint8_t functIdx, uint8_t tripIdx, uint8_t functBlink, uint8_t tripBlink)
+{
+
+	uint8_t i = 0x1F;
+	uint8_t j = 0x1F;
+	unsigned int k = (unsigned int)(functIdx << 3);
+	if (timerHeartBeat & tripBlink) j = 0; // determine if trip label component should blink or not
+	if (timerHeartBeat & functBlink) i = 0; // determine if function label component should blink or not
+	tripIdx &= 3; // strip off unnecessary bits of trip index
+
+	for (uint8_t x = 0; x < 8; x++)
+	{
+
+		 uint8_t l = pgm_read_byte(&calcLabelCGRAM[(unsigned int)(k++)]); // read a byte of function label bit pattern
+		 uint8_t m = l >> 3; // fetch partial address of trip label component
+		 m &= 0b00001100; // strip off un-needed bits
+		 m |= tripIdx; // combine with trip index to form full address of trip label component
+		 m = pgm_read_byte(&calcLabelTrip[(unsigned int)(m)]); // read a byte of trip label bit pattern
+		 l &= i; // provide for blinking function label component
+		 m &= j; // provide for blinking trip label component
+		 mBuff1[(unsigned int)(x)] = l | m; // combine trip label and function label components
+
+	}
+
+	cgramMode = 0; // reset CGRAM mode
+	LCD::loadCGRAMcharacter(cgChar, (const char *)(mBuff1), 0); // write out generated CGRAM character
+
+}
+
+/* Main screen section */
+const char mainScreenFuncNames[] PROGMEM = {
+	"Instrument\0"
+	"Custom\0"
+#ifdef useChryslerMAPCorrection
+	"Pressures\0"
+#endif
+#ifdef useAnalogRead
+	"Voltages\0"
+#endif
+	"Instant/Current\0"
+	"Instant/Tank\0"
+	"Current\0"
+	"Tank\0"
+#ifdef trackIdleEOCdata
+	"EOC/Idle\0"
+#endif
+	"Tank Data\0"
+	"Current Data\0"
+#ifdef trackIdleEOCdata
+	"Tank EOC/Idle\0"
+	"Current EOC/Idle\0"
+#endif
+	"Remaining\0"
+};
+
+void doCursorUpdateMain(void)
+{
+	/* briefly display screen name */
+	printStatusMessage(findStr(mainScreenFuncNames,
+	    screenCursor[mainScreenIdx]));
+}
+
+void doMainScreenDisplay(void)
+{
+	uint8_t i = screenCursor[mainScreenIdx];
+	uint8_t x, k;
+
+	i <<= 2;
+
+	for (x = 0; x < 4; x++)
+	{
+#ifdef useScreenEditor
+		k = displayFormats[i++];
+#else
+		k = pgm_read_byte(&displayFormats[i++]);
+#endif
+		displayMainScreenFunction(x, k, 0, 136);
+	}
+}
+
+void doNextBright(void)
+{
+	brightnessIdx++;
+	if (brightnessIdx >= brightnessLength)
+		brightnessIdx = 0;
+	LCD::setBright(brightnessIdx);
+
+	initStatusLine();
+	printFlash(PSTR("Backlight = "));
+	printStr(brightString, brightnessIdx);
+	execStatusLine();
+}
+
+void doLongGoLeft(void)
+{
+	doCursorMoveRelative(255, 0);
+}
+
+void doLongGoRight(void)
+{
+	doCursorMoveRelative(1, 0);
+}
+
+void doTripResetTank(void)
+{
+#ifdef useFillUpHistory
+	fillUpAppend();
+#endif
+	tripArray[tankIdx].reset();
+#ifdef trackIdleEOCdata
+	tripArray[eocIdleTankIdx].reset();
+#endif
+#ifdef useBarFuelEconVsSpeed
+	doResetBarFEvS();
+#endif
+	printStatusMessage(PSTR("Tank Reset"));
+}
+
+#ifdef useFillUpHistory
+/*
+ * every tank reset appends a fill-up record to a small ring in EEPROM:
+ *
+ *   0-1  : sequence number, big endian
+ *   2    : guinosig, with bit 0 replaced by the metric flag
+ *   3-4  : CRC of everything else in the record
+ *   5-8  : timestamp, in seconds
+ *   9-12 : distance travelled, times 1000
+ *   13-16: fuel used, times 1000
+ *   17-20: engine run time, in seconds
+ *   21-24: fuel used while idling or coasting, times 1000
+ *
+ * the oldest record is the one that gets overwritten. doFillUpDump() sends
+ * the ring out as CSV, and tools/mpgfillups.py merges those dumps into a
+ * long-term history on the host
+ */
+const uint8_t prgmFillUpFuelEcon[] PROGMEM = {
+	instrSkipIfMetricMode, 7,				// if metric mode set, skip ahead
+	instrSwap, 0x23,					// swap the fuel used and distance terms around
+	instrLdConst, 0x01, idxDecimalPoint,			// load the decimal point constant used for output formatting
+	instrSkip, 3,						// go skip ahead
+
+	instrLdConst, 0x01, idxMetricFE,			// load the output formatting decimal point constant, multiplied by 100 (for 100km/L)
+
+	instrSkipIfZero, 0x02, 6,				// if the numerator term is zero, go exit
+
+	instrCall, idxS64doMultiply,				// multiply the numerator by the formatting term
+	instrSwap, 0x13,					// move the denominator term into position
+	instrJump, idxS64doDivide,				// divide the numerator by the denominator, then exit to caller
+
+	instrDone						// exit to caller
+};
+
+const uint8_t fillUpCalcList[] PROGMEM = {
+	tDistance,
+	tFuelUsed,
+	tEngineRunTime,
+};
+
+const uint8_t fUCLsize = (sizeof(fillUpCalcList) / sizeof(uint8_t));
+
+unsigned int fillUpGetAddress(uint8_t r)
+{
+	return eeAdrFillUpStart + (unsigned int)(r) * (unsigned int)(fillUpRecordSize);
+}
+
+uint16_t fillUpCRC(uint8_t r)
+{
+	unsigned int t = fillUpGetAddress(r);
+	uint16_t crc = 0xFFFF;
+
+	for (uint8_t x = 0; x < fillUpRecordSize; x++)
+	{
+		if ((x == 3) || (x == 4)) continue; // skip over the stored CRC
+		crc = crc16update(crc, eepromReadByte(t + x));
+	}
+
+	return crc;
+}
+
+uint8_t fillUpIsValid(uint8_t r)
+{
+	unsigned int t = fillUpGetAddress(r);
+	uint16_t crc;
+
+	if ((eepromReadByte(t + 2) | 1) != (guinosig | 1)) return 0;
+
+	crc = (uint16_t)(eepromReadByte(t + 3)) << 8;
+	crc += (uint16_t)(eepromReadByte(t + 4));
+
+	return (crc == fillUpCRC(r));
+}
+
+uint8_t fillUpFindNewest(void)
+{
+	unsigned int t;
+	uint16_t v;
+	uint16_t w = 0;
+	uint8_t newest = fillUpNoRecord;
+
+	for (uint8_t r = 0; r < fillUpCount; r++)
+	{
+		if (fillUpIsValid(r) == 0) continue;
+
+		t = fillUpGetAddress(r);
+		v = (uint16_t)(eepromReadByte(t)) << 8;
+		v += (uint16_t)(eepromReadByte(t + 1));
+
+		/* sequence numbers in the ring are all close together, so this copes with wraparound */
+		if ((newest == fillUpNoRecord) || ((int16_t)(v - w) > 0))
+		{
+			newest = r;
+			w = v;
+		}
+	}
+
+	return newest;
+}
+
+void fillUpAppend(void)
+{
+	unsigned long v[5];
+	unsigned int t;
+	uint16_t w = 0;
+	uint16_t crc;
+	uint8_t r;
+#ifndef useClock
+	unsigned long outputCycles[2];
+
+	cli(); // perform atomic transfer of clock to main program
+
+	outputCycles[0] = systemCycles[0]; // perform atomic transfer of system time to main program
+	outputCycles[1] = systemCycles[1];
+
+	sei();
+#endif
+
+	v[0] = convertTime(outputCycles);
+	for (uint8_t x = 0; x < fUCLsize; x++)
+		v[x + 1] = doCalculate(pgm_read_byte(&fillUpCalcList[(unsigned int)(x)]), tankIdx);
+#ifdef trackIdleEOCdata
+	v[4] = doCalculate(tFuelUsed, eocIdleTankIdx);
+#else
+	v[4] = 0;
+#endif
+
+	if ((v[1] == 0) && (v[2] == 0)) return; // nothing to remember about an empty tank
+
+	r = fillUpFindNewest();
+	if (r != fillUpNoRecord)
+	{
+		t = fillUpGetAddress(r);
+		w = (uint16_t)(eepromReadByte(t)) << 8;
+		w += (uint16_t)(eepromReadByte(t + 1));
+		w++;
+		r++;
+		if (r == fillUpCount) r = 0;
+	}
+	else r = 0;
+
+	t = fillUpGetAddress(r);
+
+	eepromWriteByte(t++, (uint8_t)(w >> 8));
+	eepromWriteByte(t++, (uint8_t)(w & 0xFF));
+	eepromWriteByte(t, (guinosig & 0xFE) | (metricFlag ? 1 : 0));
+	t += 3;
+
+	for (uint8_t x = 0; x < 5; x++)
+		for (uint8_t y = 0; y < 4; y++)
+			eepromWriteByte(t++, (uint8_t)(v[(unsigned int)(x)] >> (24 - 8 * y)));
+
+	crc = fillUpCRC(r);
+	t = fillUpGetAddress(r) + 3;
+	eepromWriteByte(t++, (uint8_t)(crc >> 8));
+	eepromWriteByte(t, (uint8_t)(crc & 0xFF));
+}
+
+void fillUpPushNumber(unsigned long v, uint8_t dp)
+{
+	char * s = format64(prgmFormatToNumber, v, mBuff1, 0);
+	char c;
+
+	for (uint8_t x = 0; x < 10; x++)
+	{
+		c = s[(unsigned int)(x)];
+		if ((c == ' ') && (x + dp >= 9)) c = '0'; // values below 1 still need their leading zero
+		if (c != ' ') pushSerialCharacter(c);
+		if ((dp) && (x + dp == 9)) pushSerialCharacter('.');
+	}
+}
+
+void doFillUpDump(void)
+{
+	unsigned long v[5];
+	unsigned long ttl[5];
+	unsigned int t;
+	uint8_t r = fillUpFindNewest();
+	uint8_t n = 0;
+	uint8_t b;
+
+	for (uint8_t x = 0; x < 5; x++) ttl[(unsigned int)(x)] = 0;
+
+	pushSerialFlash(PSTR("\nseq,units,time,distance,fuel,engine time,idle fuel,fuel economy\n"));
+
+	/* oldest record first */
+	for (uint8_t y = 0; (y < fillUpCount) && (r != fillUpNoRecord); y++)
+	{
+		r++;
+		if (r == fillUpCount) r = 0;
+
+		if (fillUpIsValid(r) == 0) continue;
+
+		t = fillUpGetAddress(r);
+		fillUpPushNumber(((unsigned long)(eepromReadByte(t)) << 8) + (unsigned long)(eepromReadByte(t + 1)), 0);
+		b = eepromReadByte(t + 2) & 1;
+		pushSerialFlash((b) ? PSTR(",metric,") : PSTR(",SAE,"));
+		t += 5;
+
+		for (uint8_t x = 0; x < 5; x++)
+		{
+			v[(unsigned int)(x)] = 0;
+			for (uint8_t z = 0; z < 4; z++)
+				v[(unsigned int)(x)] = (v[(unsigned int)(x)] << 8) + (unsigned long)(eepromReadByte(t++));
+
+			fillUpPushNumber(v[(unsigned int)(x)], (((x == 0) || (x == 3)) ? 0 : 3));
+			pushSerialCharacter(',');
+		}
+
+		/* fuel economy only makes sense in the units currently selected */
+		if (b == (metricFlag ? 1 : 0))
+		{
+			for (uint8_t x = 1; x < 5; x++)
+				ttl[(unsigned int)(x)] += v[(unsigned int)(x)];
+			n++;
+
+			if ((v[1]) && (v[2]))
+			{
+				init64(tempPtr[1], v[2]);
+				init64(tempPtr[2], v[1]);
+				fillUpPushNumber(SWEET64(prgmFillUpFuelEcon, 0), 3);
+			}
+		}
+
+		pushSerialCharacter('\n');
+	}
+
+	/* long-term figures, across every fill-up in the current units */
+	pushSerialFlash(PSTR("total,"));
+	fillUpPushNumber(n, 0);
+	pushSerialFlash(PSTR(",,"));
+	for (uint8_t x = 1; x < 5; x++)
+	{
+		fillUpPushNumber(ttl[(unsigned int)(x)], ((x == 3) ? 0 : 3));
+		pushSerialCharacter(',');
+	}
+	if ((ttl[1]) && (ttl[2]))
+	{
+		init64(tempPtr[1], ttl[2]);
+		init64(tempPtr[2], ttl[1]);
+		fillUpPushNumber(SWEET64(prgmFillUpFuelEcon, 0), 3);
+	}
+	pushSerialCharacter('\n');
+
+	printStatusMessage(PSTR("Fill-Ups Sent"));
+}
+
+#endif
+void doTripResetCurrent(void)
+{
+	tripArray[currentIdx].reset();
+#ifdef trackIdleEOCdata
+	tripArray[eocIdleCurrentIdx].reset();
+#endif
+	printStatusMessage(PSTR("Current Reset"));
+}
+
+/* Setting selector section */
+void doCursorUpdateSetting(void)
+{
+	paramPtr = screenCursor[settingScreenIdx] +
+	    (uint8_t)(eePtrSettingsStart);
+	doParamRevert();
+}
+
+void doSettingEditDisplay(void)
+{
+	/* print parameter name at top left */
+	printStr(parmLabels, screenCursor[settingScreenIdx]);
+	clrEOL();
+	/* go to next line */
+	gotoXY(0, 1);
+	print(pBuff);
+	clrEOL();
+}
+
+void doGoSettingsEdit(void)
+{
+	prevMenuLevel = menuLevel;
+	doCursorMoveAbsolute(settingScreenIdx, 0);
+}
+
+void doReturnToMain(void)
+{
+	menuLevel = prevMenuLevel;
+}
+
+/* Individual parameter editor section */
+void doParamEditDisplay(void)
+{
+	/* print parameter name at top left */
+	printStr(parmLabels, screenCursor[settingScreenIdx]);
+	clrEOL();
+	/* go to next line */
+	gotoXY(0, 1);
+
+	/* save existing character */
+	uint8_t c = pBuff[screenCursor[paramScreenIdx]];
+
+	/* replace character with an underscore */
+	if ((timerHeartBeat & 0b01010101) &&
+	    (screenCursor[paramScreenIdx] < 10))
+		pBuff[screenCursor[paramScreenIdx]] = '_';
+
+	/* print number */
+	print(pBuff);
+	pBuff[screenCursor[paramScreenIdx]] = c;
+
+	blinkFlash(&paramButtonChars[0], (screenCursor[paramScreenIdx] == 10));
+	blinkFlash(&paramButtonChars[4], (screenCursor[paramScreenIdx] == 11));
+}
+
+void doGoParamEdit(void)
+{
+	paramLength = pgm_read_byte(
+	    &paramsLength[screenCursor[settingScreenIdx]]);
+	paramMaxValue = (1 << paramLength);
+	paramMaxValue -= 1;
+
+	menuLevel = paramScreenIdx;
+	format64(prgmFormatToNumber, paramMaxValue, mBuff2, 3);
+	doParamFindLeft();
+}
+
+void doParamExit(void)
+{
+	doParamRevert();
+	generalMenuLevelReturn(PSTR("Param Reverted"), settingScreenIdx);
+}
+
+#ifdef useCalculatedFuelFactor
+const uint8_t prgmCalculateFuelFactor[] PROGMEM = {
+	instrLdConst, 0x02, idxCorrFactor,
+	instrMulByEEPROM, pSysFuelPressureIdx,
+	instrDivByEEPROM, pRefFuelPressureIdx,
+	instrIsqrt, 0x02,
+	instrMulByEEPROM, pInjectorCountIdx,
+	instrMulByEEPROM, pInjectorSizeIdx,
+	instrSkipIfMetricMode, 4,
+
+	instrMulByConst, idxNumerVolume,
+	instrDivByConst, idxDenomVolume,
+
+	instrSwap, 0x23,
+	/* load seconds per minute into register 2 */
+	instrLdByte, 0x02, 60,
+	instrMulByConst, idxMicroSecondsPerSecond,
+	instrMulByConst, idxDecimalPoint,
+	instrMulByConst, idxCorrFactor,
+	instrSwap, 0x13,
+	instrCall, idxS64doDivide,
+	instrStEEPROM, 0x02, pMicroSecondsPerQuantityIdx,
+	instrDone
+};
+#endif
+
+const uint8_t prgmDoEEPROMmetricConversion[] PROGMEM = {
+	instrLdIndex, 0,
+
+	instrLdEEPROMindirect, 0x02,
+
+	instrSkipIfMetricMode, 6,
+	instrLdNumer, 0x01,
+	instrLdDenom, 0x03,
+	instrSkip, 4,
+
+	instrLdNumer, 0x03,
+	instrLdDenom, 0x01,
+
+	instrCall, idxS64doMultiply,
+	instrSwap, 0x31,
+	instrCall, idxS64doDivide,
+	instrCall, idxS64doAdjust,
+	instrStEEPROMindirect, 0x02,
+	instrAddToIndex, 1,
+	instrSkipIfIndexBelow, 227, convSize,
+
+	instrDone
+};
+
+void doParamSave(void)
+{
+	/* if the setting has changed */
+	if (eepromWriteVal((unsigned int)(paramPtr), rformat()))
+	{
+#ifdef useBarFuelEconVsSpeed
+		if ((paramPtr == pBarLowSpeedCutoffIdx) ||
+		    (paramPtr == pBarSpeedQuantumIdx) ||
+		    (paramPtr == pBarSpeedLogIdx))
+			doResetBarFEvS();
+#endif
+		/* if metric flag has changed */
+		if (paramPtr == pMetricFlagIdx)
+			SWEET64(prgmDoEEPROMmetricConversion, 0);
+#ifdef useCalculatedFuelFactor
+		/*
+		 * if fuel pressure, reference pressure, injector count,
+		 * or injector size changed calculate and store microseconds
+		 * per gallon factor
+		 */
+		if ((paramPtr == pSysFuelPressureIdx) ||
+		    (paramPtr == pRefFuelPressureIdx) ||
+		    (paramPtr == pInjectorCountIdx) ||
+		    (paramPtr == pInjectorSizeIdx))
+			SWEET64(prgmCalculateFuelFactor, 0);
+#endif
+		/* reconfigure system based on changed settings */
+		initGuino();
+		generalMenuLevelReturn(PSTR("Param Changed"), settingScreenIdx);
+	}
+	else
+	{
+		generalMenuLevelReturn(PSTR("Param Unchanged"),
+		    settingScreenIdx);
+	}
+}
+
+void generalMenuLevelReturn(const char * s, uint8_t newMenuLevel)
+{
+	menuLevel = newMenuLevel;
+	printStatusMessage(s);
+}
+
+void printStatusMessage(const char * s)
+{
+	initStatusLine();
+	printFlash(s);
+	execStatusLine();
+}
+
+void doParamFindLeft(void)
+{
+	uint8_t x;
+
+	screenCursor[paramScreenIdx] = 9;
+
+	/*
+	 * do a nice thing and put the edit cursor at the first non zero number
+	 */
+	for (x = 9; x < 10; x--)
+		if (pBuff[x] != ' ')
+			screenCursor[paramScreenIdx] = x;
+}
+
+void doParamFindRight(void)
+{
+	screenCursor[paramScreenIdx] = 9;
+}
+
+void doParamStoreMax(void)
+{
+	doParamStoreNumber(paramMaxValue);
+}
+
+void doParamStoreMin(void)
+{
+	doParamStoreNumber(0);
+}
+
+void doParamRevert(void)
+{
+	doParamStoreNumber(eepromReadVal((unsigned int)(paramPtr)));
+}
+
+void doParamStoreNumber(unsigned long v)
+{
+	format64(prgmFormatToNumber, v, pBuff, 3);
+#ifdef useLegacyLCD
+	/* adjust contrast dynamically */
+	if (paramPtr == pContrastIdx)
+		LCD::setContrast((uint8_t)(v));
+#endif
+	doParamFindLeft();
+}
+
+void doParamReformat(void)
+{
+
+	uint8_t c = '0';
+	uint8_t d = ' ';
+	uint8_t x;
+
+	for (x = 0; x < 9; x++)
+	{
+
+		if (pBuff[x] == c)
+		{
+			pBuff[x] = d;
+		}
+		else if ((c == '0') && (pBuff[x] != ' '))
+		{
+			c = ' ';
+			d = '0';
+		}
+	}
+
+	if (pBuff[9] == ' ')
+		pBuff[9] = '0';
+}
+
+void doParamChangeDigit(void)
+{
+	uint8_t w, x;
+
+	if (screenCursor[paramScreenIdx] == 10)
+	{
+		doParamSave();
+	}
+	else if (screenCursor[paramScreenIdx] == 11)
+	{
+		doParamExit();
+	}
+	else
+	{
+		if (paramLength == 1)
+		{
+			pBuff[screenCursor[paramScreenIdx]] ^= 1;
+		}
+		else
+		{
+			/*
+			 * fetch digit from stored numeric string representing
+			 * parameter to be changed
+			 */
+			w = pBuff[screenCursor[paramScreenIdx]];
+			/* if this is a leading space, use 0 as working digit */
+			if (w == ' ')
+				w = '0';
+			/* adjust working digit */
+			w++;
+			/* handle working digit rollover */
+			if (w > '9')
+				w = '0';
+
+			pBuff[screenCursor[paramScreenIdx]] = w;
+			doParamReformat();
+
+			for (x = 0; x < 10; x++)
+			{
+				if (pBuff[x] < mBuff2[x])
+				{
+					x = 10;
+				}
+				else if (pBuff[x] > mBuff2[x])
+				{
+					x = 10;
+					pBuff[screenCursor[paramScreenIdx]] =
+					    '0';
+					doParamReformat();
+				}
+			}
+#ifdef useLegacyLCD
+			/* adjust contrast dynamically */
+			if (paramPtr == pContrastIdx)
+				LCD::setContrast((uint8_t)(rformat()));
+#endif
+		}
+	}
+}
+
+/* large Fuel Economy display support section */
+#ifdef useBigFE
+void doCursorUpdateBigFEscreen(void)
+{
+	displayBigStatus(bigFEscreenIdx, PSTR(" Fuel Econ"));
+}
+
+void doBigFEdisplay(void)
+{
+	uint8_t dIdx = fedSelect(bigFEscreenIdx);
+
+	displayBigNumber(doFormat(dIdx, tFuelEcon, dispFE));
+
+	printStr(bigFEDispChars, dIdx);
+	gotoXY(12, 1);
+	printFlash(PSTR("{MPG \\L100}"));
+}
+#endif
+
+/* large Distance-To-Empty display support section */
+#ifdef useBigDTE
+void doCursorUpdateBigDTEscreen(void)
+{
+	displayBigStatus(bigDTEscreenIdx, PSTR(" DistToEmpty"));
+}
+
+void doBigDTEdisplay(void)
+{
+	displayBigNumber(doFormat(fedSelect(bigDTEscreenIdx), tDistanceToEmpty,
+	    dispDTE));
+}
+#endif
+
+/* large Time-To-Empty display support section */
+#ifdef useBigTTE
+void doCursorUpdateBigTTEscreen(void)
+{
+  	displayBigStatus(bigTTEscreenIdx, PSTR(" TimeToEmpty"));
+}
+
+void doBigTTEdisplay(void)
+{
+	displayBigTime(format64(prgmFormatToTime,
+	    SWEET64(prgmTimeToEmpty, fedSelect(bigTTEscreenIdx)), mBuff1, 3),
+	    4);
+}
+#endif
+
+/* Clock support section */
+#ifdef useClock
+void doCursorUpdateSystemTimeScreen(void)
+{
+	printStatusMessage(PSTR("System Time"));
+}
+
+/* display system time */
+void doDisplaySystemTime(void)
+{
+	displayBigTime(format64(prgmFormatToTime, convertTime(outputCycles),
+	    mBuff1, 3), 4);
+}
+
+void doGoEditSystemTime(void)
+{
+	/* convert system time from ticks into seconds, and format for output */
+	format64(prgmFormatToTime, convertTime(outputCycles), pBuff, 3);
+	doCursorMoveAbsolute(systemTimeEditScreenIdx, 0);
+}
+
+void doEditSystemTimeDisplay(void)
+{
+	displayBigTime(pBuff, screenCursor[systemTimeEditScreenIdx]);
+}
+
+void doEditSystemTimeChangeDigit(void)
+{
+	pBuff[screenCursor[systemTimeEditScreenIdx]]++;
+	if (pBuff[screenCursor[systemTimeEditScreenIdx]] > '9')
+		pBuff[screenCursor[systemTimeEditScreenIdx]] = '0';
+
+	/* this will only happen if systemTimeEditScreenIdx == 2 */
+	if (pBuff[2] > '5') pBuff[2] = '0';
+	/* this will only happen if systemTimeEditScreenIdx == 0 or 1 */
+	if ((pBuff[0] == '2') && (pBuff[1] > '3')) pBuff[1] = '0';
+	/* this will only happen if systemTimeEditScreenIdx == 0 */
+	if (pBuff[0] > '2') pBuff[0] = '0';
+}
+
+const uint8_t prgmConvertToCycles[] PROGMEM = {
+	instrDivByConst, idxCyclesPerSecond,
+	instrDivByConst, idxSecondsPerDay,
+
+	instrLdIndex, 0,
+	instrMulByByte, 24,
+	instrLdByteFromYindexed, 0x13,
+	instrAddYtoX, 0x21,
+
+	instrLdIndex, 2,
+	instrMulByByte, 60,
+	instrLdByteFromYindexed, 0x13,
+	instrAddYtoX, 0x21,
+
+	instrLdIndex, 4,
+	instrMulByByte, 60,
+	instrLdByteFromYindexed, 0x13,
+	instrAddYtoX, 0x21,
+
+	instrMulByConst, idxCyclesPerSecond,
+	instrDone
+};
+
+void doEditSystemTimeSave(void)
+{
+	uint8_t b, x;
+
+	pBuff[4] = '0';
+	pBuff[5] = '0';
+
+	copy64(tempPtr[1], (union union_64 *)&outputCycles);
+
+	for ( x = 4; x < 6; x -= 2)
+	{
+		b = pBuff[x] - '0';
+		b *= 10;
+		b += pBuff[x + 1] - '0';
+		tempPtr[2]->u8[x] = b;
+	}
+
+	/* convert time into timer2 clock cycles */
+	SWEET64(prgmConvertToCycles, 0);
+
+	cli();
+	copy64((union union_64 *)&clockCycles, tempPtr[1]);
+	sei();
+
+	generalMenuLevelReturn(PSTR("Time Set"), systemTimeDisplayScreenIdx);
+}
+
+void doEditSystemTimeCancel(void)
+{
+	generalMenuLevelReturn(PSTR("Time NOT Set"),
+	    systemTimeDisplayScreenIdx);
+}
+#endif
+
+/* (parameter) vs. Speed Bar Graph display section */
+#ifdef useBarFuelEconVsSpeed
+void doCursorUpdateBarFEvS(void)
+{
+	uint8_t b = pgm_read_byte(
+	    &barFEvSdisplayFuncs[screenCursor[barFEvSscreenIdx]]);
+
+	for (uint8_t x = 0; x < bgDataSize; x++)
+	{
+		loadBarFEvS(x);
+		barGraphData[bgDataSize - x - 1] = doCalculate(b, FEvsSpeedIdx);
+	}
+
+	/* briefly display screen name */
+	printStatusMessage(findStr(barFEvSfuncNames,
+	    screenCursor[barFEvSscreenIdx]));
+}
+
+void doBarFEvSdisplay(void)
+{
+	uint8_t b = pgm_read_byte(
+	    &barFEvSdisplayFuncs[screenCursor[barFEvSscreenIdx]]);
+
+	if (FEvSpdBinIdx < 255)
+	{
+		loadBarFEvS(FEvSpdBinIdx);
+		barGraphData[bgDataSize - FEvSpdBinIdx - 1] =
+		    doCalculate(b, FEvsSpeedIdx);
+	}
+
+	formatBarGraph(bgDataSize, FEvSpdBinIdx, 0, doCalculate(b, tankIdx));
+
+	displayBarGraph(((FEvSpdBinIdx < 255) ? FEvsSpeedIdx : 255), b,
+	    ((timerHeartBeat & 0b00110011) ? tankIdx : instantIdx),
+	    ((timerHeartBeat & 0b00110011) ? b : tSpeed));
+}
+
+void doResetBarFEvS(void)
+{
+	for (uint8_t x = 0; x < bgDataSize; x++)
+	{
+		FEvSpdPulses[(unsigned int)(x)] = 0;
+		FEvSpdCycles[(unsigned int)(x)] = 0;
+		FEvSpdFuel[(unsigned int)(x)] = 0;
+	}
+}
+
+void initBarFEvS(void) // build the speed bin edge table from the bargraph settings
+{
+	unsigned long e = paramRead(BarLowSpeedCutoff);
+	unsigned long q = paramRead(BarSpeedQuantum);
+	unsigned long f;
+	uint8_t logFlag = (uint8_t)paramRead(BarSpeedLog);
+
+	for (uint8_t x = 0; x <= bgDataSize; x++)
+	{
+		if (logFlag)
+		{
+			/* the span is under 2^28, so split it to keep the products in 32 bits */
+			f = pgm_read_word(&FEvSpdLogEdges[(unsigned int)(x)]);
+			FEvSpdEdge[(unsigned int)(x)] = e + ((q * bgDataSize) >> 10) * f
+			    + ((((q * bgDataSize) & 1023) * f) >> 10);
+		}
+		else FEvSpdEdge[(unsigned int)(x)] = e + q * x;
+	}
+}
+
+unsigned long FEvSpdSum(unsigned long a, unsigned long v) // saturating add
+{
+	a += v;
+	if (a < v) a = 0xFFFFFFFF;
+
+	return a;
+}
+
+void updateBarFEvS(void) // find the speed bin for this loop's instant trip, and add the instant trip to it
+{
+	unsigned long s = SWEET64(prgmSpeed, instantIdx);
+	uint8_t x;
+
+	FEvSpdBinIdx = 255;
+
+	if (s < FEvSpdEdge[0]) return;
+	for (x = 0; x < bgDataSize; x++)
+		if (s < FEvSpdEdge[(unsigned int)(x + 1)]) break;
+	if (x == bgDataSize) return;
+
+	FEvSpdBinIdx = x;
+
+	/* a single loop's worth of cycles fits in the lower 32 bits */
+	FEvSpdPulses[(unsigned int)(x)] = FEvSpdSum(FEvSpdPulses[(unsigned int)(x)],
+	    tripArray[instantIdx].collectedData[rvVSSpulseIdx]);
+	FEvSpdCycles[(unsigned int)(x)] = FEvSpdSum(FEvSpdCycles[(unsigned int)(x)],
+	    (tripArray[instantIdx].collectedData[rvVSScycleIdx]
+	    + (1ul << (FEvSpdCycleShift - 1))) >> FEvSpdCycleShift);
+	FEvSpdFuel[(unsigned int)(x)] = FEvSpdSum(FEvSpdFuel[(unsigned int)(x)],
+	    (tripArray[instantIdx].collectedData[rvInjOpenCycleIdx]
+	    + (1ul << (FEvSpdFuelShift - 1))) >> FEvSpdFuelShift);
+}
+
+void loadBarFEvS(uint8_t binIdx) // unpack a speed bin into the FE vs speed scratch trip, so the usual calculations work on it
+{
+	unsigned long * d = tripArray[FEvsSpeedIdx].collectedData;
+	unsigned long v;
+
+	tripArray[FEvsSpeedIdx].reset();
+
+	d[rvVSSpulseIdx] = FEvSpdPulses[(unsigned int)(binIdx)];
+
+	v = FEvSpdCycles[(unsigned int)(binIdx)];
+	d[rvVSScycleIdx] = v << FEvSpdCycleShift;
+	d[rvVSScycleIdx + 1] = v >> (32 - FEvSpdCycleShift);
 
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00010001,
-	0b00011010,
-	0b00011010,
-	0b00010001,
+	v = FEvSpdFuel[(unsigned int)(binIdx)];
+	d[rvInjOpenCycleIdx] = v << FEvSpdFuelShift;
+	d[rvInjOpenCycleIdx + 1] = v >> (32 - FEvSpdFuelShift);
+}
 #endif
-#ifdef useChryslerMAPCorrection
 
-	0b00001110,		// psi
-	0b00001001,
-	0b00001001,
-	0b00001110,
-	0b00001000,
-	0b00001000,
-	0b00001000,
-	0b00000000,
+/* Differential/Absolute Fuel Economy vs. Time display section */
+#ifdef useBarFuelEconVsTime
+void doResetBarFEvT(void)
+{
+	tripArray[periodIdx].reset();
+	bFEvTcount = 0;
+	bFEvTstartIDx = 0;
+	bFEvTsize = 0;
+}
 
-	0b00001001,
-	0b00010101,
-	0b00010001,
-	0b00001001,
-	0b00000101,
-	0b00010101,
-	0b00001001,
-	0b00000000,
+void doCursorUpdateBarFEvT(void)
+{
+	/* briefly display screen name */
+	printStatusMessage(findStr(barFEvTfuncNames,
+	    screenCursor[barFEvTscreenIdx]));
+}
 
-	0b00001000,		// kPa
-	0b00001000,
-	0b00001001,
-	0b00001010,
-	0b00001100,
-	0b00001010,
-	0b00001001,
-	0b00000000,
+void doBarFEvTdisplay(void)
+{
+	uint8_t i = 0;
+	uint8_t j = bFEvTstartIDx;
+	unsigned long v = doCalculate(tFuelEcon, currentIdx);
 
-	0b00011000,
-	0b00010100,
-	0b00010100,
-	0b00011000,
-	0b00010010,
-	0b00010101,
-	0b00010011,
-	0b00000000,
+	while (i < bFEvTsize)
+	{
+		if (j == 0)
+			j = bgDataSize;
+		j--;
 
-	0b00000000,		// correction factor
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
+		barGraphData[i] = barFEvsTimeData[j];
+		i++;
+	}
 
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
+	formatBarGraph(bFEvTsize, (bgDataSize - 1),
+	    ((screenCursor[barFEvTscreenIdx]) ? 0 : v), v);
+
+	displayBarGraph(currentIdx, tFuelEcon, periodIdx, tFuelEcon);
+}
 #endif
-};
 
-const uint8_t calcLabelTrip[] PROGMEM = {
-	0b00000000,
-	0b00000000,
-	0b00000000,
-	0b00000000,
+/* System utilization display section */
+#ifdef useCPUreading
+/* display max cpu utilization and RAM */
+void doDisplaySystemInfo(void)
+{
+	unsigned int i = (unsigned int)(&i);
+	unsigned long t[2];
 
-	0b00000011,
-	0b00000111,
-	0b00000011,
-	0b00000111,
+#ifdef useCPUloadPage
+	if (screenCursor[CPUmonScreenIdx] == 1)
+	{
+		displayLoadInfo();
+		return;
+	}
 
-	0b00000100,
-	0b00000010,
-	0b00000100,
-	0b00000010,
+#endif
+#ifdef useStackWatch
+	if (screenCursor[CPUmonScreenIdx] == CPUmonStackPage)
+	{
+		displayStackInfo();
+		return;
+	}
 
-	0b00000100,
-	0b00000111,
-	0b00000011,
-	0b00000010,
-};
+#endif
+#ifdef useLoopPhaseTiming
+	if (screenCursor[CPUmonScreenIdx] == CPUmonPageCount - 1)
+	{
+		displayPhaseInfo();
+		return;
+	}
 
-void displayMainScreenFunction(uint8_t readingIdx, uint8_t k, uint8_t functBlink, uint8_t tripBlink)
-{
+#endif
+	if ((unsigned int) __brkval == 0)
+		i -= (unsigned int)(&__bss_end);
+	else
+		i -= (unsigned int)(__brkval);
 
-	readingIdx &= 3;
-	uint8_t x = (readingIdx & 1) << 3;
-	uint8_t y = (readingIdx & 2) >> 1;
-	uint8_t z = readingIdx << 1;
+	unsigned long mem = (unsigned long)i;
+	mem *= 1000;
 
-	uint8_t r = (k & dfTripMask) >> dfBitShift;
-	uint8_t f = k & dfValMask;
+	/* perform atomic transfer of clock to main program */
+	cli();
 
-	uint8_t j = pgm_read_byte(&calcLabelIdx[(unsigned int)(f)]);
-	if ((j & 128) && (metricFlag)) j += 2;
-	j &= 127;
+	/* perform atomic transfer of system time to main program */
+	t[0] = systemCycles[0];
+	t[1] = systemCycles[1];
 
-	writeCGRAMlabelChar(z, j, r, functBlink, tripBlink);
-	writeCGRAMlabelChar(z + 1, j + 1, r, functBlink, tripBlink);
+	sei();
 
-	gotoXY(x, y);
-	print(doFormat(k, 0));
-	charOut(8 + z);
-	charOut(9 + z);
+	displayUtilPercent(PSTR("C%"), timerLoopLength);
+	printFlash(PSTR(" T"));
+	print(format64(prgmFormatToTime, convertTime(t), mBuff1, 3));
+	gotoXY(0, 1);
+	printFlash(PSTR(" FREE MEM:"));
+	print(format(mem, 0));
+}
+
+const uint8_t prgmFindCPUutilPercent[] PROGMEM = {
+	instrMulByConst, idxNumerCPUutil,
+	instrDivByConst, idxDenomCPUutil,
+	instrDone
+};
 
+void displayUtilPercent(const char * str, unsigned long cycles) // 8 characters
+{
+	printFlash(str);
+	init64(tempPtr[1], cycles);
+	print(format(SWEET64(prgmFindCPUutilPercent, 0), 2));
 }
 
-void writeCGRAMlabelChar(uint8_t cgChar, uint8_t functIdx, uint8_t tripIdx, uint8_t functBlink, uint8_t tripBlink)
+/* foreground load, then background load - at most 16 characters, so it fits the status line */
+void displayCPUutil(void)
 {
+	displayUtilPercent(PSTR("C%"), timerLoopLength);
+#ifdef useBackgroundTasks
+	displayUtilPercent(PSTR("B%"), timerBackgroundLength);
+#endif
+}
 
-	uint8_t i = 0x1F;
-	uint8_t j = 0x1F;
-	unsigned int k = (unsigned int)(functIdx << 3);
-	if (timerHeartBeat & tripBlink) j = 0; // determine if trip label component should blink or not
-	if (timerHeartBeat & functBlink) i = 0; // determine if function label component should blink or not
-	tripIdx &= 3; // strip off unnecessary bits of trip index
+#ifdef useCPUloadPage
+/*
+ * top line is foreground and background load. bottom line is the serial
+ * drop and overrun counts and the scratch guard overrun count, which are
+ * capped at 9999, 9999, and 255, so it never runs past 16 characters
+ */
+void displayLoadInfo(void)
+{
+	displayCPUutil();
+	clrEOL();
+	gotoXY(0, 1);
+#ifdef useBufferedSerialPort
+	printFlash(PSTR("D"));
+	print(itoa(serialBuffer.dropCount, mBuff1, 10));
+	printFlash(PSTR(" W"));
+	print(itoa(serialBuffer.overrunCount, mBuff1, 10));
+	charOut(' ');
+#endif
+#ifdef useScratchGuard
+	printFlash(PSTR("G"));
+	print(itoa(scratchOverrunCount, mBuff1, 10));
+#endif
+	clrEOL();
+}
+#endif
 
-	for (uint8_t x = 0; x < 8; x++)
+#ifdef useScratchGuard
+void scratchGuardCheck(void)
+{
+	for (uint8_t x = 0; x < sGLsize; x++)
 	{
+		uint8_t i = pgm_read_byte(&scratchGuardList[(unsigned int)(x)]);
 
-		 uint8_t l = pgm_read_byte(&calcLabelCGRAM[(unsigned int)(k++)]); // read a byte of function label bit pattern
-		 uint8_t m = l >> 3; // fetch partial address of trip label component
-		 m &= 0b00001100; // strip off un-needed bits
-		 m |= tripIdx; // combine with trip index to form full address of trip label component
-		 m = pgm_read_byte(&calcLabelTrip[(unsigned int)(m)]); // read a byte of trip label bit pattern
-		 l &= i; // provide for blinking function label component
-		 m &= j; // provide for blinking trip label component
-		 mBuff1[(unsigned int)(x)] = l | m; // combine trip label and function label components
-
+		if ((uint8_t)(scratchArena[(unsigned int)(i)]) != scratchGuardValue)
+		{
+			if (scratchOverrunCount < 255) scratchOverrunCount++;
+			scratchArena[(unsigned int)(i)] = scratchGuardValue; // re-arm the guard
+		}
 	}
+}
+#endif
 
-	cgramMode = 0; // reset CGRAM mode
-	LCD::loadCGRAMcharacter(cgChar, (const char *)(mBuff1), 0); // write out generated CGRAM character
+#ifdef useStackWatch
+/*
+ * fill everything between the end of .bss and the stack with a canary
+ * value, so stackScan() can tell how close the stack has ever come to
+ * running into the variables. this runs first thing in main(), and leaves
+ * a little room for its own stack frame
+ */
+void stackPaint(void)
+{
+	uint8_t * p = (uint8_t *)(&__bss_end);
+	uint8_t * e = (uint8_t *)(&p) - 16;
 
+	while (p < e) *p++ = stackCanary;
+
+	stackLowWater = (unsigned int)(e - (uint8_t *)(&__bss_end));
 }
 
-/* Main screen section */
-const char mainScreenFuncNames[] PROGMEM = {
-	"Instrument\0"
-	"Custom\0"
-#ifdef useChryslerMAPCorrection
-	"Pressures\0"
+/*
+ * once per loop, count how many canary bytes are still untouched. the
+ * stack only ever eats into them from the top, so the count never needs to
+ * go past the previous low water mark
+ */
+uint8_t stackScan(void)
+{
+	const uint8_t * p = (const uint8_t *)(&__bss_end);
+	unsigned int i = 0;
+
+	if (stackScanDue == 0) return 0;
+	stackScanDue = 0;
+
+	while ((i < stackLowWater) && (*p++ == stackCanary)) i++;
+	stackLowWater = i;
+
+	return 1;
+}
+
+void displayStackInfo(void)
+{
+	printFlash(PSTR("MinFree "));
+	print(itoa(stackLowWater, mBuff1, 10));
+	printFlash(PSTR(" S"));
+	print(itoa(s64maxDepth, mBuff1, 10));
+	clrEOL();
+	gotoXY(0, 1);
+#ifdef useLegacyLCDbuffered
+	printFlash(PSTR("L"));
+	print(itoa(lcdBuffer.highWater, mBuff1, 10));
+	charOut(' ');
 #endif
-#ifdef useAnalogRead
-	"Voltages\0"
+#ifdef useBufferedSerialPort
+	printFlash(PSTR("T"));
+	print(itoa(serialBuffer.highWater, mBuff1, 10));
+	charOut(' ');
 #endif
-	"Instant/Current\0"
-	"Instant/Tank\0"
-	"Current\0"
-	"Tank\0"
-#ifdef trackIdleEOCdata
-	"EOC/Idle\0"
+#ifdef useSerialConfig
+	printFlash(PSTR("R"));
+	print(itoa(serialRxBuffer.highWater, mBuff1, 10));
 #endif
-	"Tank Data\0"
-	"Current Data\0"
-#ifdef trackIdleEOCdata
-	"Tank EOC/Idle\0"
-	"Current EOC/Idle\0"
+	clrEOL();
+}
 #endif
-	"Remaining\0"
-};
 
-void doCursorUpdateMain(void)
+#ifdef useLoopPhaseTiming
+/*
+ * charge the time since the previous phase marker to this phase. phases
+ * that follow one another share a marker, so only the first phase of a
+ * group needs phaseMark set beforehand
+ */
+void phaseEnd(uint8_t phaseIdx)
+{
+	unsigned long w = cycles2();
+	unsigned long d = findCycleLength(phaseMark, w);
+	unsigned int t;
+
+	phaseMark = w;
+
+	if (phaseRuns[(unsigned int)(phaseIdx)] == 255) return;
+
+	t = ((d > 65535ul) ? 65535 : (unsigned int)(d));
+
+	if ((phaseRuns[(unsigned int)(phaseIdx)] == 0) || (t < phaseMin[(unsigned int)(phaseIdx)])) phaseMin[(unsigned int)(phaseIdx)] = t;
+	if (t > phaseMax[(unsigned int)(phaseIdx)]) phaseMax[(unsigned int)(phaseIdx)] = t;
+	phaseSum[(unsigned int)(phaseIdx)] += t;
+	phaseRuns[(unsigned int)(phaseIdx)]++;
+}
+
+/* once per loop, and every phaseWindowLoops loops, publish the window just finished */
+void phaseLatch(void)
 {
-	/* briefly display screen name */
-	printStatusMessage(findStr(mainScreenFuncNames,
-	    screenCursor[mainScreenIdx]));
+	phaseLoopCount++;
+	if (phaseLoopCount < phaseWindowLoops) return;
+	phaseLoopCount = 0;
+
+	for (uint8_t x = 0; x < phaseCount; x++)
+	{
+		if (phaseRuns[(unsigned int)(x)])
+		{
+			phaseStats[(unsigned int)(x)][0] = phaseMin[(unsigned int)(x)];
+			phaseStats[(unsigned int)(x)][1] = (unsigned int)(phaseSum[(unsigned int)(x)] / phaseRuns[(unsigned int)(x)]);
+			phaseStats[(unsigned int)(x)][2] = phaseMax[(unsigned int)(x)];
+		}
+		else
+			for (uint8_t y = 0; y < 3; y++) phaseStats[(unsigned int)(x)][(unsigned int)(y)] = 0;
+
+		phaseRuns[(unsigned int)(x)] = 0;
+		phaseMax[(unsigned int)(x)] = 0;
+		phaseSum[(unsigned int)(x)] = 0;
+	}
 }
 
-void doMainScreenDisplay(void)
+/*
+ * two phases at a time, as min/avg/max in tenths of a millisecond, moving on every 2 seconds. each figure is capped
+ * at 999, so a line is never more than 15 characters - a phase that long already takes a fifth of the loop, and the
+ * serial dump has the exact figures
+ */
+void displayPhaseInfo(void)
 {
-	uint8_t i = screenCursor[mainScreenIdx];
-	uint8_t x, k;
+	uint8_t p = ((phaseShowCount++ >> 2) % ((phaseCount + 1) / 2)) * 2;
+	unsigned long t;
 
-	i <<= 2;
+	for (uint8_t y = 0; y < 2; y++, p++)
+	{
+		if (y) gotoXY(0, 1);
 
-	for (x = 0; x < 4; x++)
+		if (p < phaseCount)
+		{
+			printStr(phaseNames, p);
+			for (uint8_t x = 0; x < 3; x++)
+			{
+				charOut((x) ? '/' : ' ');
+				t = ((unsigned long)(phaseStats[(unsigned int)(p)][(unsigned int)(x)]) * 64ul / processorSpeed + 50ul) / 100ul;
+				if (t > 999ul) t = 999ul;
+				print(itoa((int)(t), mBuff1, 10));
+			}
+		}
+
+		clrEOL();
+	}
+}
+
+void doLoopPhaseDump(void)
+{
+	/* times are in timer2 ticks, the same units as timerLoopLength */
+	pushSerialFlash(PSTR("\nloop phases, ticks/s "));
+	pushHexDWord(t2CyclesPerSecond);
+	pushSerialFlash(PSTR("\nphs  min  avg  max\n"));
+
+	for (uint8_t x = 0; x < phaseCount; x++)
 	{
-#ifdef useScreenEditor
-		k = displayFormats[i++];
-#else
-		k = pgm_read_byte(&displayFormats[i++]);
-#endif
-		displayMainScreenFunction(x, k, 0, 136);
+		pushSerialFlash(findStr(phaseNames, x));
+		for (uint8_t y = 0; y < 3; y++)
+		{
+			pushSerialCharacter(' ');
+			pushHexWord(phaseStats[(unsigned int)(x)][(unsigned int)(y)]);
+		}
+		pushSerialCharacter('\n');
 	}
+
+	printStatusMessage(PSTR("Phases Sent"));
 }
 
-void doNextBright(void)
+#ifdef useSWEET64profiler
+/* the profiler and the phase dump share a key on the CPU monitor, so the page picks which one goes out */
+void doCPUmonDump(void)
 {
-	brightnessIdx++;
-	if (brightnessIdx >= brightnessLength)
-		brightnessIdx = 0;
-	LCD::setBright(brightnessIdx);
+	if (screenCursor[CPUmonScreenIdx] == CPUmonPageCount - 1) doLoopPhaseDump();
+	else doSWEET64profile();
+}
+
+#endif
+#endif
 
+void doShowCPU(void)
+{
 	initStatusLine();
-	printFlash(PSTR("Backlight = "));
-	printStr(brightString, brightnessIdx);
+	displayCPUutil();
 	execStatusLine();
 }
 
-void doLongGoLeft(void)
+#ifdef useBenchMark
+/* cycles in register 2, call count in register 3, leaves thousandths of a microsecond per call in register 2 */
+const uint8_t prgmBenchMarkTime[] PROGMEM = {
+	instrMulByConst, idxDecimalPoint,
+	instrCall, idxS64doConvertToMicroSeconds,
+	instrSwap, 0x13,
+	instrJump, idxS64doDivide,
+};
+
+const uint8_t prgmBenchMarkMul[] PROGMEM = {
+	instrJump, idxS64doMultiply,
+};
+
+const uint8_t prgmBenchMarkDiv[] PROGMEM = {
+	instrJump, idxS64doDivide,
+};
+
+/*
+ * prgmFuelEcon as it was encoded before the fused multiply and divide instructions, for the "oldFE" benchmark to set
+ * against "S64FE". the old prgmFindCyclesPerQuantity is written in place of the call to it, so the old figure is
+ * short one call and return, and the saving it shows is if anything a little low
+ */
+const uint8_t prgmBenchMarkOldFuelEcon[] PROGMEM = {
+	instrLdTripVar, 0x02, rvVSSpulseIdx,
+	instrSwap, 0x23,					// old prgmFindCyclesPerQuantity starts here
+	instrLdConst, 0x01, idxCyclesPerSecond,
+	instrLdEEPROM, 0x02, pMicroSecondsPerQuantityIdx,
+	instrCall, idxS64doMultiply,
+	instrLdConst, 0x01, idxMicroSecondsPerSecond,
+	instrCall, idxS64doDivide,
+	instrLd, 0x12,
+	instrSwap, 0x23,					// and ends here
+	instrCall, idxS64doMultiply,
+	instrSwap, 0x23,
+
+	instrLdTripVar, 0x02, rvInjOpenCycleIdx,
+	instrLdEEPROM, 0x01, pPulsesPerDistanceIdx,
+	instrCall, idxS64doMultiply,
+
+	instrSkipIfMetricMode, 7,
+	instrSwap, 0x23,
+	instrLdConst, 0x01, idxDecimalPoint,
+	instrSkip, 3,
+
+	instrLdConst, 0x01, idxMetricFE,
+
+	instrSkipIfZero, 0x02, 6,
+
+	instrCall, idxS64doMultiply,
+	instrSwap, 0x13,
+	instrJump, idxS64doDivide,
+
+	instrDone
+};
+
+Trip benchMarkTrip;
+uint16_t benchMarkInput;
+uint8_t benchMarkIdx;
+
+/*
+ * benchmark kernels - each one does a single call of the thing being timed, plus whatever setup it needs to be
+ * repeatable. the setup costs a little, but is the same every time
+ */
+void benchMarkISqrt(void)
 {
-	doCursorMoveRelative(255, 0);
+	benchMarkInput += iSqrt(benchMarkInput) + 65; // walk through the whole input range, and keep the result
 }
 
-void doLongGoRight(void)
+void benchMarkMul64(void)
 {
-	doCursorMoveRelative(1, 0);
+	init64(tempPtr[1], 0x89ABCDEFul);
+	init64(tempPtr[0], 0x76543210ul);
+	SWEET64(prgmBenchMarkMul, 0);
 }
 
-void doTripResetTank(void)
+void benchMarkDiv64(void)
 {
-	tripArray[tankIdx].reset();
-#ifdef trackIdleEOCdata
-	tripArray[eocIdleTankIdx].reset();
-#endif
-#ifdef useBarFuelEconVsSpeed
-	doResetBarFEvS();
-#endif
-	printStatusMessage(PSTR("Tank Reset"));
+	init64(tempPtr[1], 0xFEDCBA98ul);
+	tempPtr[1]->ul[1] = 0x01234567ul;
+	init64(tempPtr[0], 0x00012345ul);
+	SWEET64(prgmBenchMarkDiv, 0);
 }
 
-void doTripResetCurrent(void)
+void benchMarkFuelEcon(void)
 {
-	tripArray[currentIdx].reset();
-#ifdef trackIdleEOCdata
-	tripArray[eocIdleCurrentIdx].reset();
-#endif
-	printStatusMessage(PSTR("Current Reset"));
+	SWEET64(prgmFuelEcon, tankIdx);
 }
 
-/* Setting selector section */
-void doCursorUpdateSetting(void)
+void benchMarkOldFuelEcon(void)
 {
-	paramPtr = screenCursor[settingScreenIdx] +
-	    (uint8_t)(eePtrSettingsStart);
-	doParamRevert();
+	SWEET64(prgmBenchMarkOldFuelEcon, tankIdx);
 }
 
-void doSettingEditDisplay(void)
+void benchMarkFormat(void)
 {
-	/* print parameter name at top left */
-	printStr(parmLabels, screenCursor[settingScreenIdx]);
-	clrEOL();
-	/* go to next line */
-	gotoXY(0, 1);
-	print(pBuff);
-	clrEOL();
+	format(12345678ul, 2);
 }
 
-void doGoSettingsEdit(void)
+#ifdef useBigNumberDisplay
+void benchMarkBigNumber(void)
 {
-	prevMenuLevel = menuLevel;
-	doCursorMoveAbsolute(settingScreenIdx, 0);
+	char str[] = "12.34";
+
+	gotoXY(0, 0);
+	displayBigNumber(str);
 }
 
-void doReturnToMain(void)
+#endif
+void benchMarkTripUpdate(void)
 {
-	menuLevel = prevMenuLevel;
+	benchMarkTrip.update(tripArray[tankIdx]);
 }
 
-/* Individual parameter editor section */
-void doParamEditDisplay(void)
+void benchMarkParamRead(void)
 {
-	/* print parameter name at top left */
-	printStr(parmLabels, screenCursor[settingScreenIdx]);
-	clrEOL();
-	/* go to next line */
-	gotoXY(0, 1);
+	benchMarkInput += (uint16_t)(paramRead(MetricFlag) + paramRead(MicroSecondsPerQuantity)); // one byte wide, and four bytes wide
+}
 
-	/* save existing character */
-	uint8_t c = pBuff[screenCursor[paramScreenIdx]];
+/* benchmark registry - names, kernels, and how many times to call each kernel per run */
+const char benchMarkNames[] PROGMEM = {
+	"iSqrt\0"
+	"mul64\0"
+	"div64\0"
+	"S64FE\0"
+	"oldFE\0"
+	"format\0"
+#ifdef useBigNumberDisplay
+	"BigNum\0"
+#endif
+	"TripUpd\0"
+	"param\0"
+};
 
-	/* replace character with an underscore */
-	if ((timerHeartBeat & 0b01010101) &&
-	    (screenCursor[paramScreenIdx] < 10))
-		pBuff[screenCursor[paramScreenIdx]] = '_';
+const uint16_t benchMarkList[] PROGMEM = {
+	(uint16_t)benchMarkISqrt,
+	(uint16_t)benchMarkMul64,
+	(uint16_t)benchMarkDiv64,
+	(uint16_t)benchMarkFuelEcon,
+	(uint16_t)benchMarkOldFuelEcon,
+	(uint16_t)benchMarkFormat,
+#ifdef useBigNumberDisplay
+	(uint16_t)benchMarkBigNumber,
+#endif
+	(uint16_t)benchMarkTripUpdate,
+	(uint16_t)benchMarkParamRead,
+};
 
-	/* print number */
-	print(pBuff);
-	pBuff[screenCursor[paramScreenIdx]] = c;
+const uint16_t benchMarkLoops[] PROGMEM = {
+	1000,
+	100,
+	100,
+	100,
+	100,
+	100,
+#ifdef useBigNumberDisplay
+	20,
+#endif
+	1000,
+	1000,
+};
 
-	blinkFlash(&paramButtonChars[0], (screenCursor[paramScreenIdx] == 10));
-	blinkFlash(&paramButtonChars[4], (screenCursor[paramScreenIdx] == 11));
-}
+const uint8_t bMLsize = (sizeof(benchMarkList) / sizeof(uint16_t));
 
-void doGoParamEdit(void)
+/* benchMarkNames is a run of strings the compiler can't count - tools/host/benchmark.cpp checks it instead */
+typedef uint8_t benchMarkLoopsCheck[(sizeof(benchMarkLoops) == sizeof(benchMarkList)) ? 1 : -1];
+
+/*
+ * call a kernel the given number of times, and return how many timer2 cycles that took, less the cost of calling
+ * an empty kernel as many times. cycles2() takes timer 2 overflows into account, so runs may be as long as needed.
+ * interrupts stay on, so their load is included, the same as it would be for any other caller. tools/host/benchmark.cpp
+ * runs the same kernels on the host, with its own clock
+ */
+unsigned long benchMarkRun(pFunc kernel, unsigned int loops)
 {
-	paramLength = pgm_read_byte(
-	    &paramsLength[screenCursor[settingScreenIdx]]);
-	paramMaxValue = (1 << paramLength);
-	paramMaxValue -= 1;
+	unsigned long s;
+	unsigned long w;
+	unsigned long o;
 
-	menuLevel = paramScreenIdx;
-	format64(prgmFormatToNumber, paramMaxValue, mBuff2, 3);
-	doParamFindLeft();
+	s = cycles2();
+	for (unsigned int x = 0; x < loops; x++) doNothing();
+	o = findCycleLength(s, cycles2());
+
+	s = cycles2();
+	for (unsigned int x = 0; x < loops; x++) kernel();
+	w = findCycleLength(s, cycles2());
+
+	return ((w > o) ? w - o : 0);
 }
 
-void doParamExit(void)
+/* run the next benchmark in the registry, and show its time per call */
+void doBenchMark(void)
 {
-	doParamRevert();
-	generalMenuLevelReturn(PSTR("Param Reverted"), settingScreenIdx);
-}
+	unsigned int n = pgm_read_word(&benchMarkLoops[(unsigned int)(benchMarkIdx)]);
+	unsigned long w = benchMarkRun((pFunc)pgm_read_word(&benchMarkList[(unsigned int)(benchMarkIdx)]), n);
 
-#ifdef useCalculatedFuelFactor
-const uint8_t prgmCalculateFuelFactor[] PROGMEM = {
-	instrLdConst, 0x02, idxCorrFactor,
-	instrLdEEPROM, 0x01, pSysFuelPressureIdx,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pRefFuelPressureIdx,
-	instrCall, idxS64doDivide,
-	instrIsqrt, 0x02,
-	instrLdEEPROM, 0x01, pInjectorCountIdx,
-	instrCall, idxS64doMultiply,
-	instrLdEEPROM, 0x01, pInjectorSizeIdx,
-	instrCall, idxS64doMultiply,
-	instrSkipIfMetricMode, 10,
+	init64(tempPtr[1], w);
+	init64(tempPtr[2], n);
+	w = SWEET64(prgmBenchMarkTime, 0);
 
-	instrLdConst, 0x01, idxNumerVolume,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDenomVolume,
-	instrCall, idxS64doDivide,
+	initStatusLine();
+	printStr(benchMarkNames, benchMarkIdx);
+	charOut(' ');
+	print(format(w, 3));
+	printFlash(PSTR("us"));
+	execStatusLine();
 
-	instrSwap, 0x23,
-	/* load seconds per minute into register 2 */
-	instrLdByte, 0x02, 60,
-	instrLdConst, 0x01, idxMicroSecondsPerSecond,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDecimalPoint,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxCorrFactor,
-	instrCall, idxS64doMultiply,
-	instrSwap, 0x13,
-	instrCall, idxS64doDivide,
-	instrStEEPROM, 0x02, pMicroSecondsPerQuantityIdx,
-	instrDone
-};
+	benchMarkIdx++;
+	if (benchMarkIdx == bMLsize) benchMarkIdx = 0;
+}
 #endif
 
-const uint8_t prgmDoEEPROMmetricConversion[] PROGMEM = {
-	instrTraceOn,
-	instrLdIndex, 0,
-
-	instrLdEEPROMindirect, 0x02,
-
-	instrSkipIfMetricMode, 6,
-	instrLdNumer, 0x01,
-	instrLdDenom, 0x03,
-	instrSkip, 4,
+#endif
 
-	instrLdNumer, 0x03,
-	instrLdDenom, 0x01,
+#ifdef useEEPROMviewer
+void doEEPROMviewDisplay(void)
+{
+	print(format64(prgmFormatToNumber,
+	    (unsigned long)(screenCursor[(unsigned int)(eepromViewIdx)]),
+	    mBuff1, 3));
+	clrEOL();
+	gotoXY(0, 1);
+	print(format64(prgmFormatToNumber,
+	    eepromReadVal((unsigned int)(screenCursor[eepromViewIdx])),
+	    mBuff1, 3));
+	clrEOL();
+}
 
-	instrCall, idxS64doMultiply,
-	instrSwap, 0x31,
-	instrCall, idxS64doDivide,
-	instrCall, idxS64doAdjust,
-	instrStEEPROMindirect, 0x02,
-	instrAddToIndex, 1,
-	instrSkipIfIndexBelow, 227, convSize,
+void goEEPROMview(void)
+{
+	prevMenuLevel = menuLevel;
+	doCursorMoveAbsolute(eepromViewIdx, 255);
+}
+#endif
 
-	instrDone
-};
+/* Trip save/restore/raw data view support section */
+#ifdef useSavedTrips
+void doCursorUpdateTripShow(void)
+{
+	paramPtr = (uint8_t)(getBaseTripPointer(tripShowSlot)) +
+	    screenCursor[tripShowScreenIdx];
+	doParamRevert();
+}
 
-void doParamSave(void)
+void doTripSaveDisplay(void)
 {
-	/* if the setting has changed */
-	if (eepromWriteVal((unsigned int)(paramPtr), rformat()))
+	unsigned int t = getBaseTripPointer(tripShowSlot);
+	uint8_t b = (uint8_t)(eepromReadVal(
+	    (unsigned int)(t + tripListSigPointer)));
+	uint8_t i = screenCursor[tripSaveScreenIdx];
+	uint8_t j;
+
+	if (i == tslCount)
 	{
-#ifdef useBarFuelEconVsSpeed
-		if ((paramPtr == pBarLowSpeedCutoffIdx) ||
-		    (paramPtr == pBarSpeedQuantumIdx))
-			doResetBarFEvS();
-#endif
-		/* if metric flag has changed */
-		if (paramPtr == pMetricFlagIdx)
-			SWEET64(prgmDoEEPROMmetricConversion, 0);
-#ifdef useCalculatedFuelFactor
-		/*
-		 * if fuel pressure, reference pressure, injector count,
-		 * or injector size changed calculate and store microseconds
-		 * per gallon factor
-		 */
-		if ((paramPtr == pSysFuelPressureIdx) ||
-		    (paramPtr == pRefFuelPressureIdx) ||
-		    (paramPtr == pInjectorCountIdx) ||
-		    (paramPtr == pInjectorSizeIdx))
-			SWEET64(prgmCalculateFuelFactor, 0);
-#endif
-		/* reconfigure system based on changed settings */
-		initGuino();
-		generalMenuLevelReturn(PSTR("Param Changed"), settingScreenIdx);
+		j = tslSubSize;
 	}
 	else
 	{
-		generalMenuLevelReturn(PSTR("Param Unchanged"),
-		    settingScreenIdx);
+		j = i;
+		i /= tslSubSize;
+		j -= i * tslSubSize;
+
+		i = pgm_read_byte(&tripSelectList[i]);
 	}
-}
 
-void generalMenuLevelReturn(const char * s, uint8_t newMenuLevel)
-{
-	menuLevel = newMenuLevel;
-	printStatusMessage(s);
-}
+	/* print trip function name at top left */
+	printStr(tripNames, j);
+	if (j < tslSubSize)
+		printStr(bigFEDispChars, i);
+	clrEOL();
+	/* go to next line */
+	gotoXY(0, 1);
 
-void printStatusMessage(const char * s)
-{
-	initStatusLine();
-	printFlash(s);
-	execStatusLine();
+	charOut('0' + tripShowSlot);
+	charOut(':');
+
+#ifdef useTripJournal
+	if (journalSlotRecord[(unsigned int)(tripShowSlot)] == journalNoRecord) b = 0;
+
+#endif
+	if (b == guinosig)
+		print(format64(prgmFormatToTime, eepromReadVal(t), mBuff1, 3));
+	else
+		printFlash(PSTR("Empty"));
+
+	clrEOL();
 }
 
-void doParamFindLeft(void)
+void doTripShowDisplay(void)
 {
-	uint8_t x;
+	charOut('0' + tripShowSlot);
+	charOut(':');
 
-	screenCursor[paramScreenIdx] = 9;
+	uint8_t b = screenCursor[tripShowScreenIdx];
 
-	/*
-	 * do a nice thing and put the edit cursor at the first non zero number
-	 */
-	for (x = 9; x < 10; x--)
-		if (pBuff[x] != ' ')
-			screenCursor[paramScreenIdx] = x;
+	if (b > 16)
+		b -= 1;
+	else if (b > 3)
+		b = b / 2 + 2;
+
+	printStr(ertvNames, b);
+
+	charOut(' ');
+	charOut(76 - 4 * (screenCursor[tripShowScreenIdx] & 1));
+
+	clrEOL();
+	/* go to next line */
+	gotoXY(0, 1);
+	print(pBuff);
+	clrEOL();
 }
 
-void doParamFindRight(void)
+void doGoTripTank(void)
 {
-	screenCursor[paramScreenIdx] = 9;
+	goSavedTrip(0);
 }
 
-void doParamStoreMax(void)
+void doGoTripCurrent(void)
 {
-	doParamStoreNumber(paramMaxValue);
+	goSavedTrip(1);
 }
 
-void doParamStoreMin(void)
+void goSavedTrip(uint8_t tripSlot)
 {
-	doParamStoreNumber(0);
+	tripShowSlot = tripSlot;
+	prevMenuLevel = menuLevel;
+	doCursorMoveAbsolute(tripSaveScreenIdx, tripSlot * tslSubSize);
 }
 
-void doParamRevert(void)
+void doTripSelect(void)
 {
-	doParamStoreNumber(eepromReadVal((unsigned int)(paramPtr)));
+	goTripSelect(0);
 }
 
-void doParamStoreNumber(unsigned long v)
+void doTripLongSelect(void)
 {
-	format64(prgmFormatToNumber, v, pBuff, 3);
-#ifdef useLegacyLCD
-	/* adjust contrast dynamically */
-	if (paramPtr == pContrastIdx)
-		LCD::setContrast((uint8_t)(v));
-#endif
-	doParamFindLeft();
+	goTripSelect(1);
 }
 
-void doParamReformat(void)
+void goTripSelect(uint8_t pressFlag)
 {
+	uint8_t i = screenCursor[(unsigned int)tripSaveScreenIdx];
+	uint8_t j;
 
-	uint8_t c = '0';
-	uint8_t d = ' ';
-	uint8_t x;
-
-	for (x = 0; x < 9; x++)
+	if (i == tslCount)
+	{
+		doCursorMoveAbsolute(tripShowScreenIdx, 0);
+	}
+	else
 	{
+		j = i;
+		i /= tslSubSize;
+		j -= i * tslSubSize;
 
-		if (pBuff[x] == c)
+		if ((j == 0) && (pressFlag == 0))
 		{
-			pBuff[x] = d;
+			doCursorMoveAbsolute(prevMenuLevel,
+			    i + tripScreenIdxBase);
 		}
-		else if ((c == '0') && (pBuff[x] != ' '))
+		else
 		{
-			c = ' ';
-			d = '0';
+			i = pgm_read_byte(&tripSelectList[i]);
+
+			if ((j == 1) && (pressFlag == 1))
+				doTripSave(i);
+			else if ((j == 2) && (pressFlag == 1))
+				doTripLoad(i);
+			else if ((j == 3) && (pressFlag == 0))
+				doTripReset(i);
+			else
+				doTripBumpSlot();
 		}
 	}
+}
 
-	if (pBuff[9] == ' ')
-		pBuff[9] = '0';
+void doTripSave(uint8_t tripIdx)
+{
+	tripArray[tripIdx].save(tripShowSlot);
+	doTripPrintType(tripIdx);
+	printFlash(PSTR(" Save"));
 }
 
-void doParamChangeDigit(void)
+void doTripLoad(uint8_t tripIdx)
 {
-	uint8_t w, x;
+	tripArray[tripIdx].load(tripShowSlot);
+	doMainScreenDisplay();
+	gotoXY(0, 0);
+	doTripPrintType(tripIdx);
+	printFlash(PSTR(" Load"));
+	menuLevel = mainScreenIdx;
+}
 
-	if (screenCursor[paramScreenIdx] == 10)
-	{
-		doParamSave();
-	}
-	else if (screenCursor[paramScreenIdx] == 11)
-	{
-		doParamExit();
-	}
-	else
-	{
-		if (paramLength == 1)
-		{
-			pBuff[screenCursor[paramScreenIdx]] ^= 1;
-		}
-		else
-		{
-			/*
-			 * fetch digit from stored numeric string representing
-			 * parameter to be changed
-			 */
-			w = pBuff[screenCursor[paramScreenIdx]];
-			/* if this is a leading space, use 0 as working digit */
-			if (w == ' ')
-				w = '0';
-			/* adjust working digit */
-			w++;
-			/* handle working digit rollover */
-			if (w > '9')
-				w = '0';
+const uint8_t autoSaveInstr[] PROGMEM = {
+	pAutoSaveActiveIdx,
+	pAutoSaveActiveIdx,
+#ifdef trackIdleEOCdata
+	pAutoSaveIdleIdx,
+	pAutoSaveIdleIdx,
+#endif
+};
 
-			pBuff[screenCursor[paramScreenIdx]] = w;
-			doParamReformat();
+uint8_t doTripAutoAction(uint8_t taaMode)
+{
+	uint8_t b, x;
+	uint8_t c = 0;
 
-			for (x = 0; x < 10; x++)
-			{
-				if (pBuff[x] < mBuff2[x])
-				{
-					x = 10;
-				}
-				else if (pBuff[x] > mBuff2[x])
-				{
-					x = 10;
-					pBuff[screenCursor[paramScreenIdx]] =
-					    '0';
-					doParamReformat();
-				}
-			}
-#ifdef useLegacyLCD
-			/* adjust contrast dynamically */
-			if (paramPtr == pContrastIdx)
-				LCD::setContrast((uint8_t)(rformat()));
-#endif
+	for (x = 0; x < tslSize; x++)
+	{
+		if (eepromReadVal((unsigned int)(pgm_read_byte(
+		    &autoSaveInstr[x]))))
+		{
+			b = pgm_read_byte(&tripSelectList[x]);
+
+			if (taaMode)
+				c += tripArray[b].load(x);
+			else
+				c += tripArray[b].save(x);
 		}
 	}
+
+	return c;
 }
 
-/* large Fuel Economy display support section */
-#ifdef useBigFE
-void doCursorUpdateBigFEscreen(void)
+void doTripReset(uint8_t tripIdx)
 {
-	displayBigStatus(bigFEscreenIdx, PSTR(" Fuel Econ"));
+	tripArray[tripIdx].reset();
+	doTripPrintType(tripIdx);
+	printFlash(PSTR(" Reset"));
 }
 
-void doBigFEdisplay(void)
+void doTripPrintType(uint8_t tripIdx)
 {
-	uint8_t dIdx = fedSelect(bigFEscreenIdx);
+	printStr(bigFEDispChars, tripIdx);
+	printFlash(PSTR(" Trip "));
+	charOut('0' + tripShowSlot);
+}
 
-	displayBigNumber(doFormat(dIdx, tFuelEcon, dispFE));
+void doTripBumpSlot(void)
+{
+	tripShowSlot++;
+	if (tripShowSlot == eeAdrSavedTripsTemp3)
+		tripShowSlot = 0;
+}
 
-	printStr(bigFEDispChars, dIdx);
-	gotoXY(12, 1);
-	printFlash(PSTR("{MPG \\L100}"));
+void doTripShowCancel(void)
+{
+	menuLevel = tripSaveScreenIdx;
 }
 #endif
 
-/* large Distance-To-Empty display support section */
-#ifdef useBigDTE
-void doCursorUpdateBigDTEscreen(void)
+/* Programmable main display screen edit support section */
+#ifdef useScreenEditor
+
+uint8_t screenEditValue = 0;
+
+void doCursorUpdateScreenEdit(void)
 {
-	displayBigStatus(bigDTEscreenIdx, PSTR(" DistToEmpty"));
+	uint8_t b = screenCursor[screenEditIdx] >> 1;
+
+	screenEditValue = displayFormats[b] & dfValMask;
+	paramLength = (displayFormats[b] & dfTripMask) >> dfBitShift;
 }
 
-void doBigDTEdisplay(void)
+void doScreenEditDisplay(void)
 {
-	displayBigNumber(doFormat(fedSelect(bigDTEscreenIdx), tDistanceToEmpty,
-	    dispDTE));
+	uint8_t i = screenCursor[screenEditIdx];
+	uint8_t j = i;
+	i >>= 1;
+	uint8_t k = i;
+	uint8_t l, m, n, x;
+
+	i &= 0xFC;
+	j &= 0x01;
+	k &= 0x03;
+
+	for (x = 0; x < 4; x++)
+	{
+		l = displayFormats[i++];
+		m = 0;
+		n = 0;
+
+		if (x == k)
+		{
+			if (j == 1)
+				m = 170;
+			else
+				n = 170;
+		}
+
+		displayMainScreenFunction(x, l, m, n);
+	}
 }
-#endif
 
-/* large Time-To-Empty display support section */
-#ifdef useBigTTE
-void doCursorUpdateBigTTEscreen(void)
+void doGoScreenEdit(void)
 {
-  	displayBigStatus(bigTTEscreenIdx, PSTR(" TimeToEmpty"));
+	prevMenuLevel = menuLevel;
+	doCursorMoveAbsolute(screenEditIdx, screenCursor[mainScreenIdx] *
+	    displayPageCount);
 }
 
-void doBigTTEdisplay(void)
+void doScreenEditReturnToMain(void)
 {
-	displayBigTime(format64(prgmFormatToTime,
-	    SWEET64(prgmTimeToEmpty, fedSelect(bigTTEscreenIdx)), mBuff1, 3),
-	    4);
+	doSaveScreen();
+	doReturnToMain();
 }
-#endif
 
-/* Clock support section */
-#ifdef useClock
-void doCursorUpdateSystemTimeScreen(void)
+void doScreenEditRevert(void)
 {
-	printStatusMessage(PSTR("System Time"));
+	uint8_t b = screenCursor[screenEditIdx] >> 1;
+
+	paramPtr = (uint8_t)(eePtrScreensStart) + b;
+	displayFormats[b] =
+	    (uint8_t)(eepromReadVal((unsigned int)(paramPtr)));
 }
 
-/* display system time */
-void doDisplaySystemTime(void)
+void doScreenEditBump(void)
 {
-	displayBigTime(format64(prgmFormatToTime, convertTime(outputCycles),
-	    mBuff1, 3), 4);
+	uint8_t b = screenCursor[screenEditIdx];
+	uint8_t c = b;
+	b &= 0x01;
+	c >>= 1;
+
+	if (b)
+	{
+		screenEditValue++;
+		if (screenEditValue == dfMaxValDisplayCount)
+			screenEditValue = 0;
+	}
+	else
+	{
+		paramLength++;
+		if (paramLength == dfMaxTripCount)
+			paramLength = 0;
+	}
+
+	displayFormats[c] =
+	    (paramLength << dfBitShift) | screenEditValue;
 }
 
-void doGoEditSystemTime(void)
+void doSaveScreen(void)
 {
-	/* convert system time from ticks into seconds, and format for output */
-	format64(prgmFormatToTime, convertTime(outputCycles), pBuff, 3);
-	doCursorMoveAbsolute(systemTimeEditScreenIdx, 0);
+	uint8_t b = screenCursor[screenEditIdx] >> 1;
+
+	paramPtr = (uint8_t)(eePtrScreensStart) + b;
+	eepromWriteVal((unsigned int)(paramPtr), displayFormats[b]);
 }
 
-void doEditSystemTimeDisplay(void)
+#endif
+
+/* SWEET64 program list section - the verifier walks each of these, and the profiler counts by them */
+#if defined(useSWEET64verifier) || defined(useSWEET64profiler)
+/* every SWEET64 program, whether run by index or directly */
+const uint8_t * const S64verifyList[] PROGMEM = {
+	prgmFuelUsed,
+	prgmFuelRate,
+	prgmEngineRunTime,
+	prgmTimeToEmpty,
+	prgmDistance,
+	prgmSpeed,
+	prgmMotionTime,
+	prgmFuelEcon,
+	prgmRemainingFuel,
+	prgmDistanceToEmpty,
+	prgmEngineSpeed,
+	prgmInjectorOpenTime,
+	prgmInjectorTotalTime,
+	prgmVSStotalTime,
+	prgmInjectorPulseCount,
+	prgmVSSpulseCount,
+#ifdef useFuelCost
+	prgmFuelCost,
+	prgmFuelRateCost,
+	prgmFuelCostPerDistance,
+	prgmDistancePerFuelCost,
+	prgmRemainingFuelCost,
+#endif
+#ifdef useAnalogRead
+	prgmVoltage,
+#endif
+#ifdef useChryslerMAPCorrection
+	prgmPressure,
+	prgmCorrF,
+#endif
+	prgmFindRemainingFuel,
+	prgmDoMultiply,
+	prgmDoDivide,
+	prgmFindCyclesPerQuantity,
+	prgmConvertToMicroSeconds,
+	prgmDoAdjust,
+	prgmFormatToNumber,
+	prgmRoundOffNumber,
+	prgmFormatToTime,
+	prgmConvertToTime,
+#ifdef useChryslerMAPCorrection
+	prgmGenerateVoltageSlope,
+	prgmConvertVolts,
+#endif
+	prgmConvertInjSettleTime,
+	prgmFindSleepTicks,
+	prgmFindMinGoodRPM,
+	prgmFindInjResetDelay,
+	prgmFindMaxGoodInjCycles,
+#ifdef useBarFuelEconVsTime
+	prgmFindFEvsTimePeriod,
+#endif
+#ifdef useCalculatedFuelFactor
+	prgmCalculateFuelFactor,
+#endif
+	prgmDoEEPROMmetricConversion,
+#ifdef useClock
+	prgmConvertToCycles,
+#endif
+#ifdef useFillUpHistory
+	prgmFillUpFuelEcon,
+#endif
+#ifdef useCPUreading
+	prgmFindCPUutilPercent,
+#ifdef useBenchMark
+	prgmBenchMarkTime,
+	prgmBenchMarkMul,
+	prgmBenchMarkDiv,
+	prgmBenchMarkOldFuelEcon,
+#endif
+#endif
+};
+
+const uint8_t S64verifySize[] PROGMEM = {
+	sizeof(prgmFuelUsed),
+	sizeof(prgmFuelRate),
+	sizeof(prgmEngineRunTime),
+	sizeof(prgmTimeToEmpty),
+	sizeof(prgmDistance),
+	sizeof(prgmSpeed),
+	sizeof(prgmMotionTime),
+	sizeof(prgmFuelEcon),
+	sizeof(prgmRemainingFuel),
+	sizeof(prgmDistanceToEmpty),
+	sizeof(prgmEngineSpeed),
+	sizeof(prgmInjectorOpenTime),
+	sizeof(prgmInjectorTotalTime),
+	sizeof(prgmVSStotalTime),
+	sizeof(prgmInjectorPulseCount),
+	sizeof(prgmVSSpulseCount),
+#ifdef useFuelCost
+	sizeof(prgmFuelCost),
+	sizeof(prgmFuelRateCost),
+	sizeof(prgmFuelCostPerDistance),
+	sizeof(prgmDistancePerFuelCost),
+	sizeof(prgmRemainingFuelCost),
+#endif
+#ifdef useAnalogRead
+	sizeof(prgmVoltage),
+#endif
+#ifdef useChryslerMAPCorrection
+	sizeof(prgmPressure),
+	sizeof(prgmCorrF),
+#endif
+	sizeof(prgmFindRemainingFuel),
+	sizeof(prgmDoMultiply),
+	sizeof(prgmDoDivide),
+	sizeof(prgmFindCyclesPerQuantity),
+	sizeof(prgmConvertToMicroSeconds),
+	sizeof(prgmDoAdjust),
+	sizeof(prgmFormatToNumber),
+	sizeof(prgmRoundOffNumber),
+	sizeof(prgmFormatToTime),
+	sizeof(prgmConvertToTime),
+#ifdef useChryslerMAPCorrection
+	sizeof(prgmGenerateVoltageSlope),
+	sizeof(prgmConvertVolts),
+#endif
+	sizeof(prgmConvertInjSettleTime),
+	sizeof(prgmFindSleepTicks),
+	sizeof(prgmFindMinGoodRPM),
+	sizeof(prgmFindInjResetDelay),
+	sizeof(prgmFindMaxGoodInjCycles),
+#ifdef useBarFuelEconVsTime
+	sizeof(prgmFindFEvsTimePeriod),
+#endif
+#ifdef useCalculatedFuelFactor
+	sizeof(prgmCalculateFuelFactor),
+#endif
+	sizeof(prgmDoEEPROMmetricConversion),
+#ifdef useClock
+	sizeof(prgmConvertToCycles),
+#endif
+#ifdef useFillUpHistory
+	sizeof(prgmFillUpFuelEcon),
+#endif
+#ifdef useCPUreading
+	sizeof(prgmFindCPUutilPercent),
+#ifdef useBenchMark
+	sizeof(prgmBenchMarkTime),
+	sizeof(prgmBenchMarkMul),
+	sizeof(prgmBenchMarkDiv),
+	sizeof(prgmBenchMarkOldFuelEcon),
+#endif
+#endif
+};
+
+const char S64verifyNames[] PROGMEM = {
+	"FuelUsed\0"
+	"FuelRate\0"
+	"EngineRunTime\0"
+	"TimeToEmpty\0"
+	"Distance\0"
+	"Speed\0"
+	"MotionTime\0"
+	"FuelEcon\0"
+	"RemainingFuel\0"
+	"DistanceToEmpty\0"
+	"EngineSpeed\0"
+	"InjectorOpenTime\0"
+	"InjectorTotalTime\0"
+	"VSStotalTime\0"
+	"InjectorPulseCount\0"
+	"VSSpulseCount\0"
+#ifdef useFuelCost
+	"FuelCost\0"
+	"FuelRateCost\0"
+	"FuelCostPerDistance\0"
+	"DistancePerFuelCost\0"
+	"RemainingFuelCost\0"
+#endif
+#ifdef useAnalogRead
+	"Voltage\0"
+#endif
+#ifdef useChryslerMAPCorrection
+	"Pressure\0"
+	"CorrF\0"
+#endif
+	"FindRemainingFuel\0"
+	"DoMultiply\0"
+	"DoDivide\0"
+	"FindCyclesPerQuantity\0"
+	"ConvertToMicroSeconds\0"
+	"DoAdjust\0"
+	"FormatToNumber\0"
+	"RoundOffNumber\0"
+	"FormatToTime\0"
+	"ConvertToTime\0"
+#ifdef useChryslerMAPCorrection
+	"GenerateVoltageSlope\0"
+	"ConvertVolts\0"
+#endif
+	"ConvertInjSettleTime\0"
+	"FindSleepTicks\0"
+	"FindMinGoodRPM\0"
+	"FindInjResetDelay\0"
+	"FindMaxGoodInjCycles\0"
+#ifdef useBarFuelEconVsTime
+	"FindFEvsTimePeriod\0"
+#endif
+#ifdef useCalculatedFuelFactor
+	"CalculateFuelFactor\0"
+#endif
+	"DoEEPROMmetricConversion\0"
+#ifdef useClock
+	"ConvertToCycles\0"
+#endif
+#ifdef useFillUpHistory
+	"FillUpFuelEcon\0"
+#endif
+#ifdef useCPUreading
+	"FindCPUutilPercent\0"
+#ifdef useBenchMark
+	"BenchMarkTime\0"
+	"BenchMarkMul\0"
+	"BenchMarkDiv\0"
+	"BenchMarkOldFuelEcon\0"
+#endif
+#endif
+};
+
+const uint8_t S64verifyCount = (sizeof(S64verifySize) / sizeof(uint8_t));
+
+/* S64verifyNames is a run of strings the compiler can't count - tools/host/s64verify.cpp checks it instead */
+typedef uint8_t S64verifyListCheck[(sizeof(S64verifyList) / sizeof(const uint8_t *) == S64verifyCount) ? 1 : -1];
+
+uint8_t S64findVerifyIdx(const uint8_t * prgmPtr)
 {
-	displayBigTime(pBuff, screenCursor[systemTimeEditScreenIdx]);
+	for (uint8_t x = 0; x < S64verifyCount; x++)
+		if ((const uint8_t *)(pgm_read_word(&S64verifyList[x])) ==
+		    prgmPtr)
+			return x;
+
+	return 255;
 }
 
-void doEditSystemTimeChangeDigit(void)
-{
-	pBuff[screenCursor[systemTimeEditScreenIdx]]++;
-	if (pBuff[screenCursor[systemTimeEditScreenIdx]] > '9')
-		pBuff[screenCursor[systemTimeEditScreenIdx]] = '0';
+#endif
 
-	/* this will only happen if systemTimeEditScreenIdx == 2 */
-	if (pBuff[2] > '5') pBuff[2] = '0';
-	/* this will only happen if systemTimeEditScreenIdx == 0 or 1 */
-	if ((pBuff[0] == '2') && (pBuff[1] > '3')) pBuff[1] = '0';
-	/* this will only happen if systemTimeEditScreenIdx == 0 */
-	if (pBuff[0] > '2') pBuff[0] = '0';
+/* SWEET64 profiler section */
+#ifdef useSWEET64profiler
+/*
+ * one slot per program in S64verifyList, plus a last one for any program
+ * that isn't listed. a program's cycles run from when it starts to when it
+ * is done, so they include the cycles of whatever it calls. the counts stop
+ * at FFFF rather than wrap
+ */
+const uint8_t s64profSlotCount = S64verifyCount + 1;
+
+unsigned int s64profCalls[(unsigned int)(s64profSlotCount)];
+unsigned long s64profCycles[(unsigned int)(s64profSlotCount)];
+uint8_t s64profSlotOf[(unsigned int)(S64programCount)]; // slot + 1 of each S64programList entry, or 0 if not yet looked up
+
+uint8_t S64profCount(uint8_t slot)
+{
+	if (s64profCalls[(unsigned int)(slot)] < 0xFFFF) s64profCalls[(unsigned int)(slot)]++;
+
+	return slot;
 }
 
-const uint8_t prgmConvertToCycles[] PROGMEM = {
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrCall, idxS64doDivide,
-	instrLdConst, 0x01, idxSecondsPerDay,
-	instrCall, idxS64doDivide,
+/* a program run directly - only it has to be looked up by address */
+uint8_t S64profEnter(const uint8_t * sched)
+{
+	uint8_t x = S64findVerifyIdx(sched);
 
-	instrLdIndex, 0,
-	instrLdByte, 0x01, 24,
-	instrCall, idxS64doMultiply,
-	instrLdByteFromYindexed, 0x13,
-	instrAddYtoX, 0x21,
+	if (x > S64verifyCount) x = S64verifyCount;
 
-	instrLdIndex, 2,
-	instrLdByte, 0x01, 60,
-	instrCall, idxS64doMultiply,
-	instrLdByteFromYindexed, 0x13,
-	instrAddYtoX, 0x21,
+	return S64profCount(x);
+}
 
-	instrLdIndex, 4,
-	instrLdByte, 0x01, 60,
-	instrCall, idxS64doMultiply,
-	instrLdByteFromYindexed, 0x13,
-	instrAddYtoX, 0x21,
+/* a program run by its S64programList index */
+uint8_t S64profCall(uint8_t prgmIdx)
+{
+	uint8_t x = s64profSlotOf[(unsigned int)(prgmIdx)];
 
-	instrLdConst, 0x01, idxCyclesPerSecond,
-	instrJump, idxS64doMultiply,
-};
+	if (x == 0)
+	{
+		x = S64findVerifyIdx((const uint8_t *)pgm_read_word(&S64programList[(unsigned int)(prgmIdx)]));
+		if (x > S64verifyCount) x = S64verifyCount;
+		s64profSlotOf[(unsigned int)(prgmIdx)] = ++x;
+	}
 
-void doEditSystemTimeSave(void)
+	return S64profCount(x - 1);
+}
+
+/* only the low 16 bits of cycles2() are kept, which is good for runs of up to 0.2 seconds */
+void S64profLeave(uint8_t slot, unsigned int start)
 {
-	uint8_t b, x;
+	s64profCycles[(unsigned int)(slot)] += (unsigned int)((unsigned int)(cycles2()) - start);
+}
 
-	pBuff[4] = '0';
-	pBuff[5] = '0';
+void doSWEET64profile(void)
+{
+	uint8_t x;
 
-	copy64(tempPtr[1], (union union_64 *)&outputCycles);
+	pushSerialFlash(PSTR("\nSWEET64 profile\nop count\n"));
 
-	for ( x = 4; x < 6; x -= 2)
+	for (x = 0; x < DNUISinstrCount; x++)
 	{
-		b = pBuff[x] - '0';
-		b *= 10;
-		b += pBuff[x + 1] - '0';
-		tempPtr[2]->u8[x] = b;
+		if (s64profOpCount[(unsigned int)(x)])
+		{
+			pushHexByte(x);
+			pushSerialCharacter(' ');
+			pushHexDWord(s64profOpCount[(unsigned int)(x)]);
+			pushSerialCharacter('\n');
+		}
+
+		s64profOpCount[(unsigned int)(x)] = 0;
 	}
 
-	/* convert time into timer2 clock cycles */
-	SWEET64(prgmConvertToCycles, 0);
+	/* cycles are in timer2 ticks, the same units as timerLoopLength */
+	pushSerialFlash(PSTR("runs cycles    program\n"));
 
-	cli();
-	copy64((union union_64 *)&clockCycles, tempPtr[1]);
-	sei();
+	for (x = 0; x < s64profSlotCount; x++)
+	{
+		if (s64profCalls[(unsigned int)(x)])
+		{
+			pushHexWord(s64profCalls[(unsigned int)(x)]);
+			pushSerialCharacter(' ');
+			pushHexDWord(s64profCycles[(unsigned int)(x)]);
+			pushSerialCharacter(' ');
+			if (x < S64verifyCount) pushSerialFlash(findStr(S64verifyNames, x));
+			else pushSerialFlash(PSTR("(unlisted)"));
+			pushSerialCharacter('\n');
+		}
 
-	generalMenuLevelReturn(PSTR("Time Set"), systemTimeDisplayScreenIdx);
-}
+		s64profCalls[(unsigned int)(x)] = 0;
+		s64profCycles[(unsigned int)(x)] = 0;
+	}
 
-void doEditSystemTimeCancel(void)
-{
-	generalMenuLevelReturn(PSTR("Time NOT Set"),
-	    systemTimeDisplayScreenIdx);
+	printStatusMessage(PSTR("S64 Profile Sent"));
 }
+
 #endif
 
-/* (parameter) vs. Speed Bar Graph display section */
-#ifdef useBarFuelEconVsSpeed
-uint8_t FEvSpdTripIdx;
+/* SWEET64 static verifier section */
+#ifdef useSWEET64verifier
+const uint8_t s64vMaxSize = 96;		/* largest program the verifier will walk */
+const uint8_t s64vMaxDepth = 15;	/* deepest call nesting that prgmStack[16] allows */
+const uint8_t s64vLoopBound = 64;	/* SWEET64 loops walk at most the 64 bits of a register */
 
-void doCursorUpdateBarFEvS(void)
+const uint8_t s64vErrOpcode = 		0b00000001; /* unsupported or truncated instruction */
+const uint8_t s64vErrRegister = 	0b00000010; /* register operand outside of tmp1 thru tmp5 */
+const uint8_t s64vErrBranch = 		0b00000100; /* skip lands outside of program, or inside an instruction */
+const uint8_t s64vErrTarget = 		0b00001000; /* call/jump outside of S64programList, or to an unlisted program */
+const uint8_t s64vErrFallOff = 		0b00010000; /* execution can run past the end of the program */
+const uint8_t s64vErrDepth = 		0b00100000; /* call nesting overflows prgmStack, or is recursive */
+const uint8_t s64vErrLoop = 		0b01000000; /* loop has no way out */
+const uint8_t s64vDone = 		0b10000000; /* program has been walked */
+
+uint8_t S64instrLength(uint8_t instr)
 {
-	uint8_t b = pgm_read_byte(
-	    &barFEvSdisplayFuncs[screenCursor[barFEvSscreenIdx]]);
+	uint8_t l = 1;
 
-	for (uint8_t x = 0; x < bgDataSize; x++)
-		barGraphData[bgDataSize - x - 1] =
-		    doCalculate(b, (x + FEvsSpeedIdx));
+	if (instr & 0x40)
+		l++;
+	if (instr & 0x80)
+		l++;
+	/* this one carries an index comparison byte after its skip byte */
+	if (instr == instrSkipIfIndexBelow)
+		l++;
 
-	/* briefly display screen name */
-	printStatusMessage(findStr(barFEvSfuncNames,
-	    screenCursor[barFEvSscreenIdx]));
+	return l;
 }
 
-void doBarFEvSdisplay(void)
+uint8_t S64usesX(uint8_t instr)
 {
-	uint8_t b = pgm_read_byte(
-	    &barFEvSdisplayFuncs[screenCursor[barFEvSscreenIdx]]);
-
-	if (FEvSpdTripIdx < 255)
-		barGraphData[bgDataSize + FEvsSpeedIdx - FEvSpdTripIdx - 1] =
-		    doCalculate(b, FEvSpdTripIdx);
+	return ((instr == instrLd) ||
+	    (instr == instrLdByteFromYindexed) ||
+	    (instr == instrSkipIfLTorE) ||
+	    (instr == instrStByteToYindexed) ||
+	    (instr == instrSwap) ||
+	    (instr == instrSubYfromX) ||
+#ifndef useSWEET64multDiv
+	    (instr == instrMulXbyY) ||
+	    (instr == instrDivXbyY) ||
+#endif
+	    (instr == instrAddYtoX));
+}
 
-	formatBarGraph(bgDataSize, (FEvSpdTripIdx - FEvsSpeedIdx), 0,
-	    doCalculate(b, tankIdx));
+uint8_t S64isSkip(uint8_t instr)
+{
+	instr &= 0x3F;
 
-	displayBarGraph(FEvSpdTripIdx, b,
-	    ((timerHeartBeat & 0b00110011) ? tankIdx : instantIdx),
-	    ((timerHeartBeat & 0b00110011) ? b : tSpeed));
+	return ((instr >= DNUISinstrSkipIfMetricMode) &&
+	    (instr <= DNUISinstrSkip));
 }
 
-void doResetBarFEvS(void)
+int S64skipTarget(const uint8_t * prgmPtr, uint8_t i)
 {
-	for (uint8_t x = 0; x < bgDataSize; x++)
-		tripArray[x + FEvsSpeedIdx].reset();
+	uint8_t instr = pgm_read_byte(prgmPtr + i);
+	uint8_t b = pgm_read_byte(prgmPtr + i + ((instr & 0x40) ? 2 : 1));
+
+	return (int)(i + S64instrLength(instr)) + (int)((int8_t)(b));
 }
-#endif
 
-/* Differential/Absolute Fuel Economy vs. Time display section */
-#ifdef useBarFuelEconVsTime
-void doResetBarFEvT(void)
+uint8_t S64testBit(uint8_t * map, uint8_t n, int t)
 {
-	tripArray[periodIdx].reset();
-	bFEvTcount = 0;
-	bFEvTstartIDx = 0;
-	bFEvTsize = 0;
+	if ((t < 0) || (t >= (int)(n)))
+		return 0;
+
+	return (map[t >> 3] & (1 << (t & 0x07)));
 }
 
-void doCursorUpdateBarFEvT(void)
+unsigned int S64verifyClamp(unsigned long v)
 {
-	/* briefly display screen name */
-	printStatusMessage(findStr(barFEvTfuncNames,
-	    screenCursor[barFEvTscreenIdx]));
+	return ((v > 65535ul) ? 65535 : (unsigned int)(v));
 }
 
-void doBarFEvTdisplay(void)
+/*
+ * a loop that steps the index from a value loaded just ahead of it, and goes
+ * around while the index is below a limit, can be bounded exactly. this
+ * assumes that called programs leave the index alone, which the math
+ * subroutines do
+ */
+uint8_t S64indexLoopTrips(const uint8_t * prgmPtr, uint8_t * starts,
+    uint8_t n, uint8_t t, uint8_t i)
 {
-	uint8_t i = 0;
-	uint8_t j = bFEvTstartIDx;
-	unsigned long v = doCalculate(tFuelEcon, currentIdx);
+	uint8_t c = 0;
+	uint8_t f = 0;
+	uint8_t s = 0;
+	uint8_t v = 0;
+	uint8_t instr, k;
 
-	while (i < bFEvTsize)
+	for (k = 0; k < i; k++)
 	{
-		if (j == 0)
-			j = bgDataSize;
-		j--;
+		if (!S64testBit(starts, n, k))
+			continue;
 
-		barGraphData[i] = barFEvsTimeData[j];
-		i++;
+		instr = pgm_read_byte(prgmPtr + k);
+
+		if ((k < t) && (k + S64instrLength(instr) == t) &&
+		    (instr == instrLdIndex))
+		{
+			f = 1;
+			v = pgm_read_byte(prgmPtr + k + 1);
+		}
+		else if ((k >= t) && (instr == instrAddToIndex))
+		{
+			c++;
+			s = pgm_read_byte(prgmPtr + k + 1);
+		}
+		else if ((k >= t) && (instr == instrLdIndex))
+			c = 2;
 	}
 
-	formatBarGraph(bFEvTsize, (bgDataSize - 1),
-	    ((screenCursor[barFEvTscreenIdx]) ? 0 : v), v);
+	if ((f == 0) || (c != 1))
+		return s64vLoopBound;
 
-	displayBarGraph(currentIdx, tFuelEcon, periodIdx, tFuelEcon);
+	f = pgm_read_byte(prgmPtr + i + 2);
+
+	for (c = 1; c < s64vLoopBound; c++)
+	{
+		v += s;
+		if (v >= f)
+			break;
+	}
+
+	return c;
 }
-#endif
 
-/* System utilization display section */
-#ifdef useCPUreading
-/* display max cpu utilization and RAM */
-void doDisplaySystemInfo(void)
-{
-	unsigned int i = (unsigned int)(&i);
-	unsigned long t[2];
+/*
+ * statically walk program p without executing any of it. returns 0 if it
+ * calls a program that has not been walked yet, otherwise returns its error
+ * flags along with s64vDone. the worst case instruction count charges every
+ * loop for its full body on every trip around, so it is an upper bound
+ * rather than an estimate
+ */
+uint8_t S64verifyProgram(uint8_t p, uint8_t * status, uint8_t * depth,
+    unsigned int * worst)
+{
+	const uint8_t * prgmPtr =
+	    (const uint8_t *)(pgm_read_word(&S64verifyList[p]));
+	uint8_t n = pgm_read_byte(&S64verifySize[p]);
+	uint8_t starts[(s64vMaxSize + 7) / 8];
+	uint8_t loops[(s64vMaxSize + 7) / 8];
+	uint8_t reach[(s64vMaxSize + 7) / 8];
+	unsigned int cost[s64vMaxSize];
+	unsigned int path[s64vMaxSize];
+	unsigned long w;
+	uint8_t e = s64vDone;
+	uint8_t d = 0;
+	uint8_t i, k, l, b, f, instr;
+	int t, j;
+
+	if (n > s64vMaxSize)
+		return (e | s64vErrOpcode);
+
+	for (i = 0; i < sizeof(starts); i++)
+	{
+		starts[i] = 0;
+		loops[i] = 0;
+	}
 
-	if ((unsigned int) __brkval == 0)
-		i -= (unsigned int)(&__bss_end);
-	else
-		i -= (unsigned int)(__brkval);
+	/*
+	 * first pass - decode each instruction, check its encoding and
+	 * register operands, and charge it for any program it calls
+	 */
+	for (i = 0; i < n; i += l)
+	{
+		starts[i >> 3] |= (1 << (i & 0x07));
+		instr = pgm_read_byte(prgmPtr + i);
+		l = S64instrLength(instr);
+		cost[i] = 1;
+		path[i] = 0;
 
-	unsigned long mem = (unsigned long)i;
-	mem *= 1000;
+		if (((instr & 0x3F) >= S64instrCount) ||
+		    (pgm_read_byte(&S64instrList[instr & 0x3F]) != instr) ||
+		    (i + l > n))
+			return (e | s64vErrOpcode);
 
-	/* perform atomic transfer of clock to main program */
-	cli();
+		if (instr & 0x40)
+		{
+			b = pgm_read_byte(prgmPtr + i + 1);
 
-	/* perform atomic transfer of system time to main program */
-	t[0] = systemCycles[0];
-	t[1] = systemCycles[1];
+			/* a zero X register nybble is fine if X goes unused */
+			if (((b >> 4) == 0) && (S64usesX(instr) == 0))
+				b |= 0x10;
 
-	sei();
+			b -= 0x11;
+			if (((b >> 4) > 4) || ((b & 0x0F) > 4))
+				e |= s64vErrRegister;
+		}
 
-	displayCPUutil();
-	printFlash(PSTR(" T"));
-	print(format64(prgmFormatToTime, convertTime(t), mBuff1, 3));
-	gotoXY(0, 1);
-	printFlash(PSTR(" FREE MEM:"));
-	print(format(mem, 0));
-}
+		if ((instr == instrCall) || (instr == instrJump) ||
+		    ((instr >= instrMulByByte) && (instr <= instrDivByEEPROM)))
+		{
+			b = pgm_read_byte(prgmPtr + i + 1);
+			k = 255;
+
+			/* fused instructions act like a call to multiply or divide */
+			if (instr >= instrDivByByte)
+				b = idxS64doDivide;
+			else if (instr >= instrMulByByte)
+				b = idxS64doMultiply;
+
+			if (b < S64programCount)
+				k = S64findVerifyIdx((const uint8_t *)(pgm_read_word(
+				    &S64programList[b])));
+
+			if (k == 255)
+				e |= s64vErrTarget;
+			/* come back once the called program has been walked */
+			else if (status[k] == 0)
+				return 0;
+			else
+			{
+				b = depth[k];
+#ifdef useSWEET64multDiv
+				if (instr != instrJump)
+#else
+				if (instr == instrCall)
+#endif
+					b++;
+				if (d < b)
+					d = b;
+				cost[i] = S64verifyClamp(1ul + worst[k]);
+			}
+		}
+	}
 
-const uint8_t prgmFindCPUutilPercent[] PROGMEM = {
-	instrLdConst, 0x01, idxNumerCPUutil,
-	instrCall, idxS64doMultiply,
-	instrLdConst, 0x01, idxDenomCPUutil,
-	instrJump, idxS64doDivide,
-};
+	/*
+	 * second pass - check each skip target, find which skips back close a
+	 * loop, and charge each loop for its trips around. inner loops close
+	 * first, so their charges are already part of any outer loop body
+	 */
+	for (i = 0; i < n; i += l)
+	{
+		instr = pgm_read_byte(prgmPtr + i);
+		l = S64instrLength(instr);
 
-void displayCPUutil(void)
-{
-	printFlash(PSTR("C%"));
-	init64(tempPtr[1], timerLoopLength);
-	print(format(SWEET64(prgmFindCPUutilPercent, 0), 2));
-}
+		if (!S64isSkip(instr))
+			continue;
 
-void doShowCPU(void)
-{
-	initStatusLine();
-	displayCPUutil();
-	execStatusLine();
-}
+		t = S64skipTarget(prgmPtr, i);
 
-#ifdef useBenchMark
-const uint8_t prgmBenchMarkTime[] PROGMEM = {
-	instrJump, idxS64doConvertToMicroSeconds,
-};
+		if (!S64testBit(starts, n, t))
+		{
+			e |= s64vErrBranch;
+			continue;
+		}
 
-void doBenchMark(void)
-{
-	unsigned long t = 0;
-	unsigned long w, s, e, c;
+		if (t > (int)(i))
+			continue;
 
-	/* disable interrupts */
-	cli();
+		/*
+		 * a skip back is only a loop if the code it lands on can find
+		 * its way back around to it, otherwise it is just shared code
+		 */
+		for (k = 0; k < sizeof(reach); k++)
+			reach[k] = 0;
+		reach[t >> 3] |= (1 << (t & 0x07));
 
-	/* wait for timer2 to overflow */
-	while (!(TIFR2 & (1 << TOV2)));
+		for (k = (uint8_t)(t); k < i; k++)
+		{
+			if (!S64testBit(reach, n, k) ||
+			    !S64testBit(starts, n, k))
+				continue;
 
-	/* reset timer2 overflow flag */
-	TIFR2 |= (1 << TOV2);
+			b = pgm_read_byte(prgmPtr + k);
+			if ((b == instrDone) || (b == instrJump))
+				continue;
 
-#ifdef TinkerkitLCDmodule
-	/* do a microSeconds() - like read to determine loop length in cycles */
-	s = TCNT0;
-#else
-	/* do a microSeconds() - like read to determine loop length in cycles */
-	s = TCNT2;
-#endif
-	for (unsigned int x = 0; x < 1000; x++)
-	{
-		if (TIFR2 & (1 << TOV2))
+			if (b != instrSkip)
+			{
+				j = k + S64instrLength(b);
+				reach[j >> 3] |= (1 << (j & 0x07));
+			}
+
+			if (S64isSkip(b))
+			{
+				j = S64skipTarget(prgmPtr, k);
+				if ((j > (int)(k)) && (j <= (int)(i)))
+					reach[j >> 3] |= (1 << (j & 0x07));
+			}
+		}
+
+		if (!S64testBit(reach, n, i))
+			continue;
+
+		loops[i >> 3] |= (1 << (i & 0x07));
+
+		/* a conditional skip back can fall thru out of its own loop */
+		f = ((instr & 0x3F) != DNUISinstrSkip);
+		w = 0;
+
+		for (k = (uint8_t)(t); k <= i; k++)
 		{
-			t += 256ul;
-			TIFR2 |= (1 << TOV2);
+			if (!S64testBit(starts, n, k))
+				continue;
+
+			w += cost[k];
+			b = pgm_read_byte(prgmPtr + k);
+
+			if ((b == instrDone) || (b == instrJump))
+				f = 1;
+			else if ((k < i) && S64isSkip(b))
+			{
+				j = S64skipTarget(prgmPtr, k);
+				if ((j < t) || (j > (int)(i)))
+					f = 1;
+			}
 		}
 
-		c = (unsigned long)iSqrt((unsigned int)(s));
+		if (f == 0)
+			e |= s64vErrLoop;
+
+		b = s64vLoopBound;
+		if (instr == instrSkipIfIndexBelow)
+			b = S64indexLoopTrips(prgmPtr, starts, n, (uint8_t)(t), i);
+
+		cost[i] = S64verifyClamp(cost[i] + w * (b - 1));
 	}
-#ifdef TinkerkitLCDmodule
-	/* do a microSeconds() - like read to determine loop length in cycles */
-	e = TCNT0;
-	if (TIFR0 & (1 << TOV0))
-#else
-	/* do a microSeconds() - like read to determine loop length in cycles */
-	e = TCNT2;
-	if (TIFR2 & (1 << TOV2))
-#endif
+
+	/*
+	 * third pass - find the worst case cost of running from each
+	 * instruction to the end. skips back to shared code mean this has to
+	 * be repeated until nothing changes
+	 */
+	f = 1;
+	while (f)
 	{
-#ifdef TinkerkitLCDmodule
-		e = TCNT0;
-		TIFR0 |= (1 << TOV0);
-#else
-		e = TCNT2;
-		TIFR2 |= (1 << TOV2);
-#endif
-		t += 256;
-	}
+		f = 0;
+		i = n;
 
-	e += t;
+		while (i--)
+		{
+			if (!S64testBit(starts, n, i))
+				continue;
 
-	sei();
+			instr = pgm_read_byte(prgmPtr + i);
+			l = S64instrLength(instr);
+			w = 0;
+
+			if ((instr != instrDone) && (instr != instrJump))
+			{
+				if (instr != instrSkip)
+				{
+					if (i + l < n)
+						w = path[i + l];
+					else
+						e |= s64vErrFallOff;
+				}
 
-	w = findCycleLength(s, e) - 156;
+				if (S64isSkip(instr))
+					t = S64skipTarget(prgmPtr, i);
+				else
+					t = -1;
 
-	init64(tempPtr[1], w);
+				if (S64testBit(starts, n, t) &&
+				    !S64testBit(loops, n, i))
+				{
+					if (path[t] > w)
+						w = path[t];
+				}
+				else if (S64testBit(starts, n, t))
+				{
+					/* leaving a loop costs as much as its dearest way out */
+					for (k = (uint8_t)(t); k < i; k++)
+					{
+						if (!S64testBit(starts, n, k) ||
+						    !S64isSkip(pgm_read_byte(
+						    prgmPtr + k)))
+							continue;
+
+						j = S64skipTarget(prgmPtr, k);
+						if (((j < t) || (j > (int)(i))) &&
+						    S64testBit(starts, n, j) &&
+						    (path[j] > w))
+							w = path[j];
+					}
+				}
+			}
 
-	initStatusLine();
-	print(format(SWEET64(prgmBenchMarkTime, 0), 3));
-	printFlash(PSTR(" usec"));
-	execStatusLine();
-}
-#endif
-#endif
+			w = S64verifyClamp(w + cost[i]);
+			if (path[i] != w)
+			{
+				path[i] = w;
+				f = 1;
+			}
+		}
+	}
 
-#ifdef useEEPROMviewer
-void doEEPROMviewDisplay(void)
-{
-	print(format64(prgmFormatToNumber,
-	    (unsigned long)(screenCursor[(unsigned int)(eepromViewIdx)]),
-	    mBuff1, 3));
-	clrEOL();
-	gotoXY(0, 1);
-	print(format64(prgmFormatToNumber,
-	    eepromReadVal((unsigned int)(screenCursor[eepromViewIdx])),
-	    mBuff1, 3));
-	clrEOL();
-}
+	if (d > s64vMaxDepth)
+		e |= s64vErrDepth;
 
-void goEEPROMview(void)
-{
-	prevMenuLevel = menuLevel;
-	doCursorMoveAbsolute(eepromViewIdx, 255);
-}
-#endif
+	depth[p] = d;
+	worst[p] = path[0];
 
-/* Trip save/restore/raw data view support section */
-#ifdef useSavedTrips
-void doCursorUpdateTripShow(void)
-{
-	paramPtr = (uint8_t)(getBaseTripPointer(tripShowSlot)) +
-	    screenCursor[tripShowScreenIdx];
-	doParamRevert();
+	return e;
 }
 
-void doTripSaveDisplay(void)
+/*
+ * walk every SWEET64 program, and list its size, call depth, error flags,
+ * and worst case instruction count over the serial port. returns the error
+ * flags found across all programs
+ */
+uint8_t doSWEET64verify(void)
 {
-	unsigned int t = getBaseTripPointer(tripShowSlot);
-	uint8_t b = (uint8_t)(eepromReadVal(
-	    (unsigned int)(t + tripListSigPointer)));
-	uint8_t i = screenCursor[tripSaveScreenIdx];
-	uint8_t j;
+	uint8_t status[S64verifyCount];
+	uint8_t depth[S64verifyCount];
+	unsigned int worst[S64verifyCount];
+	uint8_t e = 0;
+	uint8_t f = 1;
+	uint8_t x;
 
-	if (i == tslCount)
+	for (x = 0; x < S64verifyCount; x++)
 	{
-		j = tslSubSize;
+		status[x] = 0;
+		depth[x] = 0;
+		worst[x] = 0;
 	}
-	else
+
+	/* called programs have to be walked before their callers */
+	while (f)
 	{
-		j = i;
-		i /= tslSubSize;
-		j -= i * tslSubSize;
+		f = 0;
 
-		i = pgm_read_byte(&tripSelectList[i]);
+		for (x = 0; x < S64verifyCount; x++)
+		{
+			if (status[x] == 0)
+			{
+				status[x] = S64verifyProgram(x, status, depth,
+				    worst);
+				if (status[x])
+					f = 1;
+			}
+		}
 	}
 
-	/* print trip function name at top left */
-	printStr(tripNames, j);
-	if (j < tslSubSize)
-		printStr(bigFEDispChars, i);
-	clrEOL();
-	/* go to next line */
-	gotoXY(0, 1);
+	pushSerialFlash(PSTR("\nSWEET64 verify\n## sz dp er wcnt name\n"));
 
-	charOut('0' + tripShowSlot);
-	charOut(':');
+	for (x = 0; x < S64verifyCount; x++)
+	{
+		/* anything still not walked ends up calling itself */
+		if (status[x] == 0)
+			status[x] = (s64vDone | s64vErrDepth);
+
+		status[x] &= ~s64vDone;
+		e |= status[x];
+
+		pushHexByte(x);
+		pushSerialCharacter(' ');
+		pushHexByte(pgm_read_byte(&S64verifySize[x]));
+		pushSerialCharacter(' ');
+		pushHexByte(depth[x]);
+		pushSerialCharacter(' ');
+		pushHexByte(status[x]);
+		pushSerialCharacter(' ');
+		pushHexWord(worst[x]);
+		pushSerialCharacter(' ');
+		pushSerialFlash(findStr(S64verifyNames, x));
+		pushSerialCharacter('\n');
+	}
 
-	if (b == guinosig)
-		print(format64(prgmFormatToTime, eepromReadVal(t), mBuff1, 3));
-	else
-		printFlash(PSTR("Empty"));
+	/* every program that can be run by index has to be listed above */
+	for (x = 0; x < S64programCount; x++)
+	{
+		if (S64findVerifyIdx((const uint8_t *)(pgm_read_word(
+		    &S64programList[x]))) == 255)
+		{
+			e |= s64vErrTarget;
+			pushSerialFlash(PSTR("unlisted "));
+			pushHexByte(x);
+			pushSerialCharacter('\n');
+		}
+	}
 
-	clrEOL();
+	return e;
 }
+#endif
 
-void doTripShowDisplay(void)
+#ifdef useSWEET64disassembler
+/* SWEET64 disassembler section */
+uint8_t S64disPushStr(const char * str, uint8_t w)
 {
-	charOut('0' + tripShowSlot);
-	charOut(':');
-
-	uint8_t b = screenCursor[tripShowScreenIdx];
-
-	if (b > 16)
-		b -= 1;
-	else if (b > 3)
-		b = b / 2 + 2;
+	uint8_t l = 0;
 
-	printStr(ertvNames, b);
+	while (pgm_read_byte(str))
+	{
+		pushSerialCharacter(pgm_read_byte(str++));
+		l++;
+	}
 
-	charOut(' ');
-	charOut(76 - 4 * (screenCursor[tripShowScreenIdx] & 1));
+	while (l < w)
+	{
+		pushSerialCharacter(' ');
+		l++;
+	}
 
-	clrEOL();
-	/* go to next line */
-	gotoXY(0, 1);
-	print(pBuff);
-	clrEOL();
+	return l;
 }
 
-void doGoTripTank(void)
+/* returns the S64programList index that the instruction at i hands off to, or 255 */
+uint8_t S64disCallee(const uint8_t * prgmPtr, uint8_t i)
 {
-	goSavedTrip(0);
-}
+	uint8_t instr = pgm_read_byte(prgmPtr + i);
 
-void doGoTripCurrent(void)
-{
-	goSavedTrip(1);
-}
+	if ((instr == instrCall) || (instr == instrJump))
+		return pgm_read_byte(prgmPtr + i + 1);
+#ifdef useSWEET64multDiv
+	if ((instr >= instrDivByByte) && (instr <= instrDivByEEPROM))
+		return idxS64doDivide;
+	if ((instr >= instrMulByByte) && (instr <= instrMulByEEPROM))
+		return idxS64doMultiply;
+#endif
 
-void goSavedTrip(uint8_t tripSlot)
-{
-	tripShowSlot = tripSlot;
-	prevMenuLevel = menuLevel;
-	doCursorMoveAbsolute(tripSaveScreenIdx, tripSlot * tslSubSize);
+	return 255;
 }
 
-void doTripSelect(void)
+/*
+ * one pass estimate of program p in CPU cycles - every instruction is
+ * charged once, so loops are only counted for a single trip around. returns
+ * 0 if it calls a program that has not been estimated yet
+ */
+unsigned long S64disEstimate(uint8_t p, unsigned long * est)
 {
-	goTripSelect(0);
-}
+	const uint8_t * prgmPtr =
+	    (const uint8_t *)(pgm_read_word(&S64verifyList[p]));
+	uint8_t n = pgm_read_byte(&S64verifySize[p]);
+	unsigned long e = 0;
+	uint8_t i, k, instr;
 
-void doTripLongSelect(void)
-{
-	goTripSelect(1);
-}
+	for (i = 0; i < n; i += S64instrLength(instr))
+	{
+		instr = pgm_read_byte(prgmPtr + i);
 
-void goTripSelect(uint8_t pressFlag)
-{
-	uint8_t i = screenCursor[(unsigned int)tripSaveScreenIdx];
-	uint8_t j;
+		/* the verifier reports these */
+		if ((instr & 0x3F) >= S64instrCount)
+			break;
 
-	if (i == tslCount)
-	{
-		doCursorMoveAbsolute(tripShowScreenIdx, 0);
-	}
-	else
-	{
-		j = i;
-		i /= tslSubSize;
-		j -= i * tslSubSize;
+		e += pgm_read_dword(&S64instrCycles[instr & 0x3F]);
+		k = S64disCallee(prgmPtr, i);
 
-		if ((j == 0) && (pressFlag == 0))
-		{
-			doCursorMoveAbsolute(prevMenuLevel,
-			    i + tripScreenIdxBase);
-		}
-		else
+		if (k < S64programCount)
 		{
-			i = pgm_read_byte(&tripSelectList[i]);
+			k = S64findVerifyIdx((const uint8_t *)(pgm_read_word(
+			    &S64programList[k])));
 
-			if ((j == 1) && (pressFlag == 1))
-				doTripSave(i);
-			else if ((j == 2) && (pressFlag == 1))
-				doTripLoad(i);
-			else if ((j == 3) && (pressFlag == 0))
-				doTripReset(i);
-			else
-				doTripBumpSlot();
+			if (k != 255)
+			{
+				if (est[k] == 0)
+					return 0;
+
+				e += est[k];
+			}
 		}
 	}
-}
 
-void doTripSave(uint8_t tripIdx)
-{
-	tripArray[tripIdx].save(tripShowSlot);
-	doTripPrintType(tripIdx);
-	printFlash(PSTR(" Save"));
+	return e;
 }
 
-void doTripLoad(uint8_t tripIdx)
+void doSWEET64disassemble(void)
 {
-	tripArray[tripIdx].load(tripShowSlot);
-	doMainScreenDisplay();
-	gotoXY(0, 0);
-	doTripPrintType(tripIdx);
-	printFlash(PSTR(" Load"));
-	menuLevel = mainScreenIdx;
-}
+	const uint8_t * prgmPtr;
+	unsigned long est[S64verifyCount];
+	uint8_t f = 1;
+	uint8_t x, n, i, j, k, l, instr;
 
-const uint8_t autoSaveInstr[] PROGMEM = {
-	pAutoSaveActiveIdx,
-	pAutoSaveActiveIdx,
-#ifdef trackIdleEOCdata
-	pAutoSaveIdleIdx,
-	pAutoSaveIdleIdx,
-#endif
-};
+	for (x = 0; x < S64verifyCount; x++)
+		est[x] = 0;
 
-uint8_t doTripAutoAction(uint8_t taaMode)
-{
-	uint8_t b, x;
-	uint8_t c = 0;
+	/* called programs have to be estimated before their callers */
+	while (f)
+	{
+		f = 0;
 
-	for (x = 0; x < tslSize; x++)
+		for (x = 0; x < S64verifyCount; x++)
+		{
+			if (est[x] == 0)
+			{
+				est[x] = S64disEstimate(x, est);
+				if (est[x])
+					f = 1;
+			}
+		}
+	}
+
+	pushSerialFlash(PSTR("\nSWEET64 listing\n"));
+
+	for (x = 0; x < S64verifyCount; x++)
 	{
-		if (eepromReadVal((unsigned int)(pgm_read_byte(
-		    &autoSaveInstr[x]))))
+		prgmPtr = (const uint8_t *)(pgm_read_word(&S64verifyList[x]));
+		n = pgm_read_byte(&S64verifySize[x]);
+
+		pushSerialCharacter('\n');
+		pushSerialFlash(findStr(S64verifyNames, x));
+		pushSerialFlash(PSTR(" est "));
+		pushHexDWord(est[x]);
+		pushSerialCharacter('\n');
+
+		for (i = 0; i < n; i += l)
 		{
-			b = pgm_read_byte(&tripSelectList[x]);
+			instr = pgm_read_byte(prgmPtr + i);
+			l = S64instrLength(instr);
+			j = i + 1;
 
-			if (taaMode)
-				c += tripArray[b].load(x);
-			else
-				c += tripArray[b].save(x);
+			pushHexByte(i);
+			pushSerialCharacter(' ');
+
+			for (k = 0; k < 4; k++)
+			{
+				if ((k < l) && (i + k < n))
+					pushHexByte(pgm_read_byte(prgmPtr + i + k));
+				else
+					pushSerialFlash(PSTR("  "));
+				pushSerialCharacter(' ');
+			}
+
+			if ((instr & 0x3F) >= S64instrCount)
+			{
+				pushSerialFlash(PSTR("?\n"));
+				break;
+			}
+
+			S64disPushStr(findStr(S64instrNames, instr & 0x3F),
+			    ((instr & 0xC0) ? 19 : 0));
+
+			/* registers are listed as X,Y, or as just Y if X goes unused */
+			if (instr & 0x40)
+			{
+				k = pgm_read_byte(prgmPtr + j++);
+
+				if (S64usesX(instr))
+				{
+					pushSerialCharacter('r');
+					pushHexNybble(k >> 4);
+					pushSerialCharacter(',');
+				}
+
+				pushSerialCharacter('r');
+				pushHexNybble(k);
+
+				if (instr & 0x80)
+					pushSerialCharacter(',');
+			}
+
+			if (S64isSkip(instr))
+			{
+				pushSerialCharacter('L');
+				pushHexByte((uint8_t)(S64skipTarget(prgmPtr, i)));
+
+				if (instr == instrSkipIfIndexBelow)
+				{
+					pushSerialCharacter(',');
+					pushHexByte(pgm_read_byte(prgmPtr + i + 2));
+				}
+			}
+			else if ((instr == instrCall) || (instr == instrJump))
+			{
+				k = pgm_read_byte(prgmPtr + j);
+
+				if (k < S64programCount)
+					k = S64findVerifyIdx((const uint8_t *)(pgm_read_word(
+					    &S64programList[k])));
+				else
+					k = 255;
+
+				if (k == 255)
+					pushHexByte(pgm_read_byte(prgmPtr + j));
+				else
+					pushSerialFlash(findStr(S64verifyNames, k));
+			}
+			else if (instr & 0x80)
+				pushHexByte(pgm_read_byte(prgmPtr + j));
+
+			pushSerialCharacter('\n');
 		}
 	}
 
-	return c;
+	printStatusMessage(PSTR("S64 Listing Sent"));
 }
+#endif
 
-void doTripReset(uint8_t tripIdx)
-{
-	tripArray[tripIdx].reset();
-	doTripPrintType(tripIdx);
-	printFlash(PSTR(" Reset"));
-}
+#ifdef useSWEET64selfTest
+/* SWEET64 self test section */
+const unsigned int s64tRandomCount = 1000;	/* random operand pairs to try, after the edge cases */
 
-void doTripPrintType(uint8_t tripIdx)
-{
-	printStr(bigFEDispChars, tripIdx);
-	printFlash(PSTR(" Trip "));
-	charOut('0' + tripShowSlot);
-}
+const uint8_t prgmSelfTestAdd[] PROGMEM = {
+	instrAddYtoX, 0x21,
+	instrDone
+};
 
-void doTripBumpSlot(void)
-{
-	tripShowSlot++;
-	if (tripShowSlot == eeAdrSavedTripsTemp3)
-		tripShowSlot = 0;
-}
+const uint8_t prgmSelfTestSub[] PROGMEM = {
+	instrSubYfromX, 0x21,
+	instrDone
+};
 
-void doTripShowCancel(void)
-{
-	menuLevel = tripSaveScreenIdx;
-}
-#endif
+/* register 2 is X and register 1 is Y for each of these */
+const uint8_t * const S64testList[] PROGMEM = {
+	prgmSelfTestAdd,
+	prgmSelfTestSub,
+	prgmDoMultiply,
+	prgmDoDivide,
+};
+
+const char S64testNames[] PROGMEM = {
+	"add\0"
+	"sub\0"
+	"mul\0"
+	"div\0"
+};
 
-/* Programmable main display screen edit support section */
-#ifdef useScreenEditor
+const uint8_t S64testCount = (sizeof(S64testList) / sizeof(const uint8_t *));
+
+/* low, then high long word of each edge case operand */
+const unsigned long S64testEdges[] PROGMEM = {
+	0x00000000ul, 0x00000000ul,
+	0x00000001ul, 0x00000000ul,
+	0x00000002ul, 0x00000000ul,
+	0x0000000Aul, 0x00000000ul,
+	0xFFFFFFFFul, 0x00000000ul,
+	0x00000000ul, 0x00000001ul,
+	0x3B9ACA00ul, 0x00000000ul,
+	0x00000000ul, 0x80000000ul,
+	0xFFFFFFFEul, 0xFFFFFFFFul,
+	0xFFFFFFFFul, 0xFFFFFFFFul,
+};
 
-uint8_t screenEditValue = 0;
+const uint8_t s64tEdgeCount = (sizeof(S64testEdges) / (2 * sizeof(unsigned long)));
 
-void doCursorUpdateScreenEdit(void)
+unsigned long s64tSeed;
+
+unsigned long S64testRandom(void)
 {
-	uint8_t b = screenCursor[screenEditIdx] >> 1;
+	s64tSeed ^= s64tSeed << 13;
+	s64tSeed ^= s64tSeed >> 17;
+	s64tSeed ^= s64tSeed << 5;
 
-	screenEditValue = displayFormats[b] & dfValMask;
-	paramLength = (displayFormats[b] & dfTripMask) >> dfBitShift;
+	return s64tSeed;
 }
 
-void doScreenEditDisplay(void)
+/* edge case c, or a random operand of random width once c runs past the edge cases */
+void S64testOperand(union union_64 * an, uint8_t c)
 {
-	uint8_t i = screenCursor[screenEditIdx];
-	uint8_t j = i;
-	i >>= 1;
-	uint8_t k = i;
-	uint8_t l, m, n, x;
-
-	i &= 0xFC;
-	j &= 0x01;
-	k &= 0x03;
-
-	for (x = 0; x < 4; x++)
+	if (c < s64tEdgeCount)
 	{
-		l = displayFormats[i++];
-		m = 0;
-		n = 0;
-
-		if (x == k)
-		{
-			if (j == 1)
-				m = 170;
-			else
-				n = 170;
-		}
-
-		displayMainScreenFunction(x, l, m, n);
+		an->ul[0] = pgm_read_dword(&S64testEdges[(unsigned int)(c) * 2]);
+		an->ul[1] = pgm_read_dword(&S64testEdges[(unsigned int)(c) * 2 + 1]);
+	}
+	else
+	{
+		an->ul[0] = S64testRandom();
+		an->ul[1] = S64testRandom();
+		an->ull >>= (S64testRandom() & 0x3F);
 	}
 }
 
-void doGoScreenEdit(void)
+/* native 64 bit C arithmetic, with the same divide by zero result that div64() gives */
+void S64testReference(uint8_t t, union union_64 * an, union union_64 * ann)
 {
-	prevMenuLevel = menuLevel;
-	doCursorMoveAbsolute(screenEditIdx, screenCursor[mainScreenIdx] *
-	    displayPageCount);
-}
+	unsigned long long r;
 
-void doScreenEditReturnToMain(void)
-{
-	doSaveScreen();
-	doReturnToMain();
+	if (t == 0) an->ull += ann->ull;
+	else if (t == 1) an->ull -= ann->ull;
+	else if (t == 2) an->ull *= ann->ull;
+	else if (ann->ull)
+	{
+		r = an->ull % ann->ull;
+		an->ull /= ann->ull;
+		ann->ull = r;
+	}
+	else
+	{
+		an->ull = 0xFFFFFFFFFFFFFFFFull;
+		ann->ull = an->ull;
+	}
 }
 
-void doScreenEditRevert(void)
+/* runs test t on whatever is in registers 1 and 2, returns 1 if SWEET64 disagrees with the reference */
+uint8_t S64testCase(uint8_t t)
 {
-	uint8_t b = screenCursor[screenEditIdx] >> 1;
+	union union_64 x;
+	union union_64 y;
+	uint8_t f;
 
-	paramPtr = (uint8_t)(eePtrScreensStart) + b;
-	displayFormats[b] =
-	    (uint8_t)(eepromReadVal((unsigned int)(paramPtr)));
+	copy64(&x, tempPtr[1]);
+	copy64(&y, tempPtr[0]);
+	S64testReference(t, &x, &y);
+
+	SWEET64((const uint8_t *)(pgm_read_word(&S64testList[(unsigned int)(t)])), 0);
+
+	f = (x.ull != tempPtr[1]->ull);
+	/* only divide leaves anything meaningful in register 1 */
+	if (t == 3) f |= (y.ull != tempPtr[0]->ull);
+
+	return f;
 }
 
-void doScreenEditBump(void)
+/*
+ * differential test of the SWEET64 math routines against native 64 bit
+ * C arithmetic, first over every pairing of the edge cases and then over
+ * random operands. each mismatch is listed over the serial port as test,
+ * X, Y, then what SWEET64 produced in X and Y. returns the mismatch count
+ */
+uint8_t doSWEET64selfTest(void)
 {
-	uint8_t b = screenCursor[screenEditIdx];
-	uint8_t c = b;
-	b &= 0x01;
-	c >>= 1;
+	union union_64 x;
+	union union_64 y;
+	unsigned int i;
+	unsigned int n = 0;
+	uint8_t e = 0;
+	uint8_t t;
 
-	if (b)
-	{
-		screenEditValue++;
-		if (screenEditValue == dfMaxValDisplayCount)
-			screenEditValue = 0;
-	}
-	else
+	s64tSeed = 0x2545F491ul;
+
+	pushSerialFlash(PSTR("\nSWEET64 self test\n"));
+
+	for (i = 0; i < (unsigned int)(s64tEdgeCount) * s64tEdgeCount + s64tRandomCount; i++)
 	{
-		paramLength++;
-		if (paramLength == dfMaxTripCount)
-			paramLength = 0;
-	}
+		if (i < (unsigned int)(s64tEdgeCount) * s64tEdgeCount)
+		{
+			S64testOperand(&x, i / s64tEdgeCount);
+			S64testOperand(&y, i % s64tEdgeCount);
+		}
+		else
+		{
+			S64testOperand(&x, s64tEdgeCount);
+			S64testOperand(&y, s64tEdgeCount);
+		}
 
-	displayFormats[c] =
-	    (paramLength << dfBitShift) | screenEditValue;
-}
+		for (t = 0; t < S64testCount; t++)
+		{
+			copy64(tempPtr[1], &x);
+			copy64(tempPtr[0], &y);
+			n++;
 
-void doSaveScreen(void)
-{
-	uint8_t b = screenCursor[screenEditIdx] >> 1;
+			if (S64testCase(t))
+			{
+				if (e < 255) e++;
+
+				pushSerialFlash(findStr(S64testNames, t));
+				pushSerialCharacter(' ');
+				pushHexDWord(x.ul[1]);
+				pushHexDWord(x.ul[0]);
+				pushSerialCharacter(' ');
+				pushHexDWord(y.ul[1]);
+				pushHexDWord(y.ul[0]);
+				pushSerialCharacter(' ');
+				pushHexDWord(tempPtr[1]->ul[1]);
+				pushHexDWord(tempPtr[1]->ul[0]);
+				pushSerialCharacter(' ');
+				pushHexDWord(tempPtr[0]->ul[1]);
+				pushHexDWord(tempPtr[0]->ul[0]);
+				pushSerialCharacter('\n');
+			}
+		}
+	}
 
-	paramPtr = (uint8_t)(eePtrScreensStart) + b;
-	eepromWriteVal((unsigned int)(paramPtr), displayFormats[b]);
-}
+	pushSerialFlash(PSTR("cases "));
+	pushHexWord(n);
+	pushSerialFlash(PSTR(" fail "));
+	pushHexByte(e);
+	pushSerialCharacter('\n');
 
+	return e;
+}
 #endif
 
 uint8_t loadParams(void)
@@ -7891,6 +11695,12 @@ uint8_t loadParams(void)
 	uint8_t b = 1;
 	uint8_t t;
 
+#ifdef useParameterCache
+	/* anything written below goes thru to the cache as well */
+	for (unsigned int x = 0; x < (unsigned int)(pOffsetZZ); x++)
+		paramCache[x] = eepromReadByte(eeAdrSettingsStart + x);
+
+#endif
 #ifdef forceEEPROMsettingsInit
 	if (true)
 #else
@@ -7921,6 +11731,12 @@ uint8_t loadParams(void)
 #endif
 	}
 
+#ifdef useSavedTrips
+#ifdef useTripJournal
+	journalInit();
+
+#endif
+#endif
 	initGuino();
 	return b;
 }
@@ -7940,11 +11756,15 @@ uint8_t eepromWriteVal(unsigned int eePtr, unsigned long val)
 	while (l > 0)
 	{
 		w = (uint8_t)(val & 0xFF);
-		if (w != eeprom_read_byte((uint8_t *)(--t)))
+		if (w != eepromReadByte(--t))
 		{
-			eeprom_write_byte((uint8_t *)(t), w);
+			eepromWriteByte(t, w);
 			s = 1;
 		}
+#ifdef useParameterCache
+		if ((t >= eeAdrSettingsStart) && (t < eeAdrSettingsEnd))
+			paramCache[t - eeAdrSettingsStart] = w;
+#endif
 		val >>= 8;
 		l--;
 	}
@@ -7954,10 +11774,24 @@ uint8_t eepromWriteVal(unsigned int eePtr, unsigned long val)
 
 unsigned long eepromReadVal(unsigned int eePtr)
 {
-	unsigned int t = eepromGetAddress(eePtr);
+	unsigned int t;
 	uint8_t l;
 	unsigned long val = 0;
 
+#ifdef useParameterCache
+	/* settings come straight out of RAM, without going thru eepromGetAddress() */
+	if ((eePtr >= eePtrSettingsStart) && (eePtr < eePtrSettingsEnd))
+	{
+		eePtr -= eePtrSettingsStart;
+		t = (unsigned int)(pgm_read_byte(&paramAddrs[eePtr]));
+		l = pgm_read_byte(&paramAddrs[eePtr + 1]);
+		l -= (uint8_t)(t);
+
+		return paramCacheRead((uint8_t)(t - eeAdrSettingsStart), l);
+	}
+
+#endif
+	t = eepromGetAddress(eePtr);
 	l = (uint8_t)(t & 0x07);
 	l++;
 	t >>= 3;
@@ -7965,7 +11799,7 @@ unsigned long eepromReadVal(unsigned int eePtr)
 	while (l > 0)
 	{
 		val <<= 8;
-		val += (unsigned long)(eeprom_read_byte((uint8_t *)(t)));
+		val += (unsigned long)(eepromReadByte(t));
 		t++;
 		l--;
 	}
@@ -7973,6 +11807,102 @@ unsigned long eepromReadVal(unsigned int eePtr)
 	return val;
 }
 
+#ifdef useEEPROMwriteQueue
+uint8_t eepromReadByte(unsigned int t)
+{
+	uint8_t oldSREG;
+	uint8_t i;
+	uint8_t b;
+
+	while (true)
+	{
+		oldSREG = SREG; // save interrupt flag status
+		cli(); // disable interrupts
+
+		/* a byte still sitting in the queue is newer than whatever EEPROM holds */
+		i = eeQueueEnd;
+		for (b = eeQueueCount; b > 0; b--)
+		{
+			if (eeQueueAddr[(unsigned int)(i)] == t)
+			{
+				b = eeQueueData[(unsigned int)(i)];
+				SREG = oldSREG; // restore interrupt flag status
+				return b;
+			}
+			i++;
+			if (i == eeQueueSize) i = 0;
+		}
+
+		/* EEPROM can't be read while a write is in progress */
+		if (!(EECR & (1 << EEPE)))
+		{
+			b = eeprom_read_byte((uint8_t *)(t));
+			SREG = oldSREG; // restore interrupt flag status
+			return b;
+		}
+
+		SREG = oldSREG; // restore interrupt flag status
+	}
+}
+
+void eepromWriteByte(unsigned int t, uint8_t w)
+{
+	uint8_t oldSREG;
+	uint8_t i;
+	uint8_t b;
+
+	while (true)
+	{
+		oldSREG = SREG; // save interrupt flag status
+		cli(); // disable interrupts
+
+		/* if this address is already waiting to be written, just replace its byte */
+		i = eeQueueEnd;
+		for (b = eeQueueCount; b > 0; b--)
+		{
+			if (eeQueueAddr[(unsigned int)(i)] == t)
+			{
+				eeQueueData[(unsigned int)(i)] = w;
+				SREG = oldSREG; // restore interrupt flag status
+				return;
+			}
+			i++;
+			if (i == eeQueueSize) i = 0;
+		}
+
+		if (eeQueueCount < eeQueueSize)
+		{
+			eeQueueAddr[(unsigned int)(eeQueueStart)] = t;
+			eeQueueData[(unsigned int)(eeQueueStart)] = w;
+			eeQueueStart++;
+			if (eeQueueStart == eeQueueSize) eeQueueStart = 0;
+			eeQueueCount++;
+
+			EECR |= (1 << EERIE); // let the EEPROM ready interrupt drain the queue
+			SREG = oldSREG; // restore interrupt flag status
+			return;
+		}
+
+		SREG = oldSREG; // queue is full, so let the interrupt make some room
+	}
+}
+
+void eepromFlush(void)
+{
+	while ((eeQueueCount) || (EECR & (1 << EEPE))); // wait until every queued byte is physically in EEPROM
+}
+#else
+uint8_t eepromReadByte(unsigned int t)
+{
+	return eeprom_read_byte((uint8_t *)(t));
+}
+
+void eepromWriteByte(unsigned int t, uint8_t w)
+{
+	eeprom_write_byte((uint8_t *)(t), w);
+}
+#endif
+
 unsigned int eepromGetAddress(unsigned int eePtr)
 {
 	unsigned int t;
@@ -8006,8 +11936,15 @@ unsigned int eepromGetAddress(unsigned int eePtr)
 		l = (uint8_t)(eePtr / tripListSize);
 		eePtr -= (unsigned int)(l) * (unsigned int)(tripListSize);
 
+#ifdef useTripJournal
+		/* an empty trip slot maps onto the next free journal record */
+		l = journalSlotRecord[(unsigned int)(l)];
+		t = journalGetAddress((l == journalNoRecord) ? journalHead : l);
+		t += journalHeaderSize;
+#else
 		t = eeAdrSavedTripsStart + (unsigned int)(l) *
 		    (unsigned int)(eepromTripListSize);
+#endif
 
 		if ((eePtr > 0) && (eePtr < tripListSigPointer))
 		{
@@ -8036,6 +11973,21 @@ unsigned int eepromGetAddress(unsigned int eePtr)
 	return t;
 }
 
+#ifdef useCRC16
+uint16_t crc16update(uint16_t crc, uint8_t b) // CRC-16-CCITT, polynomial 0x1021
+{
+	crc ^= (uint16_t)(b) << 8;
+
+	for (uint8_t x = 0; x < 8; x++)
+	{
+		if (crc & 0x8000) crc = (crc << 1) ^ 0x1021;
+		else crc <<= 1;
+	}
+
+	return crc;
+}
+
+#endif
 void callFuncPointer(const uint8_t * funcIdx)
 {
 	/* go perform action */
@@ -8084,6 +12036,67 @@ unsigned long findCycleLength(unsigned long lastCycle, unsigned long thisCycle)
 	return t;
 }
 
+#ifdef useBackgroundTasks
+/*
+ * background tasks soak up the time the main loop would otherwise spend
+ * waiting for the next loop to start. each one does a bounded slice of work,
+ * and returns 1 if it did anything
+ */
+const uint16_t backgroundTaskList[] PROGMEM = {
+#ifdef useBinaryTelemetry
+	(uint16_t)telemetryPoll,	// encode and send a telemetry frame, if one is due
+#endif
+#ifdef useSerialConfig
+	(uint16_t)serialConfigPoll,	// handle received serial configuration frames
+#endif
+#ifdef useStackWatch
+	(uint16_t)stackScan,		// update the stack low water mark, once per loop
+#endif
+#ifdef useChryslerMAPCorrection
+	(uint16_t)readMAP,		// recalculate the injector correction factor
+#endif
+};
+
+const uint8_t bTLsize = (sizeof(backgroundTaskList) / sizeof(uint16_t));
+
+uint8_t runBackgroundTasks(void)
+{
+	unsigned long t = cycles2();
+	uint8_t b = 0;
+
+	for (uint8_t x = 0; x < bTLsize; x++)
+		b |= ((bFunc)pgm_read_word(&backgroundTaskList[(unsigned int)(x)]))();
+
+	if (b) backgroundCycles += findCycleLength(t, cycles2());
+
+	return b;
+}
+
+#endif
+#ifdef useIdleSleep
+void idleSleep(void)
+{
+	/*
+	 * idle mode keeps the timers, the ADC, the serial port, and the external
+	 * interrupts running, so any of them ends the sleep. the sei() just
+	 * before the sleep instruction cannot be interrupted, so a loop that ends
+	 * after the check below still wakes us up
+	 */
+	cli();
+
+	if ((timerStatus & tsLoopExec) && (timerStatus & tsButtonsUp))
+	{
+		SMCR = (1 << SE); // idle sleep mode
+		sei();
+		__asm__ __volatile__ ("sleep" ::);
+		SMCR = 0;
+	}
+
+	sei();
+}
+
+#endif
+
 int main(void)
 {
 	uint8_t i;
@@ -8091,6 +12104,10 @@ int main(void)
 
 	const uint8_t * bpPtr;
 
+#ifdef useStackWatch
+	stackPaint();
+
+#endif
 	/* disable interrupts while interrupts are being fiddled with */
 	cli();
 
@@ -8159,20 +12176,27 @@ int main(void)
 #endif
 
 #ifdef useSerialPort
-	/* set serial uart baud rate */
-	UBRR0H = (uint8_t)(myubbr >> 8);
-	UBRR0L = (uint8_t)(myubbr);
-	UCSR0A &= ~(1 << U2X0);
+	/* the baud rate is set by initGuino(), once the settings are loaded */
 	/* disable serial uart pins */
 	UCSR0B = 0;
 	/* set for 8 data bits, no parity, and 1 stop bit */
 	UCSR0C = (1 << UCSZ01)| (1 << UCSZ00);
 #ifdef useBufferedSerialPort
-	serialBuffer.init();
+	serialBuffer.init(serialBufferStorage, serialBufferSize);
 	serialBuffer.process = serialTransmitByte;
 	serialBuffer.onEmpty = serialTransmitDisable;
 	serialBuffer.onNoLongerEmpty = serialTransmitEnable;
 #endif
+#ifdef useSerialConfig
+	serialRxBuffer.init(serialRxBufferStorage, serialRxBufferSize);
+	serialRxBuffer.process = serialConfigReceiveByte;
+	/* enable the receiver, so configuration commands can come in */
+	UCSR0B = ((1 << RXEN0) | (1 << RXCIE0));
+#endif
+#endif
+#ifdef useScratchGuard
+	scratchGuardCheck(); // arm the guard bytes
+	scratchOverrunCount = 0;
 #endif
 	/* initialize timer 2 overflow counter */
 	timer2_overflow_count = 0;
@@ -8271,6 +12295,18 @@ int main(void)
 	/* show splash screen for 1.5 seconds */
 	delay2(delay1500ms);
 
+#ifdef useSWEET64verifier
+	if (doSWEET64verify())
+		printStatusMessage(PSTR("S64 Verify FAIL"));
+	else
+		printStatusMessage(PSTR("S64 Verify OK"));
+#endif
+#ifdef useSWEET64selfTest
+	if (doSWEET64selfTest())
+		printStatusMessage(PSTR("S64 Test FAIL"));
+	else
+		printStatusMessage(PSTR("S64 Test OK"));
+#endif
 #ifdef useSavedTrips
 	if (doTripAutoAction(1))
 		printStatusMessage(PSTR("AutoRestore Done"));
@@ -8285,6 +12321,16 @@ int main(void)
 			while (timerCommand & tcStartLoop);
 
 			timerLoopStart = cycles2();
+#ifdef useBackgroundTasks
+			timerBackgroundLength = backgroundCycles;
+			backgroundCycles = 0;
+#endif
+#ifdef useStackWatch
+			stackScanDue = 1;
+#endif
+#ifdef useLoopPhaseTiming
+			phaseLatch();
+#endif
 #ifdef useClock
 			/* perform atomic transfer of clock to main program */
 			cli();
@@ -8306,7 +12352,7 @@ int main(void)
 					 * restore backlight brightness setting
 					 */
 					LCD::setBright(brightnessIdx);
-					if (eepromReadVal(pWakupResetCurrentIdx))
+					if (paramRead(WakupResetCurrent))
 						doTripResetCurrent();
 					timerStatus &= ~tsFellAsleep;
 				}
@@ -8329,6 +12375,9 @@ int main(void)
 				 */
 				timerCommand |= tcWakeUp;
 #endif
+#ifdef useLoopPhaseTiming
+				phaseMark = cycles2();
+#endif
 #ifdef useBarFuelEconVsTime
 				bFEvTcount++;
 
@@ -8347,6 +12396,9 @@ int main(void)
 					tripArray[periodIdx].reset();
 					bFEvTcount = 0;
 				}
+#ifdef useLoopPhaseTiming
+				phaseEnd(phaseBarFEvTidx);
+#endif
 #endif
 				for (uint8_t x = 0; x < tUScount; x++)
 				{
@@ -8377,67 +12429,56 @@ int main(void)
 					if (j & 0x80)
 						sei();
 				}
+#ifdef useLoopPhaseTiming
+				phaseEnd(phaseTripIdx);
+#endif
 
 #ifdef useBarFuelEconVsSpeed
-				FEvSpdTripIdx = (uint8_t)(SWEET64(prgmFEvsSpeed,
-				    instantIdx));
-				if (FEvSpdTripIdx < 255)
-					tripArray[FEvSpdTripIdx].update(
-					    tripArray[instantIdx]);
+				updateBarFEvS();
+#ifdef useLoopPhaseTiming
+				phaseEnd(phaseBarFEvSidx);
+#endif
+#endif
+#ifdef useCoastDownCalculator
+				coastDownUpdate();
+#ifdef useLoopPhaseTiming
+				phaseEnd(phaseCoastDownIdx);
 #endif
+#endif
+#ifdef useBinaryTelemetry
+				telemetryLoopSync();
+				if (paramRead(SerialDataLogging) == 1)
+					doOutputDataLog();
+#else
 #ifdef useSerialPortDataLogging
-				if (eepromReadVal(pSerialDataLoggingIdx))
+				if (paramRead(SerialDataLogging))
 					doOutputDataLog();
 #endif
+#endif
+#if defined(useLoopPhaseTiming) && (defined(useBinaryTelemetry) || defined(useSerialPortDataLogging))
+				phaseEnd(phaseDataLogIdx);
+#endif
 #ifdef useWindowFilter
-				if (eepromReadVal(pWindowFilterIdx))
-				{
-
-					/*
-					 * if no fuel is being consumed, reset
-					 * filter
-					 */
-					if (tripArray[instantIdx].collectedData[
-					    rvInjOpenCycleIdx] == 0)
-					{
-						resetWindowFilter();
-					}
-					/* update the CIC filter */
-					else
-					{
-						if (windowFilterCount <
-						    windowFilterSize)
-							windowFilterCount++;
-						else
-							tripArray[
-							    windowFilterSumIdx].
-							    subtract(tripArray[
-							    windowFilterElemIdx+
-							    windowFilterIdx]);
-
-						tripArray[windowFilterSumIdx].
-						    update(tripArray[
-							instantIdx]);
-						tripArray[windowFilterElemIdx +
-						    windowFilterIdx].transfer(
-							tripArray[instantIdx]);
-						tripArray[instantIdx].
-						    transfer(tripArray[
-							windowFilterSumIdx]);
-
-						windowFilterIdx++;
-						if (windowFilterIdx ==
-						    windowFilterSize)
-							windowFilterIdx = 0;
-					}
-				}
+				updateWindowFilter();
+#ifdef useLoopPhaseTiming
+				phaseEnd(phaseWindowFilterIdx);
+#endif
 #endif
 			}
 		}
 
 		if (timerStatus & tsAwake)
 		{
+#ifdef useLoopPhaseTiming
+			phaseMark = cycles2();
+#endif
 			doRefreshDisplay();
+#ifdef useScratchGuard
+			scratchGuardCheck();
+#endif
+#ifdef useLoopPhaseTiming
+			phaseEnd(phaseDisplayIdx);
+#endif
 		}
 		else
 		{
@@ -8445,8 +12486,13 @@ int main(void)
 			{
 #ifdef useSavedTrips
 				if (doTripAutoAction(0))
+				{
+#ifdef useEEPROMwriteQueue
+					eepromFlush(); // power may go away at any time from here on
+#endif
 					printStatusMessage(
 					    PSTR("AutoSave Done"));
+				}
 #endif
 				/* set backlight brightness to zero */
 				LCD::setBright(0);
@@ -8468,7 +12514,16 @@ int main(void)
 		 * while we're waiting anyway, let's do a few useful things
 		 */
 		while ((timerStatus & tsLoopExec) &&
-		    (timerStatus & tsButtonsUp));
+		    (timerStatus & tsButtonsUp))
+		{
+#ifdef useBackgroundTasks
+			if (runBackgroundTasks())
+				continue;
+#endif
+#ifdef useIdleSleep
+			idleSleep();
+#endif
+		}
 
 		/*
 		 * see if any buttons were pressed, display a brief message
@@ -8476,6 +12531,9 @@ int main(void)
 		 */
 		if (!(timerStatus & tsButtonsUp))
 		{
+#ifdef useLoopPhaseTiming
+			phaseMark = cycles2();
+#endif
 			j = buttonState;
 			/* reset keypress flag */
 			timerStatus |= tsButtonsUp;
@@ -8510,6 +12568,9 @@ int main(void)
 				if (j != buttonsUp)
 					callFuncPointer(bpPtr);
 			}
+#ifdef useLoopPhaseTiming
+			phaseEnd(phaseButtonIdx);
+#endif
 		}
 	}
 }
@@ -0,0 +1,180 @@
+#!/bin/sh
+#
+# sizematrix.sh - build mpguino for a matrix of boards and configure.h feature
+# sets, and report flash/RAM usage and static stack depth for each one
+#
+# usage:  ./sizematrix.sh [baseline.txt] > sizes.txt
+#
+# each build gets its own copy of mpguino.cpp and configure.h, with the
+# feature toggles in the matrix below applied to configure.h. if a baseline
+# table from an earlier run is given, any build whose .text, .data, or .bss
+# grew by more than $SLACK bytes is flagged with REGRESS. any build that does
+# not fit its board, counting the static stack depth against RAM, is flagged
+# with FULL
+#
+# the stack column is the deepest chain of direct calls from main(), plus the
+# deepest interrupt handler, using the frame sizes from -fcallgraph-info=su
+# (gcc 10 or later). calls through function pointers (the display and button
+# function tables, SWEET64 scheduling) are not followed, so treat it as a
+# lower bound. a '+' after the figure means the call graph has recursion. if
+# $CXX does not take -fcallgraph-info, the builds go ahead without it, and the
+# stack column shows '-'
+#
+# CXX, SIZE, and CXXFLAGS may be overridden from the environment
+
+CXX=${CXX:-avr-g++}
+SIZE=${SIZE:-avr-size}
+CXXFLAGS=${CXXFLAGS:-"-Os -std=gnu++11 -ffunction-sections -fdata-sections -Wl,--gc-sections"}
+SLACK=${SLACK:-16}
+
+SRCDIR=$(cd "$(dirname "$0")" && pwd)
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+
+BASELINE=$1
+
+# only ask for call graph info if the compiler knows how to produce it
+CGFLAGS=""
+echo 'int main(void) { return 0; }' > "$WORKDIR/probe.cpp"
+(cd "$WORKDIR" && $CXX -fcallgraph-info=su -c -o probe.o probe.cpp) > /dev/null 2>&1 &&
+    CGFLAGS="-fcallgraph-info=su"
+rm -f "$WORKDIR"/probe.*
+
+#
+# board table - name, toggles, -mmcu value, usable flash bytes, RAM bytes
+# (flash is less any bootloader space)
+#
+boards() {
+	cat <<'EOF'
+atmega328	-	atmega328p	32256	2048
+mega2560	+ArduinoMega2560	atmega2560	253952	8192
+tinkerkit	+TinkerkitLCDmodule	atmega32u4	28672	2560
+EOF
+}
+
+#
+# feature set table - name, then a comma-separated list of configure.h
+# toggles. +option turns an option on, -option turns it off, and - alone
+# leaves configure.h as it is
+#
+features() {
+	cat <<'EOF'
+default	-
+minimal	-useWindowFilter,-useBigFE,-useBigDTE,-useSavedTrips,-useScreenEditor,-useBarFuelEconVsTime,-useBarFuelEconVsSpeed,-useSpiffyBigChars,-useABresultViewer
+serial	+useBinaryTelemetry,+useBufferedSerialPort,+useSerialBaudRate,+useSerialConfig
+logging	+useSerialPortDataLogging,+useFillUpHistory,+useBufferedSerialPort
+clock	+useClock,+useBigTTE
+chrysler	+useChryslerMAPCorrection,+useCalculatedFuelFactor
+coastdown	+useCoastDownCalculator,+useFuelCost
+idle	+trackIdleEOCdata,+useIdleSleep
+eeprom	+useParameterCache,+useEEPROMwriteQueue,+useTripJournal
+debug	+useCPUreading,+useScratchGuard,+useEEPROMviewer
+EOF
+}
+
+# apply a comma-separated toggle list to the configure.h copy in $1
+apply_toggles() {
+	dir=$1
+	for t in $(echo "$2" | tr ',' ' '); do
+		case "$t" in
+		-)
+			;;
+		+*)
+			o=${t#+}
+			grep -q "^//[ 	]*#define $o[ 	]" "$dir/configure.h" ||
+			    { echo "sizematrix: no switchable option $o" >&2; return 1; }
+			sed -i "s|^//[ 	]*#define $o\([ 	]\)|#define $o\1|" "$dir/configure.h"
+			;;
+		-*)
+			o=${t#-}
+			grep -q "^#define $o[ 	]" "$dir/configure.h" ||
+			    { echo "sizematrix: no switchable option $o" >&2; return 1; }
+			sed -i "s|^#define $o\([ 	]\)|//#define $o\1|" "$dir/configure.h"
+			;;
+		esac
+	done
+}
+
+# deepest static stack use, from the callgraph-info files given
+stack_depth() {
+	awk '
+	/^node:/ {
+		n = $0; sub(/.*title: "/, "", n); sub(/".*/, "", n);
+		b = 0;
+		if (match($0, /[0-9]+ bytes/)) b = substr($0, RSTART, RLENGTH) + 0;
+		frame[n] = b;
+	}
+	/^edge:/ {
+		s = $0; sub(/.*sourcename: "/, "", s); sub(/".*/, "", s);
+		t = $0; sub(/.*targetname: "/, "", t); sub(/".*/, "", t);
+		calls[s] = calls[s] " " t;
+	}
+	function depth(f,    i, k, c, d, m) {
+		if (f in done) return done[f];
+		if (f in busy) { recursive = 1; return 0; }
+		busy[f] = 1;
+		m = 0;
+		k = split(calls[f], c, " ");
+		for (i = 1; i <= k; i++) {
+			d = depth(c[i]);
+			if (d > m) m = d;
+		}
+		delete busy[f];
+		done[f] = frame[f] + m;
+		return done[f];
+	}
+	END {
+		isr = 0;
+		for (f in frame)
+			if (f ~ /^__vector_/ && depth(f) > isr) isr = depth(f);
+		printf "%d%s\n", depth("main") + isr, (recursive ? "+" : "");
+	}' "$@"
+}
+
+printf "%-10s %-10s %7s %6s %6s %6s %6s %7s  %s\n" \
+    board features text data bss flash% ram% stack flags
+
+boards | while IFS='	' read -r board btoggles mcu flashmax rammax; do
+	features | while IFS='	' read -r fname ftoggles; do
+		dir="$WORKDIR/$board-$fname"
+		mkdir -p "$dir"
+		cp "$SRCDIR/mpguino.cpp" "$SRCDIR/configure.h" "$dir/"
+
+		if ! apply_toggles "$dir" "$btoggles,$ftoggles" ||
+		    ! (cd "$dir" && $CXX -mmcu="$mcu" $CXXFLAGS $CGFLAGS \
+		    -o mpguino.elf mpguino.cpp > build.log 2>&1); then
+			printf "%-10s %-10s %7s %6s %6s %6s %6s %7s  %s\n" \
+			    "$board" "$fname" - - - - - - BUILDFAIL
+			continue
+		fi
+
+		set -- $($SIZE "$dir/mpguino.elf" | awk 'NR == 2 { print $1, $2, $3 }')
+		text=$1 data=$2 bss=$3
+		stack=-
+		[ -n "$CGFLAGS" ] && stack=$(stack_depth "$dir"/*.ci)
+
+		flags=""
+		[ $((text + data)) -gt "$flashmax" ] && flags="$flags FULL(flash)"
+		ramused=$((data + bss))
+		[ "$stack" != "-" ] && ramused=$((ramused + ${stack%+}))
+		[ "$ramused" -gt "$rammax" ] && flags="$flags FULL(ram)"
+
+		if [ -n "$BASELINE" ]; then
+			old=$(awk -v b="$board" -v f="$fname" \
+			    '$1 == b && $2 == f { print $3, $4, $5 }' "$BASELINE")
+			if [ -n "$old" ]; then
+				set -- $old
+				[ "$1" != "-" ] &&
+				    { [ $((text - $1)) -gt "$SLACK" ] ||
+				    [ $((data - $2)) -gt "$SLACK" ] ||
+				    [ $((bss - $3)) -gt "$SLACK" ]; } &&
+				    flags="$flags REGRESS(${1}/${2}/${3})"
+			fi
+		fi
+
+		printf "%-10s %-10s %7d %6d %6d %6d %6d %7s %s\n" \
+		    "$board" "$fname" "$text" "$data" "$bss" \
+		    $(((text + data) * 100 / flashmax)) \
+		    $(((data + bss) * 100 / rammax)) "$stack" "$flags"
+	done
+done
@@ -0,0 +1,13 @@
+/* host stand-in for <avr/eeprom.h> - the EEPROM is a plain array that a test can preload or inspect */
+#ifndef __host_avr_eeprom_h__
+#define __host_avr_eeprom_h__
+
+#include <stdint.h>
+#include "io.h"
+
+extern uint8_t hostEEPROM[E2END + 1];
+
+static inline uint8_t eeprom_read_byte(const uint8_t * p) { return hostEEPROM[(uintptr_t)(p)]; }
+static inline void eeprom_write_byte(uint8_t * p, uint8_t v) { hostEEPROM[(uintptr_t)(p)] = v; }
+
+#endif
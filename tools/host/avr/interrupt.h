@@ -0,0 +1,15 @@
+/* host stand-in for <avr/interrupt.h> - interrupt handlers become plain functions that a test can call */
+#ifndef __host_avr_interrupt_h__
+#define __host_avr_interrupt_h__
+
+#include "io.h"
+
+#define ISR(vector) extern "C" void vector(void)
+
+/* every cli() gives the host a chance to finish an EEPROM write and fire EE_READY, like the hardware would */
+void hostTick(void);
+
+static inline void cli(void) { hostTick(); }
+static inline void sei(void) {}
+
+#endif
@@ -0,0 +1,183 @@
+/* host stand-ins for the ATmega328P I/O registers and bit names used by mpguino.cpp
+
+   every register is a plain variable, so writes go nowhere and reads return whatever was last written;
+   bit names are all 0 except where a test needs to see a particular bit flip */
+#ifndef __host_avr_io_h__
+#define __host_avr_io_h__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define E2END 1023
+
+static volatile uint8_t ADATE = 0;
+static volatile uint8_t ADC1D = 0;
+static volatile uint8_t ADC2D = 0;
+static volatile uint8_t ADC3D = 0;
+static volatile uint8_t ADC4D = 0;
+static volatile uint8_t ADC5D = 0;
+static volatile uint8_t ADCH = 0;
+static volatile uint8_t ADCL = 0;
+static volatile uint8_t ADCSRA = 0;
+static volatile uint8_t ADCSRB = 0;
+static volatile uint8_t ADEN = 0;
+static volatile uint8_t ADIE = 0;
+static volatile uint8_t ADIF = 0;
+static volatile uint8_t ADMUX = 0;
+static volatile uint8_t ADPS0 = 0;
+static volatile uint8_t ADPS1 = 0;
+static volatile uint8_t ADPS2 = 0;
+static volatile uint8_t ADSC = 0;
+static volatile uint8_t COM0A0 = 0;
+static volatile uint8_t COM0A1 = 0;
+static volatile uint8_t COM0B0 = 0;
+static volatile uint8_t COM0B1 = 0;
+static volatile uint8_t COM1A0 = 0;
+static volatile uint8_t COM1A1 = 0;
+static volatile uint8_t COM1B0 = 0;
+static volatile uint8_t COM1B1 = 0;
+static volatile uint8_t COM2A0 = 0;
+static volatile uint8_t COM2A1 = 0;
+static volatile uint8_t COM2B0 = 0;
+static volatile uint8_t COM2B1 = 0;
+static volatile uint8_t CS00 = 0;
+static volatile uint8_t CS01 = 0;
+static volatile uint8_t CS02 = 0;
+static volatile uint8_t CS10 = 0;
+static volatile uint8_t CS11 = 0;
+static volatile uint8_t CS12 = 0;
+static volatile uint8_t CS20 = 0;
+static volatile uint8_t CS21 = 0;
+static volatile uint8_t CS22 = 0;
+static volatile uint8_t DDB1 = 0;
+static volatile uint8_t DDD6 = 0;
+static volatile uint8_t DDRB = 0;
+static volatile uint8_t DDRD = 0;
+static volatile uint8_t DIDR0 = 0;
+static volatile uint8_t EICRA = 0;
+static volatile uint8_t EIFR = 0;
+static volatile uint8_t EIMSK = 0;
+static volatile uint8_t FOC0A = 0;
+static volatile uint8_t FOC0B = 0;
+static volatile uint8_t FOC1A = 0;
+static volatile uint8_t FOC1B = 0;
+static volatile uint8_t FOC2A = 0;
+static volatile uint8_t FOC2B = 0;
+static volatile uint8_t ICES1 = 0;
+static volatile uint8_t ICF1 = 0;
+static volatile uint8_t ICIE1 = 0;
+static volatile uint8_t ICNC1 = 0;
+static volatile uint8_t INT0 = 0;
+static volatile uint8_t INT1 = 0;
+static volatile uint8_t INTF0 = 0;
+static volatile uint8_t INTF1 = 0;
+static volatile uint8_t ISC00 = 0;
+static volatile uint8_t ISC01 = 0;
+static volatile uint8_t ISC10 = 0;
+static volatile uint8_t ISC11 = 0;
+static volatile uint8_t MUX0 = 0;
+static volatile uint8_t MUX1 = 0;
+static volatile uint8_t MUX2 = 0;
+static volatile uint8_t MUX3 = 0;
+static volatile uint8_t OCF0A = 0;
+static volatile uint8_t OCF0B = 0;
+static volatile uint8_t OCF1A = 0;
+static volatile uint8_t OCF1B = 0;
+static volatile uint8_t OCF2A = 0;
+static volatile uint8_t OCF2B = 0;
+static volatile uint8_t OCIE0A = 0;
+static volatile uint8_t OCIE0B = 0;
+static volatile uint8_t OCIE1A = 0;
+static volatile uint8_t OCIE1B = 0;
+static volatile uint8_t OCIE2A = 0;
+static volatile uint8_t OCIE2B = 0;
+static volatile uint8_t OCR0A = 0;
+static volatile uint8_t OCR1A = 0;
+static volatile uint8_t PCICR = 0;
+static volatile uint8_t PCIE1 = 0;
+static volatile uint8_t PCINT8 = 0;
+static volatile uint8_t PCMSK1 = 0;
+static volatile uint8_t PINC = 0;
+static volatile uint8_t PINC0 = 0;
+static volatile uint8_t PORTB = 0;
+static volatile uint8_t PORTB0 = 0;
+static volatile uint8_t PORTB4 = 0;
+static volatile uint8_t PORTB5 = 0;
+static volatile uint8_t PORTD = 0;
+static volatile uint8_t PORTD4 = 0;
+static volatile uint8_t PORTD5 = 0;
+static volatile uint8_t PORTD7 = 0;
+static volatile uint8_t REFS0 = 0;
+static volatile uint8_t SREG = 0;
+static volatile uint8_t TCCR0A = 0;
+static volatile uint8_t TCCR0B = 0;
+static volatile uint8_t TCCR1A = 0;
+static volatile uint8_t TCCR1B = 0;
+static volatile uint8_t TCCR1C = 0;
+static volatile uint8_t TCCR2A = 0;
+static volatile uint8_t TCCR2B = 0;
+static volatile uint8_t TCNT2 = 0;
+static volatile uint8_t TIFR0 = 0;
+static volatile uint8_t TIFR1 = 0;
+static volatile uint8_t TIFR2 = 0;
+static volatile uint8_t TIMSK0 = 0;
+static volatile uint8_t TIMSK1 = 0;
+static volatile uint8_t TIMSK2 = 0;
+static volatile uint8_t TOIE0 = 0;
+static volatile uint8_t TOIE1 = 0;
+static volatile uint8_t TOIE2 = 0;
+static volatile uint8_t TOV0 = 0;
+static volatile uint8_t TOV1 = 0;
+static volatile uint8_t TOV2 = 0;
+static volatile uint8_t WGM00 = 0;
+static volatile uint8_t WGM01 = 0;
+static volatile uint8_t WGM02 = 0;
+static volatile uint8_t WGM10 = 0;
+static volatile uint8_t WGM11 = 0;
+static volatile uint8_t WGM12 = 0;
+static volatile uint8_t WGM13 = 0;
+static volatile uint8_t WGM20 = 0;
+static volatile uint8_t WGM21 = 0;
+static volatile uint8_t WGM22 = 0;
+static volatile uint8_t UCSR0B = 0;
+static volatile uint8_t TXEN0 = 0;
+static volatile uint8_t UDRE0 = 5;
+static volatile uint8_t UBRR0H = 0;
+static volatile uint8_t UBRR0L = 0;
+static volatile uint8_t U2X0 = 1;
+static volatile uint8_t UCSR0C = 0;
+static volatile uint8_t UCSZ01 = 0;
+static volatile uint8_t UCSZ00 = 0;
+static volatile uint8_t UDRIE0 = 0;
+
+static volatile uint8_t UCSR0A = 0xFF;	/* UDRE0 always reads as set, so the transmitter never stalls - U2X0 gets a bit of its own, so setting the baud rate leaves it alone */
+static volatile uint8_t RXEN0 = 4;
+static volatile uint8_t RXCIE0 = 7;
+
+/* every byte written to UDR0 goes to hostSerialTx(), and reads return whatever a test put in rx */
+void hostSerialTx(uint8_t c);
+
+struct hostUDR
+{
+	uint8_t rx;
+	hostUDR & operator = (int c) { hostSerialTx((uint8_t)(c)); return *this; }
+	operator uint8_t () const { return rx; }
+};
+
+static hostUDR UDR0;
+
+static volatile uint16_t EEAR = 0;
+static volatile uint8_t EEDR = 0;
+static volatile uint8_t EECR = 0;
+#define EERE 0
+#define EEPE 1
+#define EEMPE 2
+#define EERIE 3
+
+static volatile uint8_t SMCR = 0;
+#define SE 0
+
+static inline char * itoa(int v, char * s, int r) { sprintf(s, (r == 16) ? "%x" : "%d", v); return s; }
+
+#endif
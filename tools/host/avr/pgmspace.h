@@ -0,0 +1,15 @@
+/* host stand-in for <avr/pgmspace.h> - flash and RAM are the same address space on the host */
+#ifndef __host_avr_pgmspace_h__
+#define __host_avr_pgmspace_h__
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) ((uintptr_t)(*(p)))
+#define pgm_read_dword(p) (*(p))
+#define strcpy_P strcpy
+
+#endif
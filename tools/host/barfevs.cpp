@@ -0,0 +1,137 @@
+/* compares the FE vs speed histogram with the 15 Trip version it replaced, over a simulated six hour drive
+
+   build it with -DuseBarFuelEconVsSpeed=true. the old code picked a bin with a SWEET64 program, kept here as
+   prgmOldFEvsSpeed, and updated a whole Trip per bin. with linear bars, every loop has to land in the same bin as it
+   did before, and the fuel economy, fuel used, motion time, and distance of each bin have to agree to within 0.1%.
+   log-spaced bars have no old counterpart, so they are only run for their bin edges and a sanity check */
+#include <math.h>
+#include "host.h"
+
+#ifndef useBarFuelEconVsSpeed
+#error "build this with -DuseBarFuelEconVsSpeed=true"
+#endif
+
+/* the replaced bin selection program - returns the bin number, or 255 if the speed is off the graph */
+const uint8_t prgmOldFEvsSpeed[] PROGMEM = {
+	instrLdEEPROM, 0x01, pBarLowSpeedCutoffIdx,
+	instrLdEEPROM, 0x02, pPulsesPerDistanceIdx,
+	instrCall, idxS64doMultiply,
+	instrDivByConst, idxDecimalPoint,
+	instrSwap, 0x23,
+	instrLdTripVar, 0x02, rvVSSpulseIdx,
+	instrMulByConst, idxCyclesPerSecond,
+	instrMulByConst, idxSecondsPerHour,
+	instrDivByTripVar, rvVSScycleIdx,
+	instrSkipIfLTorE, 0x32, 4,
+	instrLdByte, 0x02, 0xFF,
+	instrDone,
+	instrSubYfromX, 0x23,
+	instrSwap, 0x23,
+	instrLdEEPROM, 0x01, pBarSpeedQuantumIdx,
+	instrLdEEPROM, 0x02, pPulsesPerDistanceIdx,
+	instrCall, idxS64doMultiply,
+	instrDivByConst, idxDecimalPoint,
+	instrSkipIfZero, 0x02, 235,
+	instrSwap, 0x21,
+	instrSwap, 0x23,
+	instrCall, idxS64doDivide,
+	instrLdByte, 0x01, bgDataSize,
+	instrSkipIfLTorE, 0x12, 223,
+	instrDone
+};
+
+Trip oldBins[(unsigned int)(bgDataSize)];
+
+const uint8_t barValues[4] = { tFuelEcon, tFuelUsed, tMotionTime, tDistance };
+
+int main(void)
+{
+	unsigned int fails = 0;
+
+	for (uint8_t logMode = 0; logMode < 2; logMode++)
+	{
+		unsigned long moved = 0;
+		unsigned long mismatches = 0;
+		unsigned long loops = 0;
+		double v = 0.0;
+
+		loadParams();
+		eepromWriteVal(pBarSpeedLogIdx, logMode);
+		initBarFEvS();
+		doResetBarFEvS();
+		for (uint8_t x = 0; x < bgDataSize; x++) oldBins[(unsigned int)(x)].reset();
+
+		printf("%s bars, edges:", (logMode) ? "log-spaced" : "linear");
+		for (uint8_t x = 0; x <= bgDataSize; x++) printf(" %lu", (unsigned long)(FEvSpdEdge[(unsigned int)(x)]));
+		printf("\n");
+
+		unsigned long ppd = eepromReadVal(pPulsesPerDistanceIdx);
+
+		hostRandomState = 0x9E3779B97F4A7C15ull;
+
+		/* a random walk between standstill and 115 mph (or kph), one step per main loop pass */
+		for (unsigned long i = 0; i < 6ul * 3600ul * loopsPerSecond; i++)
+		{
+			Trip & in = tripArray[instantIdx];
+			unsigned long pulses;
+			uint8_t o;
+
+			v += (double)((int)(hostRandom() % 2001) - 1000) / 400.0;
+			if (v < 0.0) v = 0.0;
+			if (v > 115.0) v = 115.0;
+
+			in.reset();
+			pulses = (unsigned long)(v * ppd / (3600.0 * loopsPerSecond));
+			in.collectedData[rvVSSpulseIdx] = pulses;
+			in.collectedData[rvVSScycleIdx] = (pulses) ? (unsigned long)(pulses * (double)(t2CyclesPerSecond) * 3600.0 / (v * ppd)) : 0;
+			in.collectedData[rvInjPulseIdx] = 40;
+			in.collectedData[rvInjOpenCycleIdx] = 40 * (1000 + hostRandom() % 3000);
+
+			o = (uint8_t)(SWEET64(prgmOldFEvsSpeed, instantIdx));
+			if (o < bgDataSize) oldBins[(unsigned int)(o)].update(in);
+
+			updateBarFEvS();
+			if (FEvSpdBinIdx < bgDataSize) moved++;
+			if (o != FEvSpdBinIdx) mismatches++;
+			loops++;
+		}
+
+		if (logMode)
+		{
+			printf("log-spaced bars: %lu of %lu loops landed in a bin\n", moved, loops);
+			if (moved == 0) fails++;
+			continue;
+		}
+
+		printf("linear bars: %lu of %lu loops binned differently from the old code\n", mismatches, loops);
+		if (mismatches) fails++;
+
+		for (uint8_t x = 0; x < bgDataSize; x++)
+		{
+			unsigned long nv[4];
+			unsigned long ov[4];
+
+			loadBarFEvS(x);
+			for (uint8_t k = 0; k < 4; k++) nv[k] = doCalculate(barValues[k], FEvsSpeedIdx);
+			tripArray[FEvsSpeedIdx].transfer(oldBins[(unsigned int)(x)]);
+			for (uint8_t k = 0; k < 4; k++) ov[k] = doCalculate(barValues[k], FEvsSpeedIdx);
+
+			for (uint8_t k = 0; k < 4; k++)
+			{
+				double d = fabs((double)(nv[k]) - (double)(ov[k]));
+
+				if ((d > 2.0) && (d > (double)(ov[k]) * 0.001))
+				{
+					printf("bin %u value %u: %lu, old code %lu\n", x, k, nv[k], ov[k]);
+					fails++;
+				}
+			}
+		}
+	}
+
+	printf("RAM: %u bytes for the old bins, %u bytes now\n", (unsigned int)(bgDataSize * sizeof(Trip)),
+	    (unsigned int)(sizeof(Trip) + sizeof(FEvSpdPulses) + sizeof(FEvSpdCycles) + sizeof(FEvSpdFuel) + sizeof(FEvSpdEdge)));
+	printf("%u failures\n", fails);
+
+	return (fails ? 1 : 0);
+}
@@ -0,0 +1,120 @@
+/* runs every benchmark kernel on the host, and checks the registry tables against each other
+
+   build it with -DuseBenchMark=true, plus whatever options add kernels of their own. benchMarkList holds 16 bit
+   function addresses, which only mean something on the AVR, so the kernels are called thru hostBenchMarkList below
+   instead - it has to follow benchMarkList, #ifdef for #ifdef. host times are only good for comparing one kernel
+   with another, or a kernel before and after a change.
+
+   the big number kernel writes to the LCD, and on the host there is no timer interrupt to drain the LCD buffer,
+   so it stands in as doNothing here.
+
+   the "S64FE" and "oldFE" kernels run prgmFuelEcon as it is now, and as it was encoded before the fused multiply and
+   divide instructions. both have to give the same result for the same trip data, in either unit mode, and the size
+   of each is printed along with its time */
+#include <time.h>
+#include "host.h"
+
+#ifndef useBenchMark
+#error "build this with -DuseBenchMark=true"
+#endif
+
+const pFunc hostBenchMarkList[] = {
+	benchMarkISqrt,
+	benchMarkMul64,
+	benchMarkDiv64,
+	benchMarkFuelEcon,
+	benchMarkOldFuelEcon,
+	benchMarkFormat,
+#ifdef useBigNumberDisplay
+	doNothing,
+#endif
+	benchMarkTripUpdate,
+	benchMarkParamRead,
+};
+
+/* number of strings in a "name\0" "name\0" ... table */
+unsigned int countNames(const char * str, unsigned int len)
+{
+	unsigned int n = 0;
+
+	for (unsigned int x = 0; x + 1 < len; x++) if (str[x] == 0) n++; // the last \0 is the one the compiler adds
+
+	return n;
+}
+
+double hostSeconds(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (double)(t.tv_sec) + (double)(t.tv_nsec) * 1e-9;
+}
+
+int main(void)
+{
+	unsigned int fails = 0;
+	unsigned int n;
+
+	n = countNames(benchMarkNames, sizeof(benchMarkNames));
+	if (n != bMLsize)
+	{
+		printf("benchMarkNames has %u names for %u kernels\n", n, bMLsize);
+		fails++;
+	}
+
+	n = sizeof(hostBenchMarkList) / sizeof(pFunc);
+	if (n != bMLsize)
+	{
+		printf("hostBenchMarkList has %u kernels, benchMarkList has %u\n", n, bMLsize);
+		fails++;
+	}
+
+	if (fails == 0)
+	{
+		unsigned int diffs = 0;
+
+		loadParams();
+
+		for (unsigned int x = 0; x < 20000; x++)
+		{
+			tripArray[tankIdx].reset();
+			tripArray[tankIdx].collectedData[rvVSSpulseIdx] = (unsigned long)(hostRandomBits(32));
+			tripArray[tankIdx].collectedData[rvInjOpenCycleIdx] = (unsigned long)(hostRandomBits(32));
+			tripArray[tankIdx].collectedData[rvInjOpenCycleIdx + 1] = (unsigned long)(hostRandomBits(8));
+			metricFlag = (uint8_t)(x & 1);
+
+			if (SWEET64(prgmFuelEcon, tankIdx) != SWEET64(prgmBenchMarkOldFuelEcon, tankIdx))
+			{
+				if (diffs < 10) printf("S64FE and oldFE differ for trip data %u\n", x);
+				diffs++;
+			}
+		}
+
+		metricFlag = 0;
+		if (diffs) fails++;
+
+		/* the old encoding has prgmFindCyclesPerQuantity written in, less its call and its instrDone */
+		printf("S64FE %u bytes, oldFE %u bytes, fuel economy results differ %u times out of 20000\n",
+		    (unsigned int)(sizeof(prgmFuelEcon) + sizeof(prgmFindCyclesPerQuantity)),
+		    (unsigned int)(sizeof(prgmBenchMarkOldFuelEcon) + 2 + 1), diffs);
+
+		/* some trip data, so the trip kernels have real numbers to chew on */
+		for (unsigned int x = 0; x < rvLength; x++) tripArray[tankIdx].collectedData[x] = 0x00123456ul + x * 0x00010203ul;
+
+		for (uint8_t x = 0; x < bMLsize; x++)
+		{
+			unsigned int loops = pgm_read_word(&benchMarkLoops[(unsigned int)(x)]) * 100;
+			double t = hostSeconds();
+
+			for (unsigned int y = 0; y < loops; y++) hostBenchMarkList[(unsigned int)(x)]();
+			t = hostSeconds() - t;
+
+			printf("%-8s %8u calls %10.1f ns/call\n", findStr(benchMarkNames, x), loops, t * 1e9 / loops);
+		}
+	}
+
+	printf("%u benchmarks, %u failures\n", bMLsize, fails);
+
+	return (fails ? 1 : 0);
+}
@@ -0,0 +1,101 @@
+/* feeds the coastdown fit synthetic traces with known C(d) and C(rr), and checks what comes back
+
+   build it with -DuseCoastDownCalculator=true. the samples go straight into coastDownAddSample(), in mm/s, the same as
+   coastDownUpdate() would hand them over, so no trip data has to be faked */
+#include <math.h>
+#include "host.h"
+
+#ifndef useCoastDownCalculator
+#error "build this with -DuseCoastDownCalculator=true"
+#endif
+
+const double mass = 1500.0;	// kg
+const double area = 2.2;	// m^2
+const double rho = 1.2;		// kg/m^3
+
+unsigned int fails;
+
+void check(int ok, const char * what)
+{
+	if (ok) return;
+	printf("FAIL: %s\n", what);
+	fails++;
+}
+
+void startOver(void)
+{
+	coastDownSamples = 0;
+	coastDownSolvedSamples = 0;
+	coastDownActive = 0;
+	coastDownFitReady = 0;
+	coastDownSumU = 0;
+	coastDownSumUU = 0;
+	coastDownSumA = 0;
+	coastDownSumUA = 0;
+}
+
+/* one coastdown from v0 to v1 (m/s), one sample per main loop pass, with a constant extra deceleration on top */
+void coast(double cd, double crr, double v0, double v1, double extra)
+{
+	double k = rho * cd * area / (2.0 * mass);
+	double v = v0;
+	unsigned long last = (unsigned long)(v * 1000.0 + 0.5);
+
+	while (v > v1)
+	{
+		v -= (crr * 9.80665 + k * v * v + extra) / loopsPerSecond;
+
+		unsigned long now = (unsigned long)(v * 1000.0 + 0.5);
+
+		coastDownAddSample(last, now);
+		last = now;
+	}
+}
+
+int main(void)
+{
+	uint8_t saved[E2END + 1];
+
+	loadParams();
+	metricFlag = 1;
+	eepromWriteVal(pVehicleMassIdx, (unsigned long)(mass));
+	eepromWriteVal(pVehicleFrontalAreaIdx, (unsigned long)(area * 1000.0));
+	eepromWriteVal(pLocustDensityIdx, (unsigned long)(rho * 1000.0));
+	memcpy(saved, hostEEPROM, sizeof(saved));
+
+	/* a clean engine-off coastdown, run twice, gives back what went in, and leaves EEPROM alone */
+	startOver();
+	coast(0.30, 0.010, 30.0, 6.0, 0.0);
+	coast(0.30, 0.010, 30.0, 6.0, 0.0);
+	coastDownSolve();
+	printf("clean coastdown: %u samples, C(d) %u, C(rr) %u (both * 1000)\n", coastDownSamples, coastDownCd, coastDownCrr);
+	check(coastDownFitReady, "clean coastdown gives a fit");
+	check(abs((int)(coastDownCd) - 300) <= 9, "C(d) within 3%");
+	check(abs((int)(coastDownCrr) - 10) <= 1, "C(rr) within 0.001");
+	check(memcmp(saved, hostEEPROM, sizeof(saved)) == 0, "a fit is not written to EEPROM until accepted");
+
+	/* decel fuel cut - same car, in gear, with engine braking. the fit still comes out, but only as a pending one */
+	startOver();
+	coast(0.30, 0.010, 30.0, 6.0, 0.8);
+	coastDownSolve();
+	printf("decel fuel cut: %u samples, C(d) %u, C(rr) %u (both * 1000)\n", coastDownSamples, coastDownCd, coastDownCrr);
+	check(memcmp(saved, hostEEPROM, sizeof(saved)) == 0, "decel fuel cut fit is not written to EEPROM");
+
+	/* steady speed gives nothing to fit against */
+	startOver();
+	for (unsigned int x = 0; x < 500; x++) coastDownAddSample(20000ul, 20000ul);
+	coastDownSolve();
+	check(coastDownFitReady == 0, "steady speed gives no fit");
+
+	/* sums where scaling num down also shifts den all the way to 0 - this used to divide by zero */
+	startOver();
+	coastDownSamples = 2;
+	coastDownSumUU = 1;
+	coastDownSumUA = 1ll << 40;
+	coastDownSolve();
+	check(coastDownFitReady == 0, "den shifted to 0 gives no fit");
+
+	printf("%u failures\n", fails);
+
+	return (fails ? 1 : 0);
+}
@@ -0,0 +1,108 @@
+/* the device end of the fill-up log, for tools/test_mpgfillups.py to read
+
+   drives the sketch thru a run of tanks - each one filled with random trip data, then reset with doTripResetTank() -
+   and sends the fill-up log out with doFillUpDump() after the 5th tank and after the last one. the two dumps come out
+   on stdout back to back, the way a capture of the serial port would hold them. what the sketch put into each record
+   goes to stderr, one "seq,units,time,distance,fuel,engine time,idle fuel" line per tank, in the same units as the dump.
+   the 8th and 9th tanks are logged in metric units, the rest in SAE.
+
+     fillups [TANKS]
+
+   there is no timer interrupt on the host, so SIGALRM stands in for the part of it that ends a status line message,
+   and the LCD buffer is emptied on every cli() */
+#include <signal.h>
+#include <sys/time.h>
+#include "host.h"
+
+#ifndef useFillUpHistory
+#error "build this with -DuseFillUpHistory=true"
+#endif
+#ifndef useLegacyLCDbuffered
+#error "this needs the buffered LCD, which is on by default"
+#endif
+
+void hostLCDdrain(void)
+{
+	static uint8_t busy = 0;
+
+	if (busy) return; // pull() does a cli() of its own
+	busy = 1;
+	while (!(lcdBuffer.bufferStatus & bufferIsEmpty)) lcdBuffer.pull();
+	busy = 0;
+}
+
+void hostLCDoutput(uint8_t c)
+{
+}
+
+void hostTimer(int sig)
+{
+	if (timerCommand & tcDisplayDelay) timerCommand &= ~tcDisplayDelay;
+}
+
+/* a tank's worth of random trip data - the idle part of a tank gets a 1/scale share of its fuel and time */
+void fillTrip(Trip & t, unsigned long scale)
+{
+	t.reset();
+	t.collectedData[rvVSSpulseIdx] = (scale > 1) ? 0 : (unsigned long)(hostRandom() % 5000000ul) + 1000000ul;
+	t.collectedData[rvInjPulseIdx] = (unsigned long)(hostRandom() % 5000000ul) / scale + 1000ul;
+	t.collectedData[rvVSScycleIdx] = (scale > 1) ? 0 : (unsigned long)(hostRandom());
+	t.collectedData[rvVSScycleIdx + 1] = (scale > 1) ? 0 : (unsigned long)(hostRandom() % 4);
+	t.collectedData[rvInjCycleIdx] = (unsigned long)(hostRandom() % 0x80000000ul) / scale + 0x10000000ul / scale;
+	t.collectedData[rvInjCycleIdx + 1] = (scale > 1) ? 0 : (unsigned long)(hostRandom() % 4);
+	t.collectedData[rvInjOpenCycleIdx] = (unsigned long)(hostRandom() % 0x80000000ul) / scale + 0x10000000ul / scale;
+}
+
+void sendDump(void)
+{
+	doFillUpDump();
+	fwrite(hostTxBuffer, 1, hostTxLength, stdout);
+	fflush(stdout);
+	hostTxLength = 0;
+}
+
+int main(int argc, char * argv[])
+{
+	unsigned int tanks = (argc > 1) ? atoi(argv[1]) : 12;
+	struct itimerval tick;
+
+	lcdBuffer.init(lcdBufferStorage, lcdBufferSize);
+	lcdBuffer.process = hostLCDoutput;
+	hostTickHook = hostLCDdrain;
+
+	signal(SIGALRM, hostTimer);
+	tick.it_interval.tv_sec = 0;
+	tick.it_interval.tv_usec = 1000;
+	tick.it_value = tick.it_interval;
+	setitimer(ITIMER_REAL, &tick, 0);
+
+	loadParams();
+
+	for (unsigned int x = 0; x < tanks; x++)
+	{
+		metricFlag = ((x == 7) || (x == 8)) ? 1 : 0;
+		systemCycles[0] += (unsigned long)(hostRandom() % 2000000000ul);
+
+		fillTrip(tripArray[tankIdx], 1);
+#ifdef trackIdleEOCdata
+		fillTrip(tripArray[eocIdleTankIdx], 20);
+#endif
+
+		unsigned long t = convertTime((uint32_t *)(systemCycles));
+
+		fprintf(stderr, "%u,%s,%lu,%lu,%lu,%lu,", x, (metricFlag) ? "metric" : "SAE", (unsigned long)(t),
+		    (unsigned long)(doCalculate(tDistance, tankIdx)), (unsigned long)(doCalculate(tFuelUsed, tankIdx)),
+		    (unsigned long)(doCalculate(tEngineRunTime, tankIdx)));
+#ifdef trackIdleEOCdata
+		fprintf(stderr, "%lu\n", (unsigned long)(doCalculate(tFuelUsed, eocIdleTankIdx)));
+#else
+		fprintf(stderr, "0\n");
+#endif
+
+		doTripResetTank();
+
+		if ((x == 4) || (x + 1 == tanks)) sendDump();
+	}
+
+	return 0;
+}
@@ -0,0 +1,64 @@
+/* common prologue for the host tests - pulls in the whole sketch with main() renamed, plus a little emulated hardware
+
+   the Makefile feeds in build/mpguino.cpp, a copy of the sketch with its "long" types pinned to their AVR widths */
+#ifndef __host_h__
+#define __host_h__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define main mpguinoMain
+#include "mpguino.cpp"
+#undef main
+
+uint8_t hostEEPROM[E2END + 1];
+int __bss_end;
+int * __brkval;
+
+uint8_t hostTxBuffer[65536];
+unsigned long hostTxLength;
+
+void hostSerialTx(uint8_t c)
+{
+	if (hostTxLength < sizeof(hostTxBuffer)) hostTxBuffer[hostTxLength] = c;
+	hostTxLength++;
+}
+
+/* called from every cli(), which cycles2() does too - a test can point it at something that moves the timer along */
+void (* hostTickHook)(void) = 0;
+
+void hostTick(void)
+{
+	if (hostTickHook) hostTickHook();
+	if (EECR & (1 << EEPE))
+	{
+		hostEEPROM[EEAR] = EEDR;
+		EECR &= ~(1 << EEPE);
+	}
+#ifdef useEEPROMwriteQueue
+	if (EECR & (1 << EERIE)) EE_READY_vect();
+#endif
+}
+
+/* xorshift64, so every run of a test sees the same "random" data */
+uint64_t hostRandomState = 0x9E3779B97F4A7C15ull;
+
+uint64_t hostRandom(void)
+{
+	hostRandomState ^= hostRandomState << 13;
+	hostRandomState ^= hostRandomState >> 7;
+	hostRandomState ^= hostRandomState << 17;
+	return hostRandomState;
+}
+
+/* a random value of random bit length, so small and huge numbers both get exercised */
+uint64_t hostRandomBits(uint8_t maxBits)
+{
+	uint8_t b = (uint8_t)(hostRandom() % (maxBits + 1));
+
+	return (b ? (hostRandom() >> (64 - b)) : 0);
+}
+
+#endif
@@ -0,0 +1,80 @@
+/* checks iSqrt() and iSqrtSeed() against the exact square root, for every one of the 65536 possible inputs
+
+   build it with -DuseIsqrt=true (or with any option that brings it in, such as useCalculatedFuelFactor). iSqrt()
+   has to give the nearest whole number to 4096 * sqrt(n / 4096) = 64 * sqrt(n) every time, and iSqrtSeed() has to
+   stay within the 2 counts that iSqrt() is written to correct. for comparison, the worst error of the iterative
+   iSqrt() that the table lookup replaced is printed as well, over the pressure ratios of 0.5 to 2 it was meant for */
+#include <math.h>
+#include "host.h"
+
+#ifndef useIsqrt
+#error "build this with -DuseIsqrt=true"
+#endif
+
+/* the iterative iSqrt() that came before the table lookup, at AVR widths */
+uint16_t oldSqrt(uint16_t n)
+{
+	uint32_t w = 4096;
+	uint16_t t = 4096;
+	int16_t d = 0;
+	int16_t od = 0;
+
+	for (uint8_t x = 0; x < 5; x++)
+	{
+		od = d;
+		d = (int16_t)(uint16_t)(n - (uint16_t)(w));
+		d >>= 1;
+		t += d;
+		od += d;
+		if ((d == 0) || (od == 0)) break;
+		w = (uint32_t)(t) * (uint32_t)(t);
+		w >>= 12;
+	}
+
+	return t;
+}
+
+int main(void)
+{
+	unsigned int fails = 0;
+	int seedWorst = 0;
+	int oldWorst = 0;
+	unsigned int oldWorstN = 0;
+
+	for (unsigned int n = 0; n < 65536; n++)
+	{
+		uint64_t t = iSqrt(n);
+		uint64_t s = (uint64_t)(n) << 12;
+		int e = (int)(lround(64.0 * sqrt((double)(n))));
+		int d;
+
+		/* t is the nearest root of n * 4096 exactly when t * t - t < n * 4096 <= t * t + t */
+		if ((n) && ((t * t - t >= s) || (s > t * t + t)))
+		{
+			if (fails < 10) printf("iSqrt(%u) = %u, nearest is %d\n", n, (unsigned int)(t), e);
+			fails++;
+		}
+		if ((n == 0) && (t)) fails++;
+
+		d = abs((int)(iSqrtSeed(n)) - e);
+		if (d > seedWorst) seedWorst = d;
+
+		d = abs((int)(oldSqrt(n)) - e);
+		if ((n >= 2048) && (n <= 8192) && (d > oldWorst))
+		{
+			oldWorst = d;
+			oldWorstN = n;
+		}
+	}
+
+	if (seedWorst > 2)
+	{
+		printf("iSqrtSeed() is off by as much as %d, iSqrt() only corrects 2\n", seedWorst);
+		fails++;
+	}
+
+	printf("iSqrtSeed() worst error %d, old iSqrt() worst error %d at n = %u\n", seedWorst, oldWorst, oldWorstN);
+	printf("65536 inputs, %u failures\n", fails);
+
+	return (fails ? 1 : 0);
+}
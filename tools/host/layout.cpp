@@ -0,0 +1,18 @@
+/* prints the EEPROM settings layout as the compiler worked it out, for tools/mpglayout.py check to compare against
+
+   one line for the signature, one "setting INDEX BITS ADDRESS DEFAULT" line per setting, straight from paramsLength,
+   paramAddrs and params, and the address just past the settings */
+#include "host.h"
+
+int main(void)
+{
+	printf("signature %06lX\n", (unsigned long)(newEEPROMsignature));
+
+	for (uint8_t x = 0; x < settingsSize; x++)
+		printf("setting %u %u %u %lu\n", eePtrSettingsStart + x, pgm_read_byte(&paramsLength[(unsigned int)(x)]),
+		    pgm_read_byte(&paramAddrs[(unsigned int)(x)]), (unsigned long)(pgm_read_dword(&params[(unsigned int)(x)])));
+
+	printf("settings end %u\n", eeAdrSettingsEnd);
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/* checks the SWEET64 profiler's bookkeeping - which slot each program lands in, and how its cycles are charged
+
+   build it with -DuseSWEET64profiler=true -DuseSWEET64multDiv=true, so that the fuel economy program calls
+   prgmDoMultiply and prgmDoDivide instead of doing its math natively. timer2 ticks once per cli() here, so a
+   program's cycles are however many times cycles2() and the EEPROM reads it makes were called while it ran */
+#include "host.h"
+
+#ifndef useSWEET64profiler
+#error "build this with -DuseSWEET64profiler=true"
+#endif
+#ifndef useSWEET64multDiv
+#error "build this with -DuseSWEET64multDiv=true"
+#endif
+
+/* a program that is in neither S64programList nor S64verifyList */
+const uint8_t prgmUnlisted[] PROGMEM = {
+	instrLdByte, 0x02, 5,
+	instrDone
+};
+
+unsigned int fails;
+
+void check(int ok, const char * what)
+{
+	if (ok) return;
+	printf("FAIL: %s\n", what);
+	fails++;
+}
+
+void hostTimer(void)
+{
+	timer2_overflow_count++;
+}
+
+void clearProfile(void)
+{
+	memset(s64profCalls, 0, sizeof(s64profCalls));
+	memset(s64profCycles, 0, sizeof(s64profCycles));
+}
+
+int main(void)
+{
+	uint8_t fe = S64findVerifyIdx(prgmFuelEcon);
+	uint8_t mul = S64findVerifyIdx(prgmDoMultiply);
+	uint8_t div = S64findVerifyIdx(prgmDoDivide);
+	uint8_t rnd = S64findVerifyIdx(prgmRoundOffNumber);
+
+	loadParams();
+	/* the host's int is wider than the AVR's, so work the RAM out at AVR widths */
+	printf("%u programs, %u opcodes, %u bytes of RAM on the AVR\n", S64verifyCount, DNUISinstrCount,
+	    (unsigned int)(DNUISinstrCount * 4 + s64profSlotCount * 6 + S64programCount));
+
+	/* every program called by index has to land in the slot of that same program */
+	for (uint8_t x = 0; x < S64programCount; x++)
+	{
+		uint8_t s = S64profCall(x);
+
+		if ((s >= S64verifyCount) || (pgm_read_word(&S64verifyList[(unsigned int)(s)]) != pgm_read_word(&S64programList[(unsigned int)(x)])))
+		{
+			printf("S64programList entry %u went to slot %u\n", x, s);
+			fails++;
+		}
+	}
+
+	clearProfile();
+	for (unsigned int x = 0; x < rvLength; x++) tripArray[tankIdx].collectedData[x] = 0x00123456ul + x * 0x00010203ul;
+	hostTickHook = hostTimer;
+
+	for (uint8_t x = 0; x < 10; x++) SWEET64(prgmFuelEcon, tankIdx);
+	printf("FuelEcon: %u runs, %lu cycles; DoMultiply: %u calls, %lu cycles; DoDivide: %u calls, %lu cycles\n",
+	    s64profCalls[fe], (unsigned long)(s64profCycles[fe]), s64profCalls[mul], (unsigned long)(s64profCycles[mul]),
+	    s64profCalls[div], (unsigned long)(s64profCycles[div]));
+	check(s64profCalls[fe] == 10, "a program run directly is counted in its own slot");
+	check(s64profCalls[div] >= 10, "a program called by index is counted in its own slot");
+	check(s64profCycles[div] > 0, "a called program gets cycles of its own");
+	check(s64profCycles[fe] >= s64profCycles[mul] + s64profCycles[div], "a program's cycles include those of what it calls");
+
+	SWEET64(prgmRoundOffNumber, 0);
+	check(s64profCalls[rnd] == 1, "a listed program that is only ever run directly gets its own slot");
+
+	SWEET64(prgmUnlisted, 0);
+	check(s64profCalls[S64verifyCount] == 1, "an unlisted program goes in the last slot");
+
+	s64profCalls[fe] = 0xFFFE;
+	SWEET64(prgmFuelEcon, tankIdx);
+	SWEET64(prgmFuelEcon, tankIdx);
+	check(s64profCalls[fe] == 0xFFFF, "counts stop at FFFF");
+
+	hostTickHook = 0;
+	printf("%u failures\n", fails);
+
+	return (fails ? 1 : 0);
+}
@@ -0,0 +1,311 @@
+/* checks every SWEET64 display program, plus the number formatting and metric conversion programs,
+   against the same formulas worked out in native 64-bit arithmetic
+
+   trip data, settings, and the metric flag are all random; any mismatch fails the test */
+#include "host.h"
+
+const unsigned int samples = 20000;
+
+uint64_t CPS;
+uint64_t DP;
+uint64_t uS;
+uint64_t SPH;
+uint64_t MFE;
+
+uint64_t vss;
+uint64_t injPulse;
+uint64_t vssCycles;
+uint64_t injCycles;
+uint64_t injOpen;
+uint64_t tankOpen;
+
+uint64_t uSPQ;
+uint64_t ppd;
+uint64_t tank;
+uint64_t crankRev;
+#ifdef useFuelCost
+uint64_t cost;
+#endif
+
+unsigned long failCount;
+
+/* SWEET64 division - divide by zero gives all ones */
+uint64_t dv(uint64_t a, uint64_t b)
+{
+	return (b ? a / b : ~0ull);
+}
+
+/* SWEET64 division followed by doAdjust - round to nearest, with an exact half rounding down */
+uint64_t dvAdj(uint64_t a, uint64_t b)
+{
+	if (b == 0) return ~0ull;
+
+	return a / b + (((a % b) > (b >> 1)) ? 1 : 0);
+}
+
+uint64_t cyclesPerQuantity(void)
+{
+	return CPS * uSPQ / uS;
+}
+
+uint64_t remainingFuel(void)
+{
+	uint64_t cap = tank * uSPQ * CPS / uS / DP;
+
+	return ((tankOpen <= cap) ? cap - tankOpen : 0);
+}
+
+uint64_t refFuelUsed(void) { return (injOpen ? dv(injOpen * DP, cyclesPerQuantity()) : 0); }
+uint64_t refFuelRate(void) { return (injOpen ? dv(dv(injOpen * DP, injCycles) * uS * SPH, uSPQ) : 0); }
+uint64_t refEngineRunTime(void) { return injCycles / CPS; }
+uint64_t refDistance(void) { return dv(vss * DP, ppd); }
+uint64_t refSpeed(void) { return (vssCycles ? dv(vss * DP * CPS * SPH, vssCycles * ppd) : 0); }
+uint64_t refMotionTime(void) { return vssCycles / CPS; }
+uint64_t refInjectorOpenTime(void) { return injOpen * uS / CPS; }
+uint64_t refInjectorTotalTime(void) { return injCycles * uS / CPS; }
+uint64_t refVSStotalTime(void) { return vssCycles * uS / CPS; }
+uint64_t refInjectorPulseCount(void) { return injPulse; }
+uint64_t refVSSpulseCount(void) { return vss; }
+uint64_t refEngineSpeed(void) { return dv(injPulse * CPS * 60 * DP * crankRev, injCycles); }
+
+uint64_t refFuelEcon(void)
+{
+	uint64_t n = injOpen * ppd;
+	uint64_t d = vss * cyclesPerQuantity();
+
+	if (metricFlag) return (n ? dv(n * MFE, d) : 0);
+	else return (d ? dv(d * DP, n) : 0);
+}
+
+uint64_t refRemainingFuel(void)
+{
+	uint64_t r = remainingFuel();
+
+	return (r ? dv(r * DP * uS / CPS, uSPQ) : 0);
+}
+
+uint64_t refDistanceToEmpty(void)
+{
+	uint64_t r = remainingFuel();
+
+	return (r ? dvAdj(dv(r * DP, injOpen) * vss, ppd) : 0);
+}
+
+uint64_t refTimeToEmpty(void)
+{
+	uint64_t r = remainingFuel();
+
+	return (r ? dv(dv(r * uS, injOpen) * injCycles, CPS * uS) : 0);
+}
+
+#ifdef useFuelCost
+uint64_t refFuelCost(void) { return (injOpen ? dv(injOpen * cost, cyclesPerQuantity()) : 0); }
+uint64_t refFuelRateCost(void) { return (injOpen ? dv(dv(injOpen * cost, injCycles) * uS * SPH, uSPQ) : 0); }
+uint64_t refFuelCostPerDistance(void) { return dv(injOpen * ppd * cost, vss * cyclesPerQuantity()); }
+uint64_t refDistancePerFuelCost(void) { return dv(vss * cyclesPerQuantity() * DP * DP, injOpen * ppd * cost); }
+
+uint64_t refRemainingFuelCost(void)
+{
+	uint64_t r = remainingFuel();
+
+	return (r ? dv(r * cost * uS / CPS, uSPQ) : 0);
+}
+#endif
+
+struct programCheck
+{
+	const uint8_t * prgm;
+	uint64_t (* ref)(void);
+	const char * name;
+};
+
+const programCheck programChecks[] = {
+	{prgmFuelUsed,			refFuelUsed,		"FuelUsed"},
+	{prgmFuelRate,			refFuelRate,		"FuelRate"},
+	{prgmEngineRunTime,		refEngineRunTime,	"EngineRunTime"},
+	{prgmTimeToEmpty,		refTimeToEmpty,		"TimeToEmpty"},
+	{prgmDistance,			refDistance,		"Distance"},
+	{prgmSpeed,			refSpeed,		"Speed"},
+	{prgmMotionTime,		refMotionTime,		"MotionTime"},
+	{prgmFuelEcon,			refFuelEcon,		"FuelEcon"},
+	{prgmRemainingFuel,		refRemainingFuel,	"RemainingFuel"},
+	{prgmDistanceToEmpty,		refDistanceToEmpty,	"DistanceToEmpty"},
+	{prgmEngineSpeed,		refEngineSpeed,		"EngineSpeed"},
+	{prgmInjectorOpenTime,		refInjectorOpenTime,	"InjectorOpenTime"},
+	{prgmInjectorTotalTime,		refInjectorTotalTime,	"InjectorTotalTime"},
+	{prgmVSStotalTime,		refVSStotalTime,	"VSStotalTime"},
+	{prgmInjectorPulseCount,	refInjectorPulseCount,	"InjectorPulseCount"},
+	{prgmVSSpulseCount,		refVSSpulseCount,	"VSSpulseCount"},
+#ifdef useFuelCost
+	{prgmFuelCost,			refFuelCost,		"FuelCost"},
+	{prgmFuelRateCost,		refFuelRateCost,	"FuelRateCost"},
+	{prgmFuelCostPerDistance,	refFuelCostPerDistance,	"FuelCostPerDistance"},
+	{prgmDistancePerFuelCost,	refDistancePerFuelCost,	"DistancePerFuelCost"},
+	{prgmRemainingFuelCost,		refRemainingFuelCost,	"RemainingFuelCost"},
+#endif
+};
+
+const unsigned int programCheckCount = (sizeof(programChecks) / sizeof(programCheck));
+
+void fail(const char * name, unsigned int sample, uint64_t got, uint64_t expected)
+{
+	if (failCount < 20) printf("%s: sample %u got %llu, expected %llu\n", name, sample,
+		(unsigned long long)(got), (unsigned long long)(expected));
+	failCount++;
+}
+
+/* stores a random setting, then reads it back, so the reference sees the same truncated value that SWEET64 will */
+uint64_t randomParam(uint8_t eePtr, uint8_t maxBits)
+{
+	uint64_t v;
+
+	do v = hostRandomBits(maxBits); while (v == 0);
+	eepromWriteVal(eePtr, (unsigned long)(v));
+
+	return eepromReadVal(eePtr);
+}
+
+void randomTrip(uint8_t tripIdx)
+{
+	union union_64 * u;
+
+	tripArray[(unsigned int)(tripIdx)].collectedData[(unsigned int)(rvVSSpulseIdx)] = (unsigned long)(vss = hostRandomBits(32));
+	tripArray[(unsigned int)(tripIdx)].collectedData[(unsigned int)(rvInjPulseIdx)] = (unsigned long)(injPulse = hostRandomBits(32));
+
+	u = (union union_64 *)&tripArray[(unsigned int)(tripIdx)].collectedData[(unsigned int)(rvVSScycleIdx)];
+	u->ull = vssCycles = hostRandomBits(48);
+	u = (union union_64 *)&tripArray[(unsigned int)(tripIdx)].collectedData[(unsigned int)(rvInjCycleIdx)];
+	u->ull = injCycles = hostRandomBits(48);
+	u = (union union_64 *)&tripArray[(unsigned int)(tripIdx)].collectedData[(unsigned int)(rvInjOpenCycleIdx)];
+	u->ull = injOpen = hostRandomBits(44);
+}
+
+void checkPrograms(unsigned int sample)
+{
+	uint8_t tripIdx = (uint8_t)(hostRandom() % tankIdx);
+	union union_64 * u;
+
+	metricFlag = (uint8_t)(hostRandom() & 1);
+
+	uSPQ = randomParam(pMicroSecondsPerQuantityIdx, 32);
+	ppd = randomParam(pPulsesPerDistanceIdx, 32);
+	tank = randomParam(pTankSizeIdx, 32);
+	crankRev = randomParam(pCrankRevPerInjIdx, 8);
+#ifdef useFuelCost
+	cost = randomParam(pCostPerQuantity, 32);
+#endif
+
+	randomTrip(tripIdx);
+
+	u = (union union_64 *)&tripArray[(unsigned int)(tankIdx)].collectedData[(unsigned int)(rvInjOpenCycleIdx)];
+	u->ull = tankOpen = hostRandomBits(44);
+
+	for (unsigned int x = 0; x < programCheckCount; x++)
+	{
+		uint32_t got = SWEET64(programChecks[x].prgm, tripIdx);
+		uint32_t expected = (uint32_t)(programChecks[x].ref());
+
+		if (got != expected) fail(programChecks[x].name, sample, got, expected);
+	}
+}
+
+void checkRoundOff(unsigned int sample)
+{
+	uint64_t num = hostRandomBits(32);
+	uint8_t ndp = (uint8_t)(hostRandom() % 4);
+	uint64_t r = num;
+
+	if (num >= 10000000) r += 500;
+	else if (num >= 1000000) r += 50;
+	else if (num >= 100000) r += 5;
+	else if (ndp == 0) r += 500;
+	else if (ndp == 1) r += 50;
+	else if (ndp == 2) r += 5;
+
+	init64(tempPtr[1], (unsigned long)(num));
+	SWEET64(prgmRoundOffNumber, ndp);
+
+	if (r > 0xFFFFFFFEull)
+	{
+		if (tempPtr[2]->u8[6] != 255) fail("RoundOffNumber overflow", sample, tempPtr[2]->u8[6], 255);
+		return;
+	}
+
+	if (tempPtr[2]->u8[6] != 5) fail("FormatToNumber length", sample, tempPtr[2]->u8[6], 5);
+	if (tempPtr[2]->u8[7] != 32) fail("FormatToNumber leading zero", sample, tempPtr[2]->u8[7], 32);
+
+	for (uint8_t x = 5; x > 0; x--)
+	{
+		if (tempPtr[2]->u8[x - 1] != (r % 100)) fail("RoundOffNumber digits", sample, tempPtr[2]->u8[x - 1], r % 100);
+		r /= 100;
+	}
+}
+
+void checkFormatToTime(unsigned int sample)
+{
+	uint64_t s = hostRandomBits(32);
+
+	init64(tempPtr[1], (unsigned long)(s));
+	SWEET64(prgmFormatToTime, 0);
+
+	if (tempPtr[2]->u8[2] != (s % 60)) fail("FormatToTime seconds", sample, tempPtr[2]->u8[2], s % 60);
+	if (tempPtr[2]->u8[1] != ((s / 60) % 60)) fail("FormatToTime minutes", sample, tempPtr[2]->u8[1], (s / 60) % 60);
+	if (tempPtr[2]->u8[0] != ((s / 3600) % 24)) fail("FormatToTime hours", sample, tempPtr[2]->u8[0], (s / 3600) % 24);
+	if (tempPtr[2]->u8[6] != 3) fail("FormatToTime length", sample, tempPtr[2]->u8[6], 3);
+	if (tempPtr[2]->u8[7] != 48) fail("FormatToTime leading zero", sample, tempPtr[2]->u8[7], 48);
+}
+
+void checkMetricConversion(unsigned int sample)
+{
+	uint64_t expected[convSize];
+
+	metricFlag = (uint8_t)(hostRandom() & 1);
+
+	for (uint8_t x = 0; x < convSize; x++)
+	{
+		uint8_t eePtr = pgm_read_byte(&convIdx[(unsigned int)(x)]);
+		uint8_t n = pgm_read_byte(&convNumerIdx[(unsigned int)(x)]);
+		uint64_t numer = pgm_read_dword(&convNumbers[(unsigned int)(n)]);
+		uint64_t denom = pgm_read_dword(&convNumbers[(unsigned int)(n ^ 1)]);
+		uint8_t l = (uint8_t)((eepromGetAddress(eePtr) & 0x07) + 1);
+		uint64_t v = randomParam(eePtr, l * 8);
+
+		if (metricFlag) expected[x] = dvAdj(v * denom, numer);
+		else expected[x] = dvAdj(v * numer, denom);
+
+		if (l < 8) expected[x] &= ((1ull << (l * 8)) - 1);	// eepromWriteVal() keeps only as many bytes as the setting has
+		expected[x] &= 0xFFFFFFFFull;
+	}
+
+	SWEET64(prgmDoEEPROMmetricConversion, 0);
+
+	for (uint8_t x = 0; x < convSize; x++)
+	{
+		uint64_t got = eepromReadVal(pgm_read_byte(&convIdx[(unsigned int)(x)]));
+
+		if (got != expected[x]) fail("DoEEPROMmetricConversion", sample, got, expected[x]);
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	if (argc > 1) hostRandomState = strtoull(argv[1], 0, 0);
+
+	CPS = pgm_read_dword(&convNumbers[(unsigned int)(idxCyclesPerSecond)]);
+	DP = pgm_read_dword(&convNumbers[(unsigned int)(idxDecimalPoint)]);
+	uS = pgm_read_dword(&convNumbers[(unsigned int)(idxMicroSecondsPerSecond)]);
+	SPH = pgm_read_dword(&convNumbers[(unsigned int)(idxSecondsPerHour)]);
+	MFE = pgm_read_dword(&convNumbers[(unsigned int)(idxMetricFE)]);
+
+	for (unsigned int x = 0; x < samples; x++)
+	{
+		checkPrograms(x);
+		checkRoundOff(x);
+		checkFormatToTime(x);
+		checkMetricConversion(x);
+	}
+
+	printf("%u programs, %u samples each, %lu mismatches\n", programCheckCount + 4, samples, failCount);
+
+	return (failCount ? 1 : 0);
+}
@@ -0,0 +1,54 @@
+/* runs the on-device SWEET64 verifier on the host, and checks the name tables that the compiler can't count
+
+   build it with -DuseSWEET64verifier=true (or -DuseSWEET64disassembler=true, which also checks the opcode names),
+   plus whatever options should have their programs walked */
+#include "host.h"
+
+#ifndef useSWEET64verifier
+#error "build this with -DuseSWEET64verifier=true"
+#endif
+
+/* number of strings in a "name\0" "name\0" ... table */
+unsigned int countNames(const char * str, unsigned int len)
+{
+	unsigned int n = 0;
+
+	for (unsigned int x = 0; x + 1 < len; x++) if (str[x] == 0) n++; // the last \0 is the one the compiler adds
+
+	return n;
+}
+
+int main(void)
+{
+	unsigned int fails = 0;
+	unsigned int n;
+	uint8_t e;
+
+	n = countNames(S64verifyNames, sizeof(S64verifyNames));
+	if (n != S64verifyCount)
+	{
+		printf("S64verifyNames has %u names for %u programs\n", n, S64verifyCount);
+		fails++;
+	}
+
+#ifdef useSWEET64disassembler
+	n = countNames(S64instrNames, sizeof(S64instrNames));
+	if (n != S64instrCount)
+	{
+		printf("S64instrNames has %u names for %u opcodes\n", n, S64instrCount);
+		fails++;
+	}
+
+#endif
+	e = doSWEET64verify();
+	if (e)
+	{
+		fwrite(hostTxBuffer, 1, hostTxLength, stdout);
+		printf("verifier error flags %02X\n", e);
+		fails++;
+	}
+
+	printf("%u programs verified, %u failures\n", S64verifyCount, fails);
+
+	return (fails ? 1 : 0);
+}
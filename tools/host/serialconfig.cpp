@@ -0,0 +1,83 @@
+/* the device end of the serial configuration channel, for tools/test_mpgconfig.py to talk to
+
+   bytes on stdin go in thru the USART receive interrupt, and whatever the sketch sends comes out on stdout.
+   the main loop only runs serialConfigPoll(), one background task slice per pass, and the EEPROM write queue
+   drains as it would on the hardware */
+#include <unistd.h>
+#include <poll.h>
+#include "host.h"
+
+#ifndef useSerialConfig
+#error "build this with -DuseSerialConfig=true"
+#endif
+
+void flushTx(void)
+{
+	unsigned long n = 0;
+
+#ifdef useBufferedSerialPort
+	while (!(serialBuffer.bufferStatus & bufferIsEmpty)) USART_UDRE_vect();
+
+#endif
+	while (n < hostTxLength)
+	{
+		ssize_t w = write(1, hostTxBuffer + n, hostTxLength - n);
+
+		if (w <= 0) exit(1);
+		n += (unsigned long)(w);
+	}
+
+	hostTxLength = 0;
+}
+
+int main(int argc, char * argv[])
+{
+	struct pollfd p;
+	uint8_t c;
+
+#ifdef useBufferedSerialPort
+	serialBuffer.init(serialBufferStorage, serialBufferSize);
+	serialBuffer.process = serialTransmitByte;
+	serialBuffer.onEmpty = serialTransmitDisable;
+	serialBuffer.onNoLongerEmpty = serialTransmitEnable;
+#endif
+	serialRxBuffer.init(serialRxBufferStorage, serialRxBufferSize);
+	serialRxBuffer.process = serialConfigReceiveByte;
+
+	/* start out with the default settings, plus a few saved trips' worth of junk. as in main(), the buffers are set up
+	   first, since loadParams() sets the baud rate, and that waits on the transmit buffer */
+	for (unsigned int x = 0; x <= E2END; x++) hostEEPROM[x] = (uint8_t)(hostRandom());
+	loadParams();
+
+	p.fd = 0;
+	p.events = POLLIN;
+
+	while (true)
+	{
+		/* wait for input only once there is nothing left to do */
+		if (poll(&p, 1, (serialConfigPoll() || eeQueueCount) ? 0 : 100) > 0)
+		{
+			if (read(0, &c, 1) != 1) break;
+			UDR0.rx = c;
+			USART_RX_vect();
+		}
+
+		hostTick();
+		flushTx();
+	}
+
+	/* on end of input, leave the EEPROM contents where the test can look at them */
+	while (eeQueueCount) hostTick();
+	if (argc > 1)
+	{
+		FILE * f = fopen(argv[1], "wb");
+
+		if (f)
+		{
+			fwrite(hostEEPROM, 1, eeAdrEnd, f);
+			fclose(f);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,106 @@
+/* the device end of the binary telemetry stream, for tools/test_mpgtelemetry.py to decode
+
+   runs telemetryPoll() the way the background task list would, with random trip data coming into the raw trip in
+   between, and the main loop's transfer of raw trip data to instant (followed by telemetryLoopSync()) every half
+   second. the timer 2 overflow count stands in for the timer interrupt, and moves along by anything from a quarter of
+   a frame period to a frame period and a quarter per poll, so some polls find no frame due.
+
+     telemetry [FRAMES]
+
+   the frames come out on stdout, as a capture of the serial port would hold them. stderr gets a "settings" line
+   with what the description frames should carry, then one line per data frame, with the sequence number, timestamp,
+   the 5 measurement deltas, and the 2 analog channels (-1 if not built in) that the frame should decode to */
+#include "host.h"
+
+#ifndef useBinaryTelemetry
+#error "build this with -DuseBinaryTelemetry=true"
+#endif
+#ifdef useBufferedSerialPort
+#error "nothing empties the serial transmit buffer here, so build this without useBufferedSerialPort"
+#endif
+
+unsigned long sent[(unsigned int)(tFLsize)];
+
+void addRaw(uint8_t idx, unsigned long v)
+{
+	tripArray[rawIdx].collectedData[idx] += v;
+	for (uint8_t x = 0; x < tFLsize; x++)
+		if (pgm_read_byte(&telemetryFieldList[(unsigned int)(x)]) == idx) sent[(unsigned int)(x)] += v;
+}
+
+int main(int argc, char * argv[])
+{
+	unsigned int frames = (argc > 1) ? atoi(argv[1]) : 600;
+	unsigned long loopStart = 0;
+	unsigned int n = 0;
+
+	loadParams();
+	eepromWriteVal(pSerialDataLoggingIdx, 2);
+	eepromWriteVal(pMicroSecondsPerQuantityIdx, 133262000ul + hostRandom() % 1000000ul);
+	eepromWriteVal(pInjectorSettleTimeIdx, 400ul + hostRandom() % 200ul);
+	eepromWriteVal(pPulsesPerDistanceIdx, 8000ul + hostRandom() % 2000ul);
+	eepromWriteVal(pCrankRevPerInjIdx, 2);
+	metricFlag = 1;
+
+	fprintf(stderr, "settings,%lu,%u,%u,%lu,%lu,%lu,%lu\n", (unsigned long)(t2CyclesPerSecond), telemetryPerSecond, metricFlag,
+	    (unsigned long)(eepromReadVal(pMicroSecondsPerQuantityIdx)), (unsigned long)(eepromReadVal(pInjectorSettleTimeIdx)),
+	    (unsigned long)(eepromReadVal(pPulsesPerDistanceIdx)), (unsigned long)(eepromReadVal(pCrankRevPerInjIdx)));
+
+	/* start the timer off near the top, so the timestamps wrap around during the run */
+	timer2_overflow_count = 0xFFFFFFFFul - 50ul * telemetryPeriod;
+
+	while (n < frames)
+	{
+		uint8_t s = telemetrySequence;
+
+		addRaw(rvVSSpulseIdx, hostRandom() % 40);
+		addRaw(rvInjPulseIdx, hostRandom() % 30);
+		addRaw(rvVSScycleIdx, hostRandom() % telemetryPeriod);
+		addRaw(rvInjCycleIdx, hostRandom() % telemetryPeriod);
+		addRaw(rvInjOpenCycleIdx, hostRandom() % (telemetryPeriod / 4));
+#ifdef useAnalogRead
+		analogValue[0] = (unsigned int)(hostRandom() % 1024);
+		analogValue[1] = (unsigned int)(hostRandom() % 1024);
+#endif
+
+		timer2_overflow_count += telemetryPeriod / 4 + (unsigned long)(hostRandom() % telemetryPeriod);
+
+		if (telemetryPoll())
+		{
+			n++;
+
+			/* description and health frames take the place of a data frame, and carry no measurements */
+#ifdef useStackWatch
+			if ((s) && (s != 128))
+#else
+			if (s)
+#endif
+			{
+				fprintf(stderr, "data,%u,%lu", s, (unsigned long)(timer2_overflow_count));
+				for (uint8_t x = 0; x < tFLsize; x++)
+				{
+					fprintf(stderr, ",%lu", (unsigned long)(sent[(unsigned int)(x)]));
+					sent[(unsigned int)(x)] = 0;
+				}
+#ifdef useAnalogRead
+				fprintf(stderr, ",%u,%u\n", analogValue[0], analogValue[1]);
+#else
+				fprintf(stderr, ",-1,-1\n");
+#endif
+			}
+		}
+
+		/* the main loop's half second trip update */
+		if (findCycleLength(loopStart, timer2_overflow_count) >= t2CyclesPerSecond / loopsPerSecond)
+		{
+			loopStart = timer2_overflow_count;
+			tripArray[instantIdx].transfer(tripArray[rawIdx]);
+			tripArray[rawIdx].reset();
+			telemetryLoopSync();
+		}
+	}
+
+	fwrite(hostTxBuffer, 1, hostTxLength, stdout);
+
+	return 0;
+}
@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+"""
+mpgconfig - host side companion to the MPGuino serial configuration channel
+
+pulls the whole EEPROM image (signature, settings, screens, fill-up log,
+and saved trips) out of an MPGuino built with useSerialConfig, or pushes
+one back in, over a serial port or pty (set its baud rate first, with
+stty). see the protocol description above serialConfigReceiveByte() in
+mpguino.cpp. only the python 3 standard library is needed.
+
+  mpgconfig.py dump PORT IMAGE
+      write the MPGuino's EEPROM image to the file IMAGE.
+
+  mpgconfig.py load PORT IMAGE
+      send IMAGE to the MPGuino. it is only accepted if it was dumped
+      from a build with the same EEPROM layout; settings take effect as
+      soon as the 'E' frame checks out.
+
+  mpgconfig.py show IMAGE
+      print the signature, length and CRC of an image file.
+
+an image file is the raw EEPROM contents, from address 0 up to the end
+of the area the sketch uses, with the EEPROM signature in its first 3
+bytes. the image CRC is CRC-16-CCITT (initial value 0xFFFF) over the
+whole file.
+"""
+
+import argparse
+import binascii
+import os
+import select
+import struct
+import sys
+
+CHUNK_SIZE = 32
+TIMEOUT = 2.0		# seconds to wait for a reply before resending a frame
+RETRIES = 5
+
+REPLIES = {
+	0: "ok",
+	1: "EEPROM signature does not match this build",
+	2: "image length does not match this build",
+	3: "image bytes past the end of EEPROM",
+	4: "no image load in progress",
+	5: "image CRC does not match",
+	6: "bad command",
+}
+
+
+class ConfigError(Exception):
+	pass
+
+
+# --------------------------------------------------------------------------
+# framing
+
+def cobs_encode(data):
+	out = bytearray()
+	block = bytearray()
+	for b in data:
+		if b == 0:
+			out.append(len(block) + 1)
+			out += block
+			block = bytearray()
+			continue
+		block.append(b)
+		if len(block) == 254:
+			out.append(255)
+			out += block
+			block = bytearray()
+	out.append(len(block) + 1)
+	out += block
+	return bytes(out)
+
+
+def cobs_decode(data):
+	out = bytearray()
+	i = 0
+	n = len(data)
+	while i < n:
+		code = data[i]
+		if code == 0 or i + code > n:
+			return None
+		out += data[i + 1:i + code]
+		i += code
+		if code < 255 and i < n:
+			out.append(0)
+	return bytes(out)
+
+
+def crc16(data):
+	return binascii.crc_hqx(data, 0xFFFF)
+
+
+def encode_frame(body):
+	return cobs_encode(body + struct.pack("<H", crc16(body))) + b"\x00"
+
+
+class Link:
+	"""frames over a pair of file descriptors - a serial port, a pty, or a pipe to a host build"""
+
+	def __init__(self, rfd, wfd):
+		self.rfd = rfd
+		self.wfd = wfd
+		self.tail = b""
+		self.pending = []
+
+	def send(self, body):
+		data = encode_frame(body)
+		while data:
+			data = data[os.write(self.wfd, data):]
+
+	def receive(self, timeout=TIMEOUT):
+		"""return the body of the next frame that passes its CRC, or None on timeout"""
+		while not self.pending:
+			r, _, _ = select.select([self.rfd], [], [], timeout)
+			if not r:
+				return None
+			chunk = os.read(self.rfd, 4096)
+			if not chunk:
+				raise ConfigError("link closed")
+			parts = (self.tail + chunk).split(b"\x00")
+			self.tail = parts.pop()
+			for part in parts:
+				frame = cobs_decode(part) if part else None
+				if frame is None or len(frame) < 3:
+					continue
+				if crc16(frame[:-2]) != frame[-2] | (frame[-1] << 8):
+					continue
+				self.pending.append(frame[:-2])
+		return self.pending.pop(0)
+
+
+# --------------------------------------------------------------------------
+# protocol
+
+def image_header(image):
+	if len(image) < 3:
+		raise ConfigError("image is too short")
+	return image[0:3], len(image), crc16(image)
+
+
+def dump(link):
+	link.send(b"D")
+
+	frame = link.receive()
+	while frame is not None and frame[0:1] != b"B":	# skip anything left over from before
+		frame = link.receive()
+	if frame is None or len(frame) != 8:
+		raise ConfigError("no reply to dump request")
+
+	sig = frame[1:4]
+	length, crc = struct.unpack_from("<HH", frame, 4)
+	image = bytearray(length)
+	offset = 0
+
+	while True:
+		frame = link.receive()
+		if frame is None:
+			raise ConfigError("dump stopped at offset %d of %d" % (offset, length))
+		if frame[0:1] == b"E":
+			break
+		if frame[0:1] != b"W" or len(frame) < 4:
+			continue
+		(at,) = struct.unpack_from("<H", frame, 1)
+		data = frame[3:]
+		if at != offset or at + len(data) > length:
+			raise ConfigError("dump frame at offset %d, expected %d" % (at, offset))
+		image[at:at + len(data)] = data
+		offset += len(data)
+
+	if offset != length:
+		raise ConfigError("dump ended at offset %d of %d" % (offset, length))
+
+	image[0:3] = sig		# the image carries the signature of the build, whatever was in EEPROM
+	if crc16(bytes(image)) != crc:
+		raise ConfigError("dump CRC does not match")
+
+	return bytes(image)
+
+
+def request(link, body):
+	"""send a frame and wait for its reply, resending on silence"""
+	for _ in range(RETRIES):
+		link.send(body)
+		while True:
+			frame = link.receive()
+			if frame is None:
+				break
+			if len(frame) == 3 and frame[0:1] == b"A" and frame[1] == body[0]:
+				if frame[2]:
+					raise ConfigError("'%c' frame refused: %s" % (body[0], REPLIES.get(frame[2], "status %d" % frame[2])))
+				return
+	raise ConfigError("no reply to '%c' frame" % body[0])
+
+
+def load(link, image):
+	sig, length, crc = image_header(image)
+
+	request(link, b"B" + sig + struct.pack("<HH", length, crc))
+	for at in range(0, length, CHUNK_SIZE):
+		request(link, b"W" + struct.pack("<H", at) + image[at:at + CHUNK_SIZE])
+	request(link, b"E")
+
+
+# --------------------------------------------------------------------------
+# command line
+
+def open_port(path):
+	fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+	return Link(fd, fd)
+
+
+def main(argv=None):
+	ap = argparse.ArgumentParser(description="dump or load an MPGuino EEPROM image over the serial configuration channel")
+	sub = ap.add_subparsers(dest="command", required=True)
+
+	p = sub.add_parser("dump", help="write the MPGuino's EEPROM image to a file")
+	p.add_argument("port")
+	p.add_argument("image")
+
+	p = sub.add_parser("load", help="send an EEPROM image file to the MPGuino")
+	p.add_argument("port")
+	p.add_argument("image")
+
+	p = sub.add_parser("show", help="print the header of an EEPROM image file")
+	p.add_argument("image")
+
+	args = ap.parse_args(argv)
+
+	try:
+		if args.command == "dump":
+			image = dump(open_port(args.port))
+			with open(args.image, "wb") as f:
+				f.write(image)
+		elif args.command == "load":
+			with open(args.image, "rb") as f:
+				load(open_port(args.port), f.read())
+		else:
+			with open(args.image, "rb") as f:
+				sig, length, crc = image_header(f.read())
+			print("signature %s, %d bytes, CRC %04X" % (sig.hex().upper(), length, crc))
+	except (ConfigError, OSError) as e:
+		print("mpgconfig: %s" % e, file=sys.stderr)
+		return 1
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+"""
+mpgfillups - host side companion to the MPGuino fill-up log
+
+reads the CSV that an MPGuino built with useFillUpHistory sends out
+the serial port on a long press of all three buttons on the main
+screen (see doFillUpDump() in mpguino.cpp), from capture files or
+straight from a serial port or pty (set its baud rate first, with
+stty). a port is read until one whole dump has come in. only the
+python 3 standard library is needed.
+
+  mpgfillups.py merge [-o OUT] CAPTURE...
+      write every fill-up found in the captures out as one CSV, oldest
+      first, with each fill-up only once.
+
+  mpgfillups.py stats [--units us|metric] CAPTURE...
+      print long-term statistics over every fill-up in the captures.
+
+the MPGuino only keeps its last 8 fill-ups, so a long history is built
+up from dumps taken every so often, and given here oldest capture
+first. a capture may hold any number of dumps, along with whatever
+else came over the port. a fill-up that shows up in more than one dump
+is only counted once.
+
+each record holds its values in the units that were selected when the
+tank was reset, so records in the other units are converted before
+they are added up. times are in seconds; the time column is the
+MPGuino's clock when the tank was reset, which starts over at power up
+unless the unit keeps time of day.
+"""
+
+import argparse
+import os
+import stat
+import statistics
+import sys
+
+KM_PER_MILE = 1.609344
+LITRE_PER_GALLON = 3.785411784
+
+HEADER = "seq,units,time,distance,fuel,engine time,idle fuel,fuel economy"
+FIELDS = ("seq", "units", "time", "distance", "fuel", "engine_time", "idle_fuel")
+UNITS = {"SAE": "us", "metric": "metric"}
+
+
+class DumpError(Exception):
+	pass
+
+
+class Dump:
+	"""one doFillUpDump() output - its records, and the total row that closes it"""
+
+	def __init__(self, source):
+		self.source = source
+		self.records = []
+		self.total = None
+
+	def check(self):
+		"""the total row only covers the records in the units the MPGuino was set to, and the dump does not say which
+		units those are, so it has to match the records in one of them"""
+		count, distance, fuel, engine_time, idle_fuel = self.total
+		for units in UNITS.values():
+			rs = [r for r in self.records if r["units"] == units]
+			if (count == len(rs)
+			    and abs(distance - sum(r["distance"] for r in rs)) < 0.0005
+			    and abs(fuel - sum(r["fuel"] for r in rs)) < 0.0005
+			    and engine_time == sum(r["engine_time"] for r in rs)
+			    and abs(idle_fuel - sum(r["idle_fuel"] for r in rs)) < 0.0005):
+				return
+		raise DumpError("%s: total row does not match the records above it" % self.source)
+
+
+def parse_record(cols, source):
+	if len(cols) != 8 or cols[1] not in UNITS:
+		raise DumpError("%s: bad record %r" % (source, ",".join(cols)))
+	try:
+		return {
+			"seq": int(cols[0]),
+			"units": UNITS[cols[1]],
+			"time": int(cols[2]),
+			"distance": float(cols[3]),
+			"fuel": float(cols[4]),
+			"engine_time": int(cols[5]),
+			"idle_fuel": float(cols[6]),
+			"fuel_economy": float(cols[7]) if cols[7] else None,
+		}
+	except ValueError:
+		raise DumpError("%s: bad record %r" % (source, ",".join(cols)))
+
+
+def parse_total(cols, source):
+	if len(cols) != 8 or cols[2]:
+		raise DumpError("%s: bad total row %r" % (source, ",".join(cols)))
+	try:
+		return (int(cols[1]), float(cols[3]), float(cols[4]), int(cols[5]), float(cols[6]))
+	except ValueError:
+		raise DumpError("%s: bad total row %r" % (source, ",".join(cols)))
+
+
+def dumps(lines, source):
+	"""yield each whole dump in lines. anything outside of a dump is skipped, and a dump that is cut short is an error"""
+	dump = None
+	for line in lines:
+		line = line.strip()
+		if line == HEADER:
+			if dump is not None:
+				raise DumpError("%s: dump cut short" % source)
+			dump = Dump(source)
+		elif dump is not None and line:
+			cols = line.split(",")
+			if cols[0] == "total":
+				dump.total = parse_total(cols, source)
+				dump.check()
+				yield dump
+				dump = None
+			else:
+				dump.records.append(parse_record(cols, source))
+	if dump is not None:
+		raise DumpError("%s: dump cut short" % source)
+
+
+def port_lines(path):
+	"""lines from a serial port or pty, up to the end of the first whole dump"""
+	with open(path, "rb", buffering=0) as f:
+		seen = False
+		line = b""
+		while True:
+			c = f.read(1)
+			if not c:
+				break
+			if c != b"\n":
+				line += c
+				continue
+			text = line.decode("ascii", "replace").strip()
+			line = b""
+			yield text
+			seen = seen or text == HEADER
+			if seen and text.startswith("total,"):
+				break
+
+
+def read_capture(path):
+	if path != "-" and stat.S_ISCHR(os.stat(path).st_mode):
+		return list(dumps(port_lines(path), path))
+	if path == "-":
+		return list(dumps(sys.stdin, "stdin"))
+	with open(path, "r", encoding="ascii", errors="replace", newline="") as f:
+		return list(dumps(f, path))
+
+
+def merge(paths):
+	"""every distinct fill-up in the captures, oldest first"""
+	seen = set()
+	records = []
+	for path in paths:
+		for dump in read_capture(path):
+			for r in dump.records:
+				key = tuple(r[f] for f in FIELDS)
+				if key not in seen:
+					seen.add(key)
+					records.append(r)
+	return records
+
+
+def convert(r, units):
+	"""distance, fuel and idle fuel of record r, in units"""
+	d, f, i = r["distance"], r["fuel"], r["idle_fuel"]
+	if r["units"] != units:
+		if units == "metric":
+			d, f, i = d * KM_PER_MILE, f * LITRE_PER_GALLON, i * LITRE_PER_GALLON
+		else:
+			d, f, i = d / KM_PER_MILE, f / LITRE_PER_GALLON, i / LITRE_PER_GALLON
+	return d, f, i
+
+
+def fuel_economy(distance, fuel, units):
+	"""MPG, or L/100km - None where there is nothing to divide by"""
+	if units == "metric":
+		return fuel * 100.0 / distance if distance else None
+	return distance / fuel if fuel else None
+
+
+def stats(records, units):
+	totals = {"tanks": len(records), "distance": 0.0, "fuel": 0.0, "engine_time": 0, "idle_fuel": 0.0}
+	per_tank = []
+	for r in records:
+		d, f, i = convert(r, units)
+		totals["distance"] += d
+		totals["fuel"] += f
+		totals["idle_fuel"] += i
+		totals["engine_time"] += r["engine_time"]
+		fe = fuel_economy(d, f, units)
+		if fe is not None:
+			per_tank.append(fe)
+	totals["fuel_economy"] = fuel_economy(totals["distance"], totals["fuel"], units)
+	totals["idle_share"] = totals["idle_fuel"] / totals["fuel"] if totals["fuel"] else None
+	totals["per_tank"] = per_tank
+	return totals
+
+
+def hms(seconds):
+	return "%d:%02d:%02d" % (seconds // 3600, seconds // 60 % 60, seconds % 60)
+
+
+def report(s, units):
+	du, fu, feu = ("km", "L", "L/100km") if units == "metric" else ("mi", "gal", "MPG")
+	out = [
+		"tanks            %d" % s["tanks"],
+		"distance         %.3f %s" % (s["distance"], du),
+		"fuel             %.3f %s" % (s["fuel"], fu),
+		"engine time      %s" % hms(s["engine_time"]),
+	]
+	if s["idle_share"] is not None:
+		out.append("idle fuel        %.3f %s (%.1f%% of fuel)" % (s["idle_fuel"], fu, s["idle_share"] * 100.0))
+	if s["fuel_economy"] is not None:
+		out.append("fuel economy     %.3f %s" % (s["fuel_economy"], feu))
+	if s["per_tank"]:
+		pt = s["per_tank"]
+		best, worst = (min(pt), max(pt)) if units == "metric" else (max(pt), min(pt))
+		out.append("per tank         best %.3f, worst %.3f, median %.3f %s" % (best, worst, statistics.median(pt), feu))
+		out.append("distance/tank    %.3f %s" % (s["distance"] / s["tanks"], du))
+	return "\n".join(out)
+
+
+def write_csv(records, out):
+	out.write("seq,units,time,distance,fuel,engine time,idle fuel\n")
+	for r in records:
+		out.write("%d,%s,%d,%.3f,%.3f,%d,%.3f\n" % (r["seq"], "metric" if r["units"] == "metric" else "SAE",
+		    r["time"], r["distance"], r["fuel"], r["engine_time"], r["idle_fuel"]))
+
+
+def main(argv=None):
+	ap = argparse.ArgumentParser(description="MPGuino fill-up log reader")
+	sub = ap.add_subparsers(dest="command", required=True)
+
+	p = sub.add_parser("merge", help="merge the fill-ups in captures into one CSV")
+	p.add_argument("-o", "--output", help="file to write (default: stdout)")
+	p.add_argument("captures", nargs="+")
+
+	p = sub.add_parser("stats", help="long-term statistics over the fill-ups in captures")
+	p.add_argument("--units", choices=("us", "metric"), default="us", help="units for the report")
+	p.add_argument("captures", nargs="+")
+
+	opts = ap.parse_args(argv)
+
+	try:
+		records = merge(opts.captures)
+	except DumpError as e:
+		print("mpgfillups: %s" % e, file=sys.stderr)
+		return 1
+
+	if opts.command == "merge":
+		if opts.output:
+			with open(opts.output, "w", newline="") as f:
+				write_csv(records, f)
+		else:
+			write_csv(records, sys.stdout)
+	else:
+		print(report(stats(records, opts.units), opts.units))
+	return 0
+
+
+if __name__ == "__main__":
+	try:
+		sys.exit(main())
+	except KeyboardInterrupt:	# stop reading a live port
+		sys.exit(130)
+	except BrokenPipeError:		# merge piped into head, and so on
+		sys.exit(0)
@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+"""
+mpglayout - works out the MPGuino EEPROM layout from the settings tables
+in mpguino.cpp
+
+the settings section of the EEPROM is packed from paramsLength, the list
+of bit widths of each setting, in the same order as params (the defaults)
+and parmLabels. the sketch spells out each offset by hand with a chain
+of nextAllowedValue macros, and has to keep paramAddrs, the pXxxIdx
+chain and the signature in step with those lists. this tool reads the
+lists out of the sketch, after running it thru the host C++
+preprocessor with tools/host's stand-in AVR headers (so what it sees
+matches a build with the same options), packs the settings itself, and
+checks the hand written tables against that. only g++ and the python 3
+standard library are needed.
+
+  mpglayout.py [-D OPTION]... map
+      print the EEPROM map: signature, each setting with its index,
+      width, address and default, then the blocks that follow the
+      settings.
+
+  mpglayout.py [-D OPTION]... check [PROGRAM]
+      check the sketch's own tables against the packed layout, and that
+      every default fits in its width. with PROGRAM (tools/host's
+      build/layout, built with the same options), also check that the
+      compiled tables come out the same.
+
+-D turns on a configure.h option for the preprocessor run, just as
+-DuseChryslerMAPCorrection=true would for a host build; --source points
+at a different copy of the sketch.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+from sweet64 import HERE, DEFAULT_SOURCE, split_elements
+
+
+class LayoutError(Exception):
+	pass
+
+
+# --------------------------------------------------------------------------
+# constant expressions, as the AVR compiler would work them out
+
+BINARY = (
+	("||",), ("&&",), ("|",), ("^",), ("&",), ("==", "!="), ("<", "<=", ">", ">="), ("<<", ">>"), ("+", "-"), ("*", "/", "%"),
+)
+
+TYPE_MASK = {"uint8_t": 0xFF, "uint16_t": 0xFFFF, "unsigned int": 0xFFFF, "uint32_t": 0xFFFFFFFF, "unsigned long": 0xFFFFFFFF}
+
+
+def tokenize(expr):
+	expr = re.sub(r"\((?:const\s+)?(?:unsigned int|unsigned long|uint8_t|uint16_t|uint32_t)\)", "", expr)
+	return re.findall(r"0[xX][0-9A-Fa-f]+|0[bB][01]+|\d+|\w+|<<|>>|<=|>=|==|!=|&&|\|\||\S", expr)
+
+
+class Expr:
+	"""a small C constant expression evaluator - enough for the layout constants, ternaries included"""
+
+	def __init__(self, expr, symbols):
+		self.tokens = tokenize(expr)
+		self.symbols = symbols
+		self.i = 0
+
+	def value(self):
+		v = self.ternary()
+		if self.i != len(self.tokens):
+			raise LayoutError("can't work out %r" % " ".join(self.tokens))
+		return v
+
+	def peek(self):
+		return self.tokens[self.i] if self.i < len(self.tokens) else None
+
+	def take(self, t=None):
+		if t is not None and self.peek() != t:
+			raise LayoutError("can't work out %r" % " ".join(self.tokens))
+		self.i += 1
+		return self.tokens[self.i - 1]
+
+	def ternary(self):
+		c = self.binary(0)
+		if self.peek() != "?":
+			return c
+		self.take("?")
+		a = self.ternary()
+		self.take(":")
+		b = self.ternary()
+		return a if c else b
+
+	def binary(self, level):
+		if level == len(BINARY):
+			return self.unary()
+		v = self.binary(level + 1)
+		while self.peek() in BINARY[level]:
+			op = self.take()
+			w = self.binary(level + 1)
+			if op == "/":
+				v = v // w
+			elif op == "%":
+				v = v % w
+			elif op == "&&":
+				v = int(bool(v) and bool(w))
+			elif op == "||":
+				v = int(bool(v) or bool(w))
+			else:
+				v = int(eval("v %s w" % op))
+		return v
+
+	def unary(self):
+		t = self.take()
+		if t == "(":
+			v = self.ternary()
+			self.take(")")
+			return v
+		if t == "-":
+			return -self.unary()
+		if t == "~":
+			return ~self.unary()
+		if t == "!":
+			return int(not self.unary())
+		if re.match(r"0[bB]", t):
+			v = int(t[2:], 2)
+		elif re.match(r"0[xX]|\d", t):
+			v = int(t, 0) if not re.match(r"0\d", t) else int(t, 8)
+		elif t in self.symbols:
+			v = self.symbols[t]
+		else:
+			raise LayoutError("unknown symbol %s" % t)
+		while self.peek() and re.match(r"[uUlL]+$", self.peek()):	# 1000ul tokenizes as 1000, ul
+			self.take()
+		return v
+
+
+def c_value(expr, symbols):
+	return Expr(expr, symbols).value()
+
+
+# --------------------------------------------------------------------------
+# reading the sketch
+
+def preprocess(source, options):
+	"""the sketch, preprocessed, with the size of the EEPROM tacked on - E2END is a macro, so it leaves no constant of its own"""
+	args = ["g++", "-E", "-P", "-std=gnu++11", "-I", os.path.join(HERE, "host")]
+	args += ["-D%s" % (o if "=" in o else o + "=true") for o in options]
+	text = "#include \"%s\"\nconst unsigned int layoutE2END = E2END;\n" % os.path.abspath(source)
+	return subprocess.run(args + ["-x", "c++", "-"], check=True, input=text, stdout=subprocess.PIPE, universal_newlines=True).stdout
+
+
+def array(text, name):
+	m = re.search(r"\b%s\[\]\s*=\s*\{(.*?)\};" % name, text, re.S)
+	if not m:
+		raise LayoutError("no %s in the sketch" % name)
+	return m.group(1)
+
+
+class Layout:
+
+	def __init__(self, source=DEFAULT_SOURCE, options=()):
+		text = preprocess(source, options)
+		self.symbols = {}
+
+		counts = {}
+		for m in re.finditer(r"(\w+)\[\]\s*=\s*\{([^{}]*)\}", text):
+			counts[m.group(1)] = len(split_elements(m.group(2)))
+
+		for m in re.finditer(r"const\s+(uint8_t|uint16_t|uint32_t|unsigned int|unsigned long)\s+(\w+)\s*=\s*([^;{]+);", text):
+			e = re.sub(r"sizeof\((\w+)\)\s*/\s*sizeof\([\w ]+\)", lambda s: str(counts.get(s.group(1), "?")), m.group(3))
+			try:
+				self.symbols[m.group(2)] = c_value(e, self.symbols) & TYPE_MASK[m.group(1)]
+			except (LayoutError, ZeroDivisionError):
+				pass
+
+		self.names = [re.sub(r"^pSize", "", e) for e in split_elements(array(text, "paramsLength"))]
+		self.bits = [c_value(e, self.symbols) for e in split_elements(array(text, "paramsLength"))]
+		self.defaults = [c_value(e, self.symbols) for e in split_elements(array(text, "params"))]
+		self.addrs = [c_value(e, self.symbols) & 0xFF for e in split_elements(array(text, "paramAddrs"))]
+		labels = "".join(re.findall(r"\"((?:[^\"\\]|\\.)*)\"", array(text, "parmLabels")))
+		self.labels = labels.replace("\\\\", "\\").split("\\0")[:-1]
+
+		self.start = self.symbols["eeAdrSettingsStart"]
+		self.first_idx = self.symbols["eePtrSettingsStart"]
+
+		# the layout itself - each setting takes the whole bytes its width needs, one after the other
+		self.offsets = []
+		o = 0
+		for b in self.bits:
+			self.offsets.append(o)
+			o += (b + 7) // 8
+		self.size = o
+
+		self.signature = ((self.symbols["guinosig"] << 16) + (((len(self.bits) + self.size) & 0xFF) << 8) + self.symbols["EEPROMusage"])
+
+		# every block in the EEPROM with a start and an end address, in address order
+		self.blocks = []
+		for name in re.findall(r"const\s+unsigned int\s+eeAdr(\w+)Start\b", text):
+			if "eeAdr%sEnd" % name in self.symbols:
+				self.blocks.append((name, self.symbols["eeAdr%sStart" % name], self.symbols["eeAdr%sEnd" % name]))
+		self.blocks.sort(key=lambda b: b[1])
+
+	def rows(self):
+		"""(index, name, bits, address, default) for each setting"""
+		return [(self.first_idx + i, self.names[i], self.bits[i], self.start + self.offsets[i],
+		    self.defaults[i] if i < len(self.defaults) else 0) for i in range(len(self.bits))]
+
+	def problems(self):
+		out = []
+		n = len(self.bits)
+		if not n == len(self.defaults) == len(self.labels) == len(self.addrs) - 1:
+			out.append("paramsLength, params, parmLabels and paramAddrs have %d, %d, %d and %d entries (paramAddrs takes one more)" % (
+			    n, len(self.defaults), len(self.labels), len(self.addrs)))
+		for idx, name, bits, addr, default in self.rows():
+			i = idx - self.first_idx
+			if i < len(self.addrs) and self.addrs[i] != addr:
+				out.append("%s: paramAddrs says %d, packed address is %d" % (name, self.addrs[i], addr))
+			if "p%sIdx" % name in self.symbols and self.symbols["p%sIdx" % name] != idx:
+				out.append("%s: p%sIdx is %d, but it is setting %d" % (name, name, self.symbols["p%sIdx" % name], idx))
+			if i < len(self.defaults) and default >= (1 << bits):
+				out.append("%s: default %d does not fit in %d bits" % (name, default, bits))
+		if len(self.addrs) and self.addrs[-1] != self.start + self.size:
+			out.append("paramAddrs ends at %d, packed settings end at %d" % (self.addrs[-1], self.start + self.size))
+		if self.symbols.get("eeAdrSettingsEnd") != self.start + self.size:
+			out.append("eeAdrSettingsEnd is %s, packed settings end at %d" % (self.symbols.get("eeAdrSettingsEnd"), self.start + self.size))
+		if self.symbols.get("newEEPROMsignature") != self.signature:
+			out.append("newEEPROMsignature is %06X, expected %06X" % (self.symbols.get("newEEPROMsignature", 0), self.signature))
+		if self.start + self.size > 255:
+			out.append("settings run past address 255, which paramAddrs can't hold")
+		for (a, s, e), (b, t, f) in zip(self.blocks, self.blocks[1:]):
+			if e > t:
+				out.append("%s block (%d-%d) runs into %s block (%d-%d)" % (a, s, e, b, t, f))
+		if self.blocks and self.blocks[-1][2] > self.symbols["layoutE2END"] + 1:
+			out.append("%s block runs past the end of the EEPROM" % self.blocks[-1][0])
+		return out
+
+	def compiled(self):
+		"""the lines tools/host's build/layout prints, as this layout has them"""
+		out = ["signature %06X" % self.signature]
+		out += ["setting %d %d %d %d" % (idx, bits, addr, default) for idx, name, bits, addr, default in self.rows()]
+		out.append("settings end %d" % (self.start + self.size))
+		return out
+
+
+def report(layout):
+	out = ["signature %06X, %d settings in %d bytes" % (layout.signature, len(layout.bits), layout.size), ""]
+	out.append(" idx  addr  bytes  bits  default     name")
+	for (idx, name, bits, addr, default), label in zip(layout.rows(), layout.labels + [""] * len(layout.bits)):
+		out.append("%4d  %4d  %5d  %4d  %-10d  %s%s" % (idx, addr, (bits + 7) // 8, bits, default, name, ("  (%s)" % label) if label else ""))
+	out.append("")
+	out.append("block          start   end  bytes")
+	for name, s, e in layout.blocks:
+		out.append("%-12s  %6d  %4d  %5d" % (name, s, e, e - s))
+	out.append("%d of %d bytes of EEPROM used" % (layout.blocks[-1][2] if layout.blocks else 0, layout.symbols["layoutE2END"] + 1))
+	return "\n".join(out)
+
+
+# --------------------------------------------------------------------------
+# command line
+
+def main(argv=None):
+	ap = argparse.ArgumentParser(description="work out and check the EEPROM layout of mpguino.cpp")
+	ap.add_argument("--source", default=DEFAULT_SOURCE, help="the sketch to read the settings tables from")
+	ap.add_argument("-D", dest="options", action="append", default=[], metavar="OPTION", help="turn on a configure.h option")
+	sub = ap.add_subparsers(dest="command", required=True)
+
+	sub.add_parser("map", help="print the EEPROM map")
+
+	p = sub.add_parser("check", help="check the sketch's tables against the packed layout")
+	p.add_argument("program", nargs="?", help="tools/host's build/layout, built with the same options")
+
+	args = ap.parse_args(argv)
+
+	try:
+		layout = Layout(args.source, args.options)
+
+		if args.command == "map":
+			print(report(layout))
+			return 0
+
+		bad = layout.problems()
+		if args.program:
+			got = subprocess.run([args.program], check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout.split("\n")[:-1]
+			want = layout.compiled()
+			for k in range(max(len(got), len(want))):
+				g = got[k] if k < len(got) else "(nothing)"
+				w = want[k] if k < len(want) else "(nothing)"
+				if g != w:
+					bad.append("compiled: %s, packed: %s" % (g, w))
+		for b in bad:
+			print(b)
+		print("%d settings, %d bytes, signature %06X, %d failures" % (len(layout.bits), layout.size, layout.signature, len(bad)))
+		return 1 if bad else 0
+
+	except (LayoutError, OSError, subprocess.CalledProcessError) as e:
+		print("mpglayout: %s" % e, file=sys.stderr)
+		return 1
+
+
+if __name__ == "__main__":
+	sys.exit(main())
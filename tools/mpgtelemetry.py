@@ -0,0 +1,625 @@
+#!/usr/bin/env python3
+"""
+mpgtelemetry - host side companion to the MPGuino binary telemetry stream
+
+reads the COBS framed, CRC-16 checked telemetry that the MPGuino sends
+when serial data logging is set to binary (see the frame layout above
+telemetryPoll() in mpguino.cpp), from log files or straight from a
+serial port or pty (set its baud rate first, with stty). a live port is
+read until interrupted with ctrl-C. only the python 3 standard library
+is needed.
+
+  mpgtelemetry.py ingest [-j N] [-o DIR] [options] LOG...
+      decode each log, optionally writing one columnar archive per log
+      into DIR, and print statistics merged over all of them. logs are
+      spread over N worker processes (default: one per CPU), so a batch
+      of archived logs is decoded in parallel.
+
+  mpgtelemetry.py stats [-j N] [options] ARCHIVE...
+      recompute statistics from archives written by ingest, without
+      decoding the raw logs again.
+
+  mpgtelemetry.py dump ARCHIVE
+      write the rows of an archive out as CSV.
+
+statistics cover fuel economy histograms (distance weighted, over
+fixed length windows of driving), a fuel economy vs speed curve, and
+idle statistics (injector pulses with no VSS pulses).
+
+each data frame carries raw measurement deltas since the previous
+frame, so a frame the MPGuino had to skip costs nothing - its
+measurements roll over into the next frame, and only the sequence
+number shows the gap. frames that are lost or damaged on the wire are
+gone, and are counted as bad frames. raw counts are turned into fuel
+and distance using the settings from the most recent description frame;
+data frames that arrive before the first one are held back until it
+shows up.
+
+archive layout (all integers little endian):
+
+  magic "MPGT", version byte, then a sequence of records, each starting
+  with a one byte tag:
+
+    "D" : u32 length, then a JSON object holding a description frame's
+          settings. applies to every row after it
+    "H" : u32 length, then a JSON object holding a health frame
+    "C" : u32 length, then a JSON object holding the frame counters of
+          the log. comes last
+    "R" : u32 row count, then for each column in COLUMNS order, a u32
+          byte length followed by that column's values. each column is
+          differenced COLUMN_ORDER times within the record (the first
+          row against 0), and each result is zigzag encoded into an
+          unsigned LEB128 varint
+
+  the counters in consecutive rows are nearly equal, so most values fit
+  in one byte.
+"""
+
+import argparse
+import binascii
+import collections
+import concurrent.futures
+import json
+import os
+import struct
+import sys
+
+MAGIC = b"MPGT"
+VERSION = 1
+
+COLUMNS = (
+	"time",			# timer 2 ticks since the first frame of the log, unwrapped
+	"seq",			# frame sequence number
+	"gap",			# slots missed since the previous frame of any type
+	"vss_pulses",
+	"inj_pulses",
+	"vss_cycles",
+	"inj_cycles",
+	"inj_open_cycles",
+	"analog0",		# -1 if the unit was built without useAnalogRead
+	"analog1",
+)
+
+# times of differencing applied to each column before it is stored.
+# time and seq climb steadily, so their second differences are mostly 0
+COLUMN_ORDER = (2, 2, 1, 1, 1, 1, 1, 1, 1, 1)
+
+ROWS_PER_RECORD = 65536
+PENDING_LIMIT = 65536		# data frames to hold back while waiting for a description frame
+SESSION_BREAK = 5.0		# seconds between data frames that ends a session
+
+KM_PER_MILE = 1.609344
+LITRE_PER_GALLON = 3.785411784
+
+DESCRIPTION_FIELDS = (
+	"ticks_per_second",
+	"frames_per_second",
+	"metric",
+	"us_per_unit_fuel",
+	"injector_settle_us",
+	"pulses_per_unit_distance",
+	"crank_revs_per_injection",
+)
+
+
+# --------------------------------------------------------------------------
+# frame decoding
+
+def cobs_decode(data):
+	out = bytearray()
+	i = 0
+	n = len(data)
+	while i < n:
+		code = data[i]
+		if code == 0 or i + code > n:
+			return None
+		out += data[i + 1:i + code]
+		i += code
+		if code < 255 and i < n:
+			out.append(0)
+	return bytes(out)
+
+
+def frames(stream, counters, chunk_size=1 << 20):
+	"""yield (type, payload) for each frame in stream that passes its CRC"""
+	tail = b""
+	while True:
+		try:
+			chunk = stream.read(chunk_size)
+		except KeyboardInterrupt:	# stop reading a live port, and report on what came in
+			break
+		if not chunk:
+			break
+		parts = (tail + chunk).split(b"\x00")
+		tail = parts.pop()
+		for part in parts:
+			if not part:
+				continue
+			frame = cobs_decode(part)
+			if frame is None or len(frame) < 4:
+				counters["bad_frames"] += 1
+				continue
+			body = frame[:-2]
+			if binascii.crc_hqx(body, 0xFFFF) != frame[-2] | (frame[-1] << 8):
+				counters["bad_frames"] += 1
+				continue
+			yield body[0], body
+	if tail:
+		counters["bad_frames"] += 1
+
+
+DATA_FRAME = struct.Struct("<BBIIIIII")
+ANALOG = struct.Struct("<HH")
+DESCRIPTION_FRAME = struct.Struct("<BBIBBIIII")
+HEALTH_FRAME = struct.Struct("<BBHBBBB")
+
+
+def decode_stream(stream):
+	"""
+	yield ("D", description dict), ("R", row tuple) and ("H", health dict)
+	events in stream order. returns the frame counters when exhausted
+	"""
+	counters = {"data_frames": 0, "description_frames": 0, "health_frames": 0, "bad_frames": 0, "unknown_frames": 0, "missed_slots": 0}
+	last_seq = None
+	last_ts = None
+	time = 0
+
+	for kind, body in frames(stream, counters):
+		seq = body[1] if len(body) > 1 else 0
+		gap = 0
+		if last_seq is not None:
+			gap = (seq - last_seq - 1) & 0xFF
+		last_seq = seq
+		counters["missed_slots"] += gap
+
+		if kind == 1 and len(body) in (DATA_FRAME.size, DATA_FRAME.size + ANALOG.size):
+			f = DATA_FRAME.unpack_from(body)
+			a = ANALOG.unpack_from(body, DATA_FRAME.size) if len(body) > DATA_FRAME.size else (-1, -1)
+			if last_ts is not None:
+				time += (f[2] - last_ts) & 0xFFFFFFFF
+			last_ts = f[2]
+			counters["data_frames"] += 1
+			yield "R", (time, seq, gap) + f[3:] + a
+		elif kind == 2 and len(body) == DESCRIPTION_FRAME.size:
+			counters["description_frames"] += 1
+			yield "D", dict(zip(DESCRIPTION_FIELDS, DESCRIPTION_FRAME.unpack_from(body)[2:]))
+		elif kind == 3 and len(body) == HEALTH_FRAME.size:
+			counters["health_frames"] += 1
+			f = HEALTH_FRAME.unpack_from(body)
+			yield "H", {"stack_free": f[2], "sweet64_depth": f[3], "lcd_buffer": f[4], "serial_tx_buffer": f[5], "serial_rx_buffer": f[6]}
+		else:
+			counters["unknown_frames"] += 1
+
+	return counters
+
+
+# --------------------------------------------------------------------------
+# columnar archive
+
+def put_varint(out, v):
+	v = (v << 1) ^ (v >> 63)	# zigzag
+	while v > 0x7F:
+		out.append((v & 0x7F) | 0x80)
+		v >>= 7
+	out.append(v)
+
+
+def get_varints(data, count):
+	values = []
+	v = 0
+	shift = 0
+	for b in data:
+		v |= (b & 0x7F) << shift
+		if b & 0x80:
+			shift += 7
+			continue
+		values.append((v >> 1) ^ -(v & 1))
+		v = 0
+		shift = 0
+	if len(values) != count:
+		raise ValueError("archive column is corrupt")
+	return values
+
+
+def encode_column(column, order):
+	for _ in range(order):
+		column = [v - p for v, p in zip(column, [0] + column[:-1])]
+	out = bytearray()
+	for v in column:
+		put_varint(out, v)
+	return out
+
+
+def decode_column(data, count, order):
+	column = get_varints(data, count)
+	for _ in range(order):
+		total = 0
+		for i, v in enumerate(column):
+			total += v
+			column[i] = total
+	return column
+
+
+class ArchiveWriter:
+
+	def __init__(self, path):
+		self.f = open(path, "wb")
+		self.f.write(MAGIC + bytes((VERSION,)))
+		self.rows = []
+
+	def record(self, tag, d):
+		self.flush()
+		j = json.dumps(d, sort_keys=True).encode()
+		self.f.write(tag + struct.pack("<I", len(j)) + j)
+
+	def row(self, r):
+		self.rows.append(r)
+		if len(self.rows) >= ROWS_PER_RECORD:
+			self.flush()
+
+	def flush(self):
+		if not self.rows:
+			return
+		self.f.write(b"R" + struct.pack("<I", len(self.rows)))
+		for column, order in zip(zip(*self.rows), COLUMN_ORDER):
+			out = encode_column(list(column), order)
+			self.f.write(struct.pack("<I", len(out)) + out)
+		self.rows = []
+
+	def close(self):
+		self.flush()
+		self.f.close()
+
+
+def read_archive(path):
+	"""yield the same events as decode_stream(), plus ("C", frame counters)"""
+	with open(path, "rb") as f:
+		head = f.read(5)
+		if head[:4] != MAGIC or head[4] != VERSION:
+			raise ValueError("%s is not a version %d telemetry archive" % (path, VERSION))
+		while True:
+			tag = f.read(1)
+			if not tag:
+				break
+			(n,) = struct.unpack("<I", f.read(4))
+			if tag in (b"D", b"H", b"C"):
+				yield tag.decode(), json.loads(f.read(n))
+			elif tag == b"R":
+				columns = []
+				for order in COLUMN_ORDER:
+					(size,) = struct.unpack("<I", f.read(4))
+					columns.append(decode_column(f.read(size), n, order))
+				for r in zip(*columns):
+					yield "R", r
+			else:
+				raise ValueError("%s: unknown record %r" % (path, tag))
+
+
+# --------------------------------------------------------------------------
+# statistics
+
+class Stats:
+	"""
+	statistics over one or more logs. everything in here is a sum, a
+	maximum, or a histogram with fixed bins, so stats from separate logs
+	merge exactly
+	"""
+
+	def __init__(self, metric, window, fe_bin, fe_bins, speed_bin, speed_bins):
+		self.metric = metric
+		self.window = window
+		self.fe_bin = fe_bin
+		self.speed_bin = speed_bin
+		self.counters = {}
+		self.undescribed_frames = 0
+		self.sessions = 0
+		self.time = 0.0
+		self.engine_time = 0.0
+		self.moving_time = 0.0
+		self.distance = 0.0
+		self.fuel = 0.0
+		self.idle_time = 0.0
+		self.idle_fuel = 0.0
+		self.idle_episodes = 0
+		self.longest_idle = 0.0
+		self.fe_histogram = [0.0] * fe_bins	# distance driven in each FE bin
+		self.fuel_cut_distance = 0.0		# distance driven with no fuel used at all
+		self.speed_distance = [0.0] * speed_bins
+		self.speed_fuel = [0.0] * speed_bins
+		self.health = None
+
+	def merge(self, other):
+		for k, v in other.counters.items():
+			self.counters[k] = self.counters.get(k, 0) + v
+		for k in ("undescribed_frames", "sessions", "time", "engine_time", "moving_time", "distance", "fuel",
+			  "idle_time", "idle_fuel", "idle_episodes", "fuel_cut_distance"):
+			setattr(self, k, getattr(self, k) + getattr(other, k))
+		self.longest_idle = max(self.longest_idle, other.longest_idle)
+		for mine, theirs in ((self.fe_histogram, other.fe_histogram), (self.speed_distance, other.speed_distance),
+				     (self.speed_fuel, other.speed_fuel)):
+			for i, v in enumerate(theirs):
+				mine[i] += v
+		if other.health is not None:
+			self.health = other.health
+
+	def fe(self, distance, fuel):
+		if self.metric:
+			return 100.0 * fuel / distance	# L/100km
+		return distance / fuel			# MPG
+
+	def report(self):
+		dist_unit, fuel_unit, fe_unit, speed_unit = ("km", "L", "L/100km", "km/h") if self.metric else ("mi", "gal", "MPG", "MPH")
+		out = []
+		c = self.counters
+		out.append("frames: %d data, %d description, %d health, %d bad, %d unknown, %d missed slots" % (
+			c.get("data_frames", 0), c.get("description_frames", 0), c.get("health_frames", 0),
+			c.get("bad_frames", 0), c.get("unknown_frames", 0), c.get("missed_slots", 0)))
+		if self.undescribed_frames:
+			out.append("data frames dropped for want of a description frame: %d" % self.undescribed_frames)
+		out.append("sessions: %d, logged time %.1f h, engine running %.1f h, moving %.1f h" % (
+			self.sessions, self.time / 3600, self.engine_time / 3600, self.moving_time / 3600))
+		out.append("distance %.2f %s, fuel %.3f %s" % (self.distance, dist_unit, self.fuel, fuel_unit))
+		if self.distance > 0 and self.fuel > 0:
+			out.append("overall FE %.2f %s" % (self.fe(self.distance, self.fuel), fe_unit))
+
+		out.append("")
+		out.append("idle: %.1f min in %d episodes (longest %.1f min), %.3f %s" % (
+			self.idle_time / 60, self.idle_episodes, self.longest_idle / 60, self.idle_fuel, fuel_unit))
+		if self.engine_time > 0:
+			out.append("idle share: %.1f%% of engine running time, %.1f%% of fuel" % (
+				100.0 * self.idle_time / self.engine_time, 100.0 * self.idle_fuel / self.fuel if self.fuel else 0.0))
+		if self.idle_time > 0:
+			out.append("idle fuel rate: %.3f %s/h" % (3600.0 * self.idle_fuel / self.idle_time, fuel_unit))
+
+		out.append("")
+		out.append("FE histogram, %.1f s windows, by distance driven:" % self.window)
+		total = sum(self.fe_histogram) + self.fuel_cut_distance
+		for i, d in enumerate(self.fe_histogram):
+			if d > 0:
+				lo = i * self.fe_bin
+				hi = "+" if i == len(self.fe_histogram) - 1 else "-%g" % (lo + self.fe_bin)
+				out.append("  %6g%-6s %s  %10.2f %s %5.1f%%" % (lo, hi, fe_unit, d, dist_unit, 100.0 * d / total))
+		if self.fuel_cut_distance > 0:
+			out.append("  fuel cut          %10.2f %s %5.1f%%" % (self.fuel_cut_distance, dist_unit, 100.0 * self.fuel_cut_distance / total))
+
+		out.append("")
+		out.append("FE vs speed:")
+		for i, d in enumerate(self.speed_distance):
+			if d > 0:
+				lo = i * self.speed_bin
+				hi = "+" if i == len(self.speed_distance) - 1 else "-%g" % (lo + self.speed_bin)
+				fe = "%8.2f %s" % (self.fe(d, self.speed_fuel[i]), fe_unit) if self.speed_fuel[i] > 0 else "fuel cut"
+				out.append("  %4g%-4s %s  %s  over %.2f %s" % (lo, hi, speed_unit, fe, d, dist_unit))
+
+		if self.health is not None:
+			out.append("")
+			out.append("last health frame: " + ", ".join("%s %d" % kv for kv in sorted(self.health.items())))
+		return "\n".join(out)
+
+
+class Analyzer:
+	"""turns the event stream of one log into Stats"""
+
+	def __init__(self, stats):
+		self.s = stats
+		self.desc = None
+		self.pending = collections.deque()
+		self.last_time = None
+		self.idle_run = 0.0
+		self.w_time = self.w_dist = self.w_fuel = 0.0
+
+	def description(self, d):
+		if self.desc is None:
+			self.desc = d
+			pending, self.pending = self.pending, collections.deque()
+			for r in pending:
+				self.row(r)
+		self.desc = d
+
+	def health(self, h):
+		self.s.health = h
+
+	def row(self, r):
+		if self.desc is None:
+			if len(self.pending) >= PENDING_LIMIT:
+				self.pending.popleft()
+				self.s.undescribed_frames += 1
+			self.pending.append(r)
+			return
+
+		s = self.s
+		d = self.desc
+		tps = float(d["ticks_per_second"])
+		time = r[0]
+		dt = None if self.last_time is None else (time - self.last_time) / tps
+		self.last_time = time
+		if dt is None or dt > SESSION_BREAK:
+			self.end_session()
+			s.sessions += 1
+			return	# nothing to say how long this frame's measurements took
+
+		vss, inj, _, inj_cycles, open_cycles = r[3:8]
+		distance = vss / float(d["pulses_per_unit_distance"]) if d["pulses_per_unit_distance"] else 0.0
+		fuel = open_cycles * 1e6 / tps / d["us_per_unit_fuel"] if d["us_per_unit_fuel"] else 0.0
+		if d["metric"] != s.metric:
+			if s.metric:
+				distance *= KM_PER_MILE
+				fuel *= LITRE_PER_GALLON
+			else:
+				distance /= KM_PER_MILE
+				fuel /= LITRE_PER_GALLON
+
+		s.time += dt
+		s.distance += distance
+		s.fuel += fuel
+		if inj:
+			s.engine_time += dt
+		if vss:
+			s.moving_time += dt
+
+		if inj and not vss:
+			if self.idle_run == 0.0:
+				s.idle_episodes += 1
+			self.idle_run += dt
+			s.idle_time += dt
+			s.idle_fuel += fuel
+		else:
+			self.end_idle()
+
+		self.w_time += dt
+		self.w_dist += distance
+		self.w_fuel += fuel
+		if self.w_time >= s.window:
+			self.end_window()
+
+	def end_idle(self):
+		self.s.longest_idle = max(self.s.longest_idle, self.idle_run)
+		self.idle_run = 0.0
+
+	def end_window(self):
+		s = self.s
+		if self.w_dist > 0:
+			if self.w_fuel > 0:
+				i = min(int(s.fe(self.w_dist, self.w_fuel) / s.fe_bin), len(s.fe_histogram) - 1)
+				s.fe_histogram[i] += self.w_dist
+			else:
+				s.fuel_cut_distance += self.w_dist
+			i = min(int(3600.0 * self.w_dist / self.w_time / s.speed_bin), len(s.speed_distance) - 1)
+			s.speed_distance[i] += self.w_dist
+			s.speed_fuel[i] += self.w_fuel
+		self.w_time = self.w_dist = self.w_fuel = 0.0
+
+	def end_session(self):
+		self.end_idle()
+		if self.w_time > 0:
+			self.end_window()
+
+	def finish(self):
+		self.end_session()
+		self.s.undescribed_frames += len(self.pending)
+		self.pending.clear()
+
+
+def new_stats(opts):
+	metric = opts.units == "metric"
+	if metric:
+		return Stats(True, opts.window, 1.0, 40, 10.0, 20)
+	return Stats(False, opts.window, 2.0, 50, 5.0, 20)
+
+
+def analyze(events, opts, archive_path=None):
+	stats = new_stats(opts)
+	analyzer = Analyzer(stats)
+	writer = ArchiveWriter(archive_path) if archive_path else None
+	try:
+		it = iter(events)
+		while True:
+			try:
+				tag, v = next(it)
+			except StopIteration as e:
+				if e.value is not None:
+					stats.counters = e.value
+					if writer:
+						writer.record(b"C", e.value)
+				break
+			if tag == "R":
+				analyzer.row(v)
+				if writer:
+					writer.row(v)
+				continue
+			if tag == "D":
+				analyzer.description(v)
+			elif tag == "H":
+				analyzer.health(v)
+			elif tag == "C":
+				stats.counters = v
+			if writer:
+				writer.record(tag.encode(), v)
+	finally:
+		if writer:
+			writer.close()
+	analyzer.finish()
+	return stats
+
+
+def ingest_one(path, opts):
+	archive = None
+	if opts.output:
+		archive = os.path.join(opts.output, os.path.splitext(os.path.basename(path))[0] + ".mpgt")
+	with open(path, "rb", buffering=0) as f:
+		return analyze(decode_stream(f), opts, archive)
+
+
+def stats_one(path, opts):
+	return analyze(read_archive(path), opts)
+
+
+def run_batch(func, paths, opts):
+	total = new_stats(opts)
+	if len(paths) == 1 or opts.jobs == 1:
+		for p in paths:
+			total.merge(func(p, opts))
+		return total
+	with concurrent.futures.ProcessPoolExecutor(max_workers=opts.jobs) as pool:
+		for stats in pool.map(func, paths, [opts] * len(paths)):
+			total.merge(stats)
+	return total
+
+
+def dump(path, out):
+	out.write(",".join(COLUMNS) + "\n")
+	for tag, v in read_archive(path):
+		if tag == "R":
+			out.write(",".join(str(x) for x in v) + "\n")
+		else:
+			out.write("# %s %s\n" % (tag, json.dumps(v, sort_keys=True)))
+
+
+def main(argv=None):
+	ap = argparse.ArgumentParser(description="decode MPGuino binary telemetry logs")
+	sub = ap.add_subparsers(dest="command", required=True)
+
+	def common(p):
+		p.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1, help="worker processes")
+		p.add_argument("--units", choices=("us", "metric"), default="us", help="units for the report")
+		p.add_argument("--window", type=float, default=1.0, help="seconds of driving per FE histogram sample")
+
+	p = sub.add_parser("ingest", help="decode raw logs (files, serial ports or ptys)")
+	common(p)
+	p.add_argument("-o", "--output", help="directory to write one archive per log into")
+	p.add_argument("logs", nargs="+")
+
+	p = sub.add_parser("stats", help="statistics from archives")
+	common(p)
+	p.add_argument("archives", nargs="+")
+
+	p = sub.add_parser("dump", help="write an archive out as CSV")
+	p.add_argument("archive")
+
+	opts = ap.parse_args(argv)
+
+	if opts.command == "dump":
+		dump(opts.archive, sys.stdout)
+		return 0
+
+	if opts.window <= 0:
+		ap.error("--window must be positive")
+
+	if opts.command == "ingest":
+		if opts.output:
+			os.makedirs(opts.output, exist_ok=True)
+		total = run_batch(ingest_one, opts.logs, opts)
+	else:
+		total = run_batch(stats_one, opts.archives, opts)
+
+	print(total.report())
+	return 0
+
+
+if __name__ == "__main__":
+	try:
+		sys.exit(main())
+	except KeyboardInterrupt:	# stop reading a live port
+		sys.exit(130)
+	except BrokenPipeError:		# dump piped into head, and so on
+		sys.exit(0)
@@ -0,0 +1,477 @@
+#!/usr/bin/env python3
+"""
+sweet64 - host side assembler and disassembler for the SWEET64 programs in
+mpguino.cpp
+
+the SWEET64 programs are PROGMEM byte arrays with hand counted skip
+offsets, and register pairs packed into one byte as 0xXY (X and Y are
+register numbers 1 to 5; a single register operand is written 0x0Y). this
+tool reads the programs straight out of the sketch, after running it
+thru the host C++ preprocessor with tools/host's stand-in AVR headers, so
+what it sees matches a build with the same options. only g++ and the
+python 3 standard library are needed.
+
+  sweet64.py disasm [-D OPTION]... [PROGRAM]...
+      list each program (all of them by default) with symbolic registers,
+      labels in place of skip offsets, and a one pass cycle estimate from
+      the same opcode cost table that useSWEET64disassembler uses.
+
+  sweet64.py asm [-D OPTION]... [-o HEADER] LISTING
+      assemble a listing, in the form disasm writes, into PROGMEM arrays
+      in the sketch's own style, with skip offsets worked out from the
+      labels.
+
+  sweet64.py check [-D OPTION]...
+      disassemble every program, assemble the listing again, and fail if
+      any byte comes out different, or if a skip lands anywhere but on
+      the start of an instruction in the same program. also fails if
+      S64verifyList, S64verifySize and S64verifyNames don't name the same
+      programs in the same order.
+
+-D turns on a configure.h option for the preprocessor run, just as
+-DuseSWEET64multDiv=true would for a host build; --source points at a
+different copy of the sketch.
+
+listing syntax:
+
+  program prgmName		; starts a program
+  label:			; marks the next instruction as a skip target
+  	Mnemonic operands	; one instruction
+  end				; ends the program
+
+operands are R1 to R5 for registers (two of them, comma separated, for a
+register pair), a label for a skip, and a number or a sketch identifier
+(idxDecimalPoint, rvVSSpulseIdx, pTankSizeIdx and so on) for a byte.
+SkipIfIndexBelow takes a label and then the index bound. anything after
+a ';' is a comment.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_SOURCE = os.path.join(HERE, "..", "mpguino.cpp")
+
+HAS_REGISTERS = 0x40
+HAS_BYTE = 0x80
+
+SKIPS = ("SkipIfMetricMode", "SkipIfZero", "SkipIfLTorE", "SkipIfLSBset", "SkipIfMSBset", "SkipIfIndexBelow", "Skip")
+
+
+class AsmError(Exception):
+	pass
+
+
+# --------------------------------------------------------------------------
+# reading the sketch
+
+def preprocess(source, options):
+	args = ["g++", "-E", "-P", "-std=gnu++11", "-I", os.path.join(HERE, "host"),
+		"-DuseSWEET64verifier=true", "-DuseSWEET64disassembler=true"]
+	args += ["-D%s" % (o if "=" in o else o + "=true") for o in options]
+	return subprocess.run(args + [source], check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+
+
+def split_elements(body):
+	"""split an array initializer at its top level commas"""
+	out = []
+	depth = 0
+	cur = ""
+	for c in body:
+		if c == "(":
+			depth += 1
+		elif c == ")":
+			depth -= 1
+		if c == "," and depth == 0:
+			out.append(cur.strip())
+			cur = ""
+		else:
+			cur += c
+	if cur.strip():
+		out.append(cur.strip())
+	return out
+
+
+def c_eval(expr, symbols, counts={}):
+	"""value of a simple C constant expression, or None - counts holds the element count of each array, for sizeof"""
+	e = re.sub(r"sizeof\((\w+)\)\s*/\s*sizeof\([\w ]+\)", lambda m: str(counts.get(m.group(1), "?")), expr)
+	e = re.sub(r"\b(0x[0-9A-Fa-f]+|\d+)[uUlL]+\b", r"\1", e)
+	e = re.sub(r"\((unsigned int|unsigned long|uint8_t|uint16_t|uint32_t)\)", "", e)
+	if re.search(r"[?:\"']|sizeof", e):
+		return None
+	try:
+		return int(eval(e, {"__builtins__": {}}, symbols))
+	except Exception:
+		return None
+
+
+class Sketch:
+
+	def __init__(self, source=DEFAULT_SOURCE, options=()):
+		text = preprocess(source, options)
+		self.symbols = {}
+		self.programs = {}	# name -> list of (value, source text) byte elements
+		self.order = []
+
+		counts = {}
+		for m in re.finditer(r"(\w+)\[\]\s*=\s*\{([^{}]*)\}", text):
+			counts[m.group(1)] = len(split_elements(m.group(2)))
+
+		for m in re.finditer(r"const\s+(?:uint8_t|unsigned int)\s+(\w+)\s*=\s*([^;{]+);", text):
+			v = c_eval(m.group(2), self.symbols, counts)
+			if v is not None:
+				self.symbols[m.group(1)] = v
+
+		for m in re.finditer(r"const\s+uint8_t\s+(prgm\w+)\[\]\s*=\s*\{([^}]*)\}", text):
+			elements = []
+			for e in split_elements(m.group(2)):
+				v = c_eval(e, self.symbols)
+				if v is None:
+					raise AsmError("%s: can't work out %r" % (m.group(1), e))
+				elements.append((v & 0xFF, e))
+			self.programs[m.group(1)] = elements
+			self.order.append(m.group(1))
+
+		m = re.search(r"S64programList\[\]\s*=\s*\{([^}]*)\}", text)
+		self.program_list = split_elements(m.group(1))
+
+		m = re.search(r"S64verifyList\[\]\s*=\s*\{([^}]*)\}", text)
+		self.verify_list = split_elements(m.group(1))
+		m = re.search(r"S64verifySize\[\]\s*=\s*\{([^}]*)\}", text)
+		self.verify_size = [re.sub(r"sizeof\((\w+)\)", r"\1", e) for e in split_elements(m.group(1))]
+		m = re.search(r"S64verifyNames\[\]\s*=\s*\{(.*?)\};", text, re.S)
+		self.verify_names = ["prgm" + n for n in re.findall(r"\"(\w+)\\0\"", m.group(1))]
+
+		m = re.search(r"S64instrNames\[\]\s*=\s*\{(.*?)\};", text, re.S)
+		self.mnemonics = re.findall(r"\"(\w+)\\0\"", m.group(1))
+
+		m = re.search(r"S64instrList\[\]\s*=\s*\{([^}]*)\}", text)
+		self.encodings = [c_eval(e, self.symbols) for e in split_elements(m.group(1))]
+
+		for name in ("s64dMulCycles", "s64dDivCycles"):
+			m = re.search(r"const unsigned long %s\s*=\s*(\w+);" % name, text)
+			self.symbols[name] = c_eval(m.group(1), self.symbols)
+		m = re.search(r"S64instrCycles\[\]\s*=\s*\{([^}]*)\}", text)
+		self.cycles = [c_eval(e, self.symbols) for e in split_elements(m.group(1))]
+
+		self.by_mnemonic = {}
+		for i, n in enumerate(self.mnemonics):
+			if self.encodings[i] != 0xFF:
+				self.by_mnemonic[n] = self.encodings[i]
+
+		self.multdiv = "useSWEET64multDiv" in [o.split("=")[0] for o in options]
+
+	def mnemonic(self, opcode):
+		i = opcode & 0x3F
+		if i >= len(self.mnemonics) or self.encodings[i] != opcode:
+			return None
+		return self.mnemonics[i]
+
+
+def instr_length(opcode):
+	return 1 + (1 if opcode & HAS_REGISTERS else 0) + (1 if opcode & HAS_BYTE else 0)
+
+
+# --------------------------------------------------------------------------
+# disassembler
+
+def decode(sketch, name):
+	"""list of (offset, mnemonic, register byte, byte, index bound, element sources) for a program"""
+	elements = sketch.programs[name]
+	out = []
+	i = 0
+	while i < len(elements):
+		opcode = elements[i][0]
+		m = sketch.mnemonic(opcode)
+		if m is None:
+			raise AsmError("%s: unknown opcode %02X at offset %d" % (name, opcode, i))
+		n = instr_length(opcode) + (1 if m == "SkipIfIndexBelow" else 0)
+		if i + n > len(elements):
+			raise AsmError("%s: instruction at offset %d runs off the end" % (name, i))
+		ops = elements[i + 1:i + n]
+		reg = ops.pop(0) if opcode & HAS_REGISTERS else None
+		byte = ops.pop(0) if opcode & HAS_BYTE else None
+		bound = ops.pop(0) if ops else None
+		out.append((i, m, reg, byte, bound, n))
+		i += n
+	return out
+
+
+def register_text(v):
+	x, y = v >> 4, v & 0x0F
+	if 1 <= y <= 5 and x == 0:
+		return "R%d" % y
+	if 1 <= x <= 5 and 1 <= y <= 5:
+		return "R%d, R%d" % (x, y)
+	return "0x%02X" % v
+
+
+def skip_target(offset, length, b):
+	return offset + length + (b if b < 128 else b - 256)
+
+
+def callee(sketch, m, byte):
+	if m in ("Call", "Jump"):
+		k = byte[0]
+	elif sketch.multdiv and m.startswith("MulBy"):
+		k = sketch.symbols["idxS64doMultiply"]
+	elif sketch.multdiv and m.startswith("DivBy"):
+		k = sketch.symbols["idxS64doDivide"]
+	else:
+		return None
+	if k < len(sketch.program_list):
+		return sketch.program_list[k]
+	return None
+
+
+def estimate(sketch, name, memo=None, active=()):
+	"""one pass cycle estimate - every instruction is charged once, plus whatever it calls"""
+	memo = {} if memo is None else memo
+	if name in memo:
+		return memo[name]
+	if name in active or name not in sketch.programs:
+		return 0
+	e = 0
+	for offset, m, reg, byte, bound, n in decode(sketch, name):
+		e += sketch.cycles[sketch.by_mnemonic[m] & 0x3F]
+		c = callee(sketch, m, byte)
+		if c:
+			e += estimate(sketch, c, memo, active + (name,))
+	memo[name] = e
+	return e
+
+
+def disassemble(sketch, name):
+	instrs = decode(sketch, name)
+	starts = set(i[0] for i in instrs)
+	targets = {}
+	for offset, m, reg, byte, bound, n in instrs:
+		if m in SKIPS:
+			t = skip_target(offset, n, byte[0])
+			if t not in starts and t != len(sketch.programs[name]):
+				raise AsmError("%s: skip at offset %d lands on offset %d, which is not an instruction" % (name, offset, t))
+			targets.setdefault(t, None)
+	for k, t in enumerate(sorted(targets)):
+		targets[t] = "L%d" % (k + 1)
+
+	lines = ["program %s\t\t; %d bytes, about %d cycles" % (name, len(sketch.programs[name]), estimate(sketch, name))]
+	for offset, m, reg, byte, bound, n in instrs:
+		if offset in targets:
+			lines.append("%s:" % targets[offset])
+		ops = []
+		if reg is not None:
+			ops.append(register_text(reg[0]))
+		if byte is not None:
+			if m in SKIPS:
+				ops.append(targets[skip_target(offset, n, byte[0])])
+			else:
+				ops.append(byte[1])
+		if bound is not None:
+			ops.append(bound[1])
+		lines.append("\t%s%s" % (m, (" " + ", ".join(ops)) if ops else ""))
+	if len(sketch.programs[name]) in targets:
+		lines.append("%s:" % targets[len(sketch.programs[name])])
+	lines.append("end")
+	return "\n".join(lines) + "\n"
+
+
+# --------------------------------------------------------------------------
+# assembler
+
+def parse_listing(text):
+	"""list of (program name, [(label, mnemonic, operands, line number)])"""
+	programs = []
+	cur = None
+	label = []
+	for n, line in enumerate(text.splitlines(), 1):
+		line = line.split(";", 1)[0].rstrip()
+		if not line.strip():
+			continue
+		words = line.split(None, 1)
+		if words[0] == "program":
+			cur = (words[1].strip(), [])
+			programs.append(cur)
+		elif words[0] == "end":
+			if label:
+				cur[1].append((label, None, [], n))
+			cur = None
+			label = []
+		elif cur is None:
+			raise AsmError("line %d: instruction outside a program" % n)
+		elif line.endswith(":") and not line[0].isspace():
+			label.append(line[:-1])
+		else:
+			ops = [o.strip() for o in words[1].split(",")] if len(words) > 1 else []
+			cur[1].append((label, words[0], ops, n))
+			label = []
+	if cur is not None:
+		raise AsmError("program %s has no end" % cur[0])
+	return programs
+
+
+def register_byte(ops, n):
+	regs = []
+	for o in ops:
+		m = re.fullmatch(r"[Rr]([1-5])", o)
+		if not m:
+			break
+		regs.append(int(m.group(1)))
+	if len(regs) == 2:
+		return (regs[0] << 4) | regs[1], 2
+	if len(regs) == 1:
+		return regs[0], 1
+	if ops and re.fullmatch(r"0[xX][0-9A-Fa-f]{1,2}", ops[0]):
+		return int(ops[0], 16), 1
+	raise AsmError("line %d: expected a register" % n)
+
+
+def assemble(sketch, name, body):
+	"""returns (byte values or None where a symbol is unknown, C source elements)"""
+	# first pass - offsets of every instruction and label
+	labels = {}
+	offset = 0
+	sized = []
+	for label, m, ops, n in body:
+		for l in label:
+			if l in labels:
+				raise AsmError("line %d: label %s used twice" % (n, l))
+			labels[l] = offset
+		if m is None:
+			continue
+		if m not in sketch.by_mnemonic:
+			raise AsmError("line %d: unknown mnemonic %s" % (n, m))
+		opcode = sketch.by_mnemonic[m]
+		length = instr_length(opcode) + (1 if m == "SkipIfIndexBelow" else 0)
+		sized.append((offset, m, opcode, ops, length, n))
+		offset += length
+
+	# second pass - encode
+	values = []
+	source = []
+	for offset, m, opcode, ops, length, n in sized:
+		line_v = [opcode]
+		line_s = ["instr%s" % m]
+		ops = list(ops)
+		if opcode & HAS_REGISTERS:
+			v, used = register_byte(ops, n)
+			ops = ops[used:]
+			line_v.append(v)
+			line_s.append("0x%02X" % v)
+		if opcode & HAS_BYTE:
+			if not ops:
+				raise AsmError("line %d: %s needs an operand" % (n, m))
+			o = ops.pop(0)
+			if m in SKIPS:
+				if o not in labels:
+					raise AsmError("line %d: no label %s" % (n, o))
+				d = labels[o] - (offset + length)
+				if not -128 <= d <= 127:
+					raise AsmError("line %d: %s is too far away for a skip" % (n, o))
+				line_v.append(d & 0xFF)
+				line_s.append(str(d & 0xFF))
+			else:
+				line_v.append(c_eval(o, sketch.symbols))
+				line_s.append(o)
+		if m == "SkipIfIndexBelow":
+			if not ops:
+				raise AsmError("line %d: SkipIfIndexBelow needs an index bound" % n)
+			o = ops.pop(0)
+			line_v.append(c_eval(o, sketch.symbols))
+			line_s.append(o)
+		if ops:
+			raise AsmError("line %d: too many operands for %s" % (n, m))
+		values += [(v & 0xFF) if v is not None else None for v in line_v]
+		source.append(line_s)
+	return values, source
+
+
+def c_array(name, source):
+	lines = ["const uint8_t %s[] PROGMEM = {" % name]
+	for k, s in enumerate(source):
+		lines.append("\t" + ", ".join(s) + ("," if k + 1 < len(source) else ""))
+	lines.append("};")
+	return "\n".join(lines) + "\n"
+
+
+# --------------------------------------------------------------------------
+# command line
+
+def main(argv=None):
+	ap = argparse.ArgumentParser(description="assemble and disassemble the SWEET64 programs in mpguino.cpp")
+	ap.add_argument("--source", default=DEFAULT_SOURCE, help="the sketch to read programs and symbols from")
+	ap.add_argument("-D", dest="options", action="append", default=[], metavar="OPTION", help="turn on a configure.h option")
+	sub = ap.add_subparsers(dest="command", required=True)
+
+	p = sub.add_parser("disasm", help="list SWEET64 programs")
+	p.add_argument("names", nargs="*", metavar="PROGRAM")
+
+	p = sub.add_parser("asm", help="assemble a listing into PROGMEM arrays")
+	p.add_argument("listing")
+	p.add_argument("-o", dest="output", help="header to write (default: standard output)")
+
+	sub.add_parser("check", help="round trip every program thru the disassembler and assembler")
+
+	args = ap.parse_args(argv)
+
+	try:
+		sketch = Sketch(args.source, args.options)
+
+		if args.command == "disasm":
+			for name in (args.names or sketch.order):
+				if name not in sketch.programs:
+					raise AsmError("no program %s" % name)
+				sys.stdout.write(disassemble(sketch, name) + "\n")
+
+		elif args.command == "asm":
+			with open(args.listing) as f:
+				programs = parse_listing(f.read())
+			out = ["/* generated by tools/sweet64.py from %s - edit that instead */\n" % os.path.basename(args.listing)]
+			for name, body in programs:
+				out.append(c_array(name, assemble(sketch, name, body)[1]))
+			text = "\n".join(out)
+			if args.output:
+				with open(args.output, "w") as f:
+					f.write(text)
+			else:
+				sys.stdout.write(text)
+
+		else:
+			bad = 0
+			for name in sketch.order:
+				try:
+					(pname, body), = parse_listing(disassemble(sketch, name))
+					values = assemble(sketch, pname, body)[0]
+				except AsmError as e:
+					print("%s" % e)
+					bad += 1
+					continue
+				if values != [v for v, s in sketch.programs[name]]:
+					print("%s: assembled bytes differ from the sketch" % name)
+					bad += 1
+			# the verifier's three parallel tables have to name the same programs, in the same order
+			for k, (a, b, c) in enumerate(zip(sketch.verify_list, sketch.verify_size, sketch.verify_names)):
+				if not a == b == c:
+					print("verifier tables disagree at entry %d: %s, sizeof(%s), \"%s\"" % (k, a, b, c[4:]))
+					bad += 1
+			if not len(sketch.verify_list) == len(sketch.verify_size) == len(sketch.verify_names):
+				print("verifier tables have %d, %d and %d entries" % (len(sketch.verify_list), len(sketch.verify_size), len(sketch.verify_names)))
+				bad += 1
+			for name in sketch.program_list:
+				if name not in sketch.verify_list:
+					print("%s is in S64programList, but not in S64verifyList" % name)
+					bad += 1
+			print("%d programs, %d failures" % (len(sketch.order), bad))
+			return 1 if bad else 0
+
+	except (AsmError, OSError, subprocess.CalledProcessError) as e:
+		print("sweet64: %s" % e, file=sys.stderr)
+		return 1
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""
+loopback test for mpgconfig.py - talks to the host build of the sketch
+(tools/host/build/serialconfig, made by "make -C tools/host check") over
+a pair of pipes, and checks that an image survives a dump, an edit, a
+load and another dump, that damaged images are refused, and that what
+ends up in EEPROM is exactly the image that was loaded.
+
+  test_mpgconfig.py [SERIALCONFIG]
+"""
+
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import mpgconfig
+
+
+def refused(link, body):
+	try:
+		mpgconfig.request(link, body)
+	except mpgconfig.ConfigError:
+		return True
+	return False
+
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	program = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "host", "build", "serialconfig")
+	failures = []
+
+	def check(ok, what):
+		if not ok:
+			failures.append(what)
+			print("FAIL: %s" % what)
+
+	with tempfile.TemporaryDirectory() as tmp:
+		eeprom = os.path.join(tmp, "eeprom.bin")
+		proc = subprocess.Popen([program, eeprom], stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+		link = mpgconfig.Link(proc.stdout.fileno(), proc.stdin.fileno())
+
+		image = mpgconfig.dump(link)
+		sig, length, crc = mpgconfig.image_header(image)
+		check(length == len(image), "dump length")
+
+		# flip every settings byte, so the reloaded image differs everywhere but the signature
+		edited = image[0:3] + bytes(b ^ 0x5A for b in image[3:])
+		mpgconfig.load(link, edited)
+		check(mpgconfig.dump(link) == edited, "dump after load matches the loaded image")
+
+		# a wrong signature is refused up front
+		bad = bytes((sig[0] ^ 1,)) + sig[1:]
+		check(refused(link, b"B" + bad + struct.pack("<HH", length, crc)), "wrong signature refused")
+
+		# so is a wrong length
+		check(refused(link, b"B" + sig + struct.pack("<HH", length + 1, crc)), "wrong length refused")
+
+		# image bytes with no load in progress are refused
+		check(refused(link, b"W" + struct.pack("<H", 3) + b"\x01"), "'W' outside a load refused")
+
+		# an image that does not match its CRC is refused at the end
+		mpgconfig.request(link, b"B" + sig + struct.pack("<HH", length, mpgconfig.crc16(edited) ^ 1))
+		for at in range(0, length, mpgconfig.CHUNK_SIZE):
+			mpgconfig.request(link, b"W" + struct.pack("<H", at) + image[at:at + mpgconfig.CHUNK_SIZE])
+		check(refused(link, b"E"), "bad image CRC refused")
+
+		# a good load puts everything back
+		mpgconfig.load(link, image)
+		check(mpgconfig.dump(link) == image, "dump after reload matches the original image")
+
+		proc.stdin.close()
+		proc.wait(timeout=10)
+		with open(eeprom, "rb") as f:
+			check(f.read() == image, "EEPROM holds the loaded image")
+
+	print("%d failures" % len(failures))
+	return 1 if failures else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+test for mpgfillups.py - reads the dumps that the host build of the
+sketch (tools/host/build/fillups, made by "make -C tools/host check")
+sends after its 5th and 12th tank, and checks that every fill-up comes
+back once with the values the sketch stored, that the statistics add
+up, and that a cut short or damaged dump is refused.
+
+  test_mpgfillups.py [FILLUPS]
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import mpgfillups
+
+
+def milli(r):
+	"""a record's values as the sketch stores them, in thousandths"""
+	return (r["seq"], r["units"], r["time"], round(r["distance"] * 1000), round(r["fuel"] * 1000), r["engine_time"],
+	    round(r["idle_fuel"] * 1000))
+
+
+def refused(path):
+	try:
+		mpgfillups.merge([path])
+	except mpgfillups.DumpError:
+		return True
+	return False
+
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	program = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "host", "build", "fillups")
+	failures = []
+
+	def check(ok, what):
+		if not ok:
+			failures.append(what)
+			print("FAIL: %s" % what)
+
+	run = subprocess.run([program, "12"], stdout=subprocess.PIPE, stderr=subprocess.PIPE, check=True)
+	capture = run.stdout.decode("ascii")
+	expected = []
+	for line in run.stderr.decode("ascii").split():
+		c = line.split(",")
+		expected.append((int(c[0]), mpgfillups.UNITS[c[1]], int(c[2]), int(c[3]), int(c[4]), int(c[5]), int(c[6])))
+
+	with tempfile.TemporaryDirectory() as tmp:
+		def write(name, text):
+			path = os.path.join(tmp, name)
+			with open(path, "w") as f:
+				f.write(text)
+			return path
+
+		# the two dumps as two captures, oldest first, with some noise around them
+		split = capture.index(mpgfillups.HEADER, capture.index(mpgfillups.HEADER) + 1)
+		first = write("first.txt", "junk before\n" + capture[:split])
+		second = write("second.txt", capture[split:] + "junk after\n")
+		both = write("both.txt", capture)
+
+		check(len(mpgfillups.read_capture(first)[0].records) == 5, "first dump holds the first 5 tanks")
+		check(len(mpgfillups.read_capture(second)[0].records) == 8, "second dump holds the 8 tanks the ring keeps")
+
+		records = mpgfillups.merge([first, second])
+		check([milli(r) for r in records] == expected, "merged fill-ups are every tank, once, oldest first")
+		check([milli(r) for r in mpgfillups.merge([both])] == expected, "two dumps in one capture merge the same way")
+
+		s = mpgfillups.stats(records, "us")
+		distance = sum(e[3] / (1000.0 * (mpgfillups.KM_PER_MILE if e[1] == "metric" else 1.0)) for e in expected)
+		fuel = sum(e[4] / (1000.0 * (mpgfillups.LITRE_PER_GALLON if e[1] == "metric" else 1.0)) for e in expected)
+		check(s["tanks"] == 12, "statistics count every tank")
+		check(abs(s["distance"] - distance) < 1e-6, "distance adds up, with metric tanks converted")
+		check(abs(s["fuel"] - fuel) < 1e-6, "fuel adds up, with metric tanks converted")
+		check(s["engine_time"] == sum(e[5] for e in expected), "engine time adds up")
+		check(abs(s["fuel_economy"] - distance / fuel) < 1e-9, "long-term fuel economy")
+		check(len(s["per_tank"]) == 12, "fuel economy for each tank")
+		print(mpgfillups.report(s, "us"))
+
+		m = mpgfillups.stats(records, "metric")
+		check(abs(m["distance"] - distance * mpgfillups.KM_PER_MILE) < 1e-6, "metric report converts the SAE tanks")
+
+		# a dump with its last lines lost, and one with a record changed, are refused
+		check(refused(write("cut.txt", capture[:split - 40])), "cut short dump refused")
+		lines = capture[:split].split("\n")
+		cols = lines[3].split(",")
+		cols[3] = "%.3f" % (float(cols[3]) + 1.0)
+		lines[3] = ",".join(cols)
+		check(refused(write("damaged.txt", "\n".join(lines))), "damaged dump refused")
+
+	print("%d failures" % len(failures))
+	return 1 if failures else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
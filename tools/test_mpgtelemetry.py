@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+test for the frame decoder in mpgtelemetry.py - decodes the stream that
+the host build of the sketch (tools/host/build/telemetry, made by
+"make -C tools/host check") sends, and checks that every frame passes
+its CRC, that each data frame decodes to the measurements the sketch
+put into it, and that the description frames carry its settings. then
+checks that a damaged frame is counted as bad, and a lost frame shows
+up as a gap in the sequence numbers.
+
+  test_mpgtelemetry.py [TELEMETRY]
+"""
+
+import io
+import os
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import mpgtelemetry
+
+FRAMES = 600
+
+
+def decode(data):
+	"""every event in data, and the frame counters"""
+	events = []
+	stream = mpgtelemetry.decode_stream(io.BytesIO(data))
+	while True:
+		try:
+			events.append(next(stream))
+		except StopIteration as e:
+			return events, e.value
+
+
+def rows(events):
+	return [e[1] for e in events if e[0] == "R"]
+
+
+def main():
+	here = os.path.dirname(os.path.abspath(__file__))
+	program = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, "host", "build", "telemetry")
+	failures = []
+
+	def check(ok, what):
+		if not ok:
+			failures.append(what)
+			print("FAIL: %s" % what)
+
+	run = subprocess.run([program, str(FRAMES)], stdout=subprocess.PIPE, stderr=subprocess.PIPE, check=True)
+	stream = run.stdout
+	settings = None
+	expected = []
+	for line in run.stderr.decode("ascii").split():
+		c = line.split(",")
+		if c[0] == "settings":
+			settings = dict(zip(mpgtelemetry.DESCRIPTION_FIELDS, (int(v) for v in c[1:])))
+		else:
+			expected.append(tuple(int(v) for v in c[1:]))
+
+	events, counters = decode(stream)
+	got = rows(events)
+	descriptions = [e[1] for e in events if e[0] == "D"]
+	print("%d bytes for %d frames, %.1f bytes per frame" % (len(stream), FRAMES, len(stream) / float(FRAMES)))
+	print(counters)
+
+	check(counters["bad_frames"] == 0 and counters["unknown_frames"] == 0, "every frame passes its CRC")
+	check(counters["missed_slots"] == 0 and all(r[2] == 0 for r in got), "no sequence gaps")
+	check(counters["data_frames"] + counters["description_frames"] + counters["health_frames"] == FRAMES, "every frame decoded")
+	check(len(descriptions) == (FRAMES + 255) // 256, "a description frame every time the sequence number comes around")
+	check(all(d == settings for d in descriptions), "description frames carry the settings")
+
+	# the decoder unwraps the timestamps, and counts time from the first data frame
+	check(len(got) == len(expected), "one row per data frame")
+	check([(r[1],) + r[3:] for r in got] == [(e[0],) + e[2:] for e in expected], "rows hold the measurements sent")
+	check([r[0] for r in got] == [(e[1] - expected[0][1]) & 0xFFFFFFFF for e in expected], "timestamps unwrapped")
+	check(expected[-1][1] < expected[0][1], "the timestamps did wrap around")
+
+	# measurements roll over description frames, so the rows add up to everything that came in
+	for x, name in enumerate(("VSS pulses", "injector pulses", "VSS cycles", "injector cycles", "injector open cycles")):
+		check(sum(r[3 + x] for r in got) == sum(e[2 + x] for e in expected), "%s add up" % name)
+
+	parts = stream.split(b"\x00")
+
+	# a byte flipped within a data frame - that frame is refused, and its slot shows up as a gap
+	k = 40
+	damaged = bytearray(parts[k])
+	damaged[5] ^= 0x40 if damaged[5] != 0x40 else 0x20
+	events, c = decode(b"\x00".join(parts[:k] + [bytes(damaged)] + parts[k + 1:]))
+	check(c["bad_frames"] == 1, "damaged frame counted as bad")
+	check(c["missed_slots"] == 1 and len(rows(events)) == len(got) - 1, "damaged frame leaves a gap")
+
+	# a frame lost altogether - no bad frame, only a gap, right where it was
+	events, c = decode(b"\x00".join(parts[:k] + parts[k + 1:]))
+	lost = rows(events)
+	check(c["bad_frames"] == 0, "lost frame is not a bad frame")
+	check(c["missed_slots"] == 1, "lost frame counted as a missed slot")
+	check([r[2] for r in lost].count(1) == 1 and lost[k - 1][2] == 1, "gap on the frame after the lost one")
+
+	# a stream cut off part way thru a frame
+	events, c = decode(stream[:-10])
+	check(c["bad_frames"] == 1, "cut off frame counted as bad")
+
+	print("%d failures" % len(failures))
+	return 1 if failures else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())